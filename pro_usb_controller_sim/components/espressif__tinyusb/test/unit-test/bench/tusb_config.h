@@ -0,0 +1,53 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ha Thach (tinyusb.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * This file is part of the TinyUSB stack.
+ */
+
+#ifndef _TUSB_CONFIG_H_
+#define _TUSB_CONFIG_H_
+
+// Host benchmark configuration, no MCU and no RTOS
+
+#define CFG_TUSB_MCU              OPT_MCU_NONE
+#define CFG_TUSB_OS               OPT_OS_NONE
+#define CFG_TUSB_DEBUG            0
+
+#define TUP_DCD_ENDPOINT_MAX      8
+
+// Build the constant address (hardware FIFO) copy modes as on DWC2 targets
+#define TUP_MEM_CONST_ADDR
+
+//--------------------------------------------------------------------+
+// Device stack for the usbd benchmarks (virtual DCD), mirrors the firmware HID setup
+//--------------------------------------------------------------------+
+#define CFG_TUD_ENABLED           1
+#define CFG_TUD_ENDPOINT0_SIZE    64
+
+#define CFG_TUD_HID               1
+#define CFG_TUD_HID_EP_BUFSIZE    64
+#define CFG_TUD_HID_IN_QUEUE_DEPTH  8
+
+// CFG_TUD_TASK_EVENT_BATCH is set per binary by the Makefile
+
+#endif
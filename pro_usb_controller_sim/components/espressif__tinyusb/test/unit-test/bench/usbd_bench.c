@@ -0,0 +1,206 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ha Thach (tinyusb.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * This file is part of the TinyUSB stack.
+ */
+
+// Host benchmark for the device task event loop (usbd.c) on a virtual DCD.
+//
+// The virtual controller (vdcd.c) enumerates a HID gamepad, then emulates the bus one frame at a
+// time: SOF (when the scenario enables it), completions of pending transfers and a periodic
+// GET_STATUS. Everything runs on one thread with OS NONE. The application refreshes the HID mailbox
+// every frame and tud_task() runs once every `wake` frames, so each wake finds a burst of events.
+//
+// Per scenario, best of BENCH_ROUNDS for the time and all rounds for the latency:
+//   ev/wake      events dispatched per tud_task() call
+//   ns/ev        tud_task() time per dispatched event, timer overhead removed
+//   locks/ev     queue/spinlock critical sections (dcd_int_disable) entered by the task per event
+//   hid p50/p99  ns from entering tud_task() to tud_hid_report_complete_cb(), i.e. the part of the
+//                HID IN completion latency that the task loop owns (bus time is emulated, not real)
+//
+// The Makefile builds one binary per CFG_TUD_TASK_EVENT_BATCH value (1 = per event receive):
+//   make -C test/unit-test/bench usbd
+//   test/unit-test/bench/_build/usbd_bench_b1 [frames_per_round, default 100000]
+//   test/unit-test/bench/_build/usbd_bench_b8
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "vdcd.h"
+
+#define BENCH_ROUNDS    5
+
+static inline uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+// OS NONE time base
+uint32_t tusb_time_millis_api(void) {
+  return (uint32_t) (now_ns() / 1000000u);
+}
+
+//--------------------------------------------------------------------+
+// Application callbacks
+//--------------------------------------------------------------------+
+
+static uint32_t posted_events;
+static uint64_t wake_ns;
+static uint32_t* hid_lat;
+static uint32_t hid_lat_count;
+static uint32_t hid_lat_max;
+
+void tud_event_hook_cb(uint8_t rhport, uint32_t eventid, bool in_isr) {
+  (void) rhport; (void) eventid; (void) in_isr;
+  posted_events++;
+}
+
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const* report, uint16_t len) {
+  (void) instance; (void) report; (void) len;
+  if (wake_ns && hid_lat_count < hid_lat_max) {
+    hid_lat[hid_lat_count++] = (uint32_t) (now_ns() - wake_ns);
+  }
+}
+
+//--------------------------------------------------------------------+
+// Benchmark
+//--------------------------------------------------------------------+
+
+typedef struct {
+  uint32_t wake;
+  bool sof;
+} bench_case_t;
+
+static const bench_case_t cases[] = {
+  { 1, false }, { 4, false }, { 8, false },
+  { 1, true  }, { 4, true  }, { 8, true  },
+};
+
+typedef struct {
+  uint64_t task_ns;
+  uint32_t wakes;
+  uint32_t events;
+  uint32_t locks;
+} round_result_t;
+
+static uint64_t timer_overhead_ns;
+
+static void calibrate_timer(void) {
+  uint64_t best = UINT64_MAX;
+  for (int i = 0; i < 10000; i++) {
+    uint64_t const t0 = now_ns();
+    uint64_t const t1 = now_ns();
+    if (t1 - t0 < best) best = t1 - t0;
+  }
+  timer_overhead_ns = best;
+}
+
+static round_result_t run_round(bench_case_t const* c, uint32_t frames) {
+  round_result_t r = { 0 };
+  uint8_t report[VDCD_REPORT_LEN] = { 0 };
+
+  for (uint32_t f = 0; f < frames; f++) {
+    report[0] = (uint8_t) f;
+    tud_hid_report_latest(VDCD_REPORT_ID, report, sizeof(report));
+    vdcd_frame(c->sof);
+
+    if ((f + 1) % c->wake == 0) {
+      uint32_t const events_before = posted_events;
+      uint32_t const locks_before = vdcd_lock_count;
+      uint64_t const t0 = now_ns();
+      wake_ns = t0;
+      tud_task();
+      uint64_t const t1 = now_ns();
+      wake_ns = 0;
+      // events posted from task context (none expected) are dispatched by a later wake
+      r.locks += vdcd_lock_count - locks_before;
+      r.events += events_before;
+      r.task_ns += t1 - t0 - timer_overhead_ns;
+      r.wakes++;
+      posted_events -= events_before;
+    }
+  }
+
+  // drain whatever is left so the next round starts from an empty queue
+  tud_task();
+  posted_events = 0;
+  return r;
+}
+
+static int cmp_u32(void const* a, void const* b) {
+  uint32_t const x = *(uint32_t const*) a;
+  uint32_t const y = *(uint32_t const*) b;
+  return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv) {
+  uint32_t const frames = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : 100000;
+
+  hid_lat_max = frames * BENCH_ROUNDS;
+  hid_lat = malloc(hid_lat_max * sizeof(uint32_t));
+  if (!hid_lat) return 1;
+
+  tusb_rhport_init_t const dev_init = { .role = TUSB_ROLE_DEVICE, .speed = TUSB_SPEED_FULL };
+  tusb_init(0, &dev_init);
+
+  if (!vdcd_enumerate()) {
+    printf("FAIL: virtual device did not enumerate\n");
+    return 1;
+  }
+  calibrate_timer();
+
+  printf("usbd_bench: CFG_TUD_TASK_EVENT_BATCH %d, %u frames x %d rounds\n\n",
+         CFG_TUD_TASK_EVENT_BATCH, (unsigned) frames, BENCH_ROUNDS);
+  printf("%-4s %-4s %8s %8s %9s %8s %8s\n", "wake", "sof", "ev/wake", "ns/ev", "locks/ev", "hid p50", "hid p99");
+
+  for (size_t i = 0; i < TU_ARRAY_SIZE(cases); i++) {
+    bench_case_t const* c = &cases[i];
+    round_result_t best = { 0 };
+    double best_ns = 0;
+
+    tud_sof_cb_enable(c->sof);
+    hid_lat_count = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+      round_result_t const r = run_round(c, frames);
+      double const ns = (double) r.task_ns / r.events;
+      if (round == 0 || ns < best_ns) {
+        best = r;
+        best_ns = ns;
+      }
+    }
+
+    qsort(hid_lat, hid_lat_count, sizeof(uint32_t), cmp_u32);
+    uint32_t const p50 = hid_lat_count ? hid_lat[hid_lat_count / 2] : 0;
+    uint32_t const p99 = hid_lat_count ? hid_lat[(uint32_t) ((uint64_t) hid_lat_count * 99 / 100)] : 0;
+
+    printf("%-4u %-4s %8.2f %8.1f %9.2f %8u %8u\n", (unsigned) c->wake, c->sof ? "on" : "off",
+           (double) best.events / best.wakes, best_ns, (double) best.locks / best.events,
+           (unsigned) p50, (unsigned) p99);
+  }
+
+  free(hid_lat);
+  return 0;
+}
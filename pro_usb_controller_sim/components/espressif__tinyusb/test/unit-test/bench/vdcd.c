@@ -0,0 +1,222 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ha Thach (tinyusb.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * This file is part of the TinyUSB stack.
+ */
+
+// Virtual device controller shared by the usbd benchmarks, see vdcd.h
+
+#include <string.h>
+
+#include "vdcd.h"
+
+//--------------------------------------------------------------------+
+// Controller
+//--------------------------------------------------------------------+
+
+typedef struct {
+  bool pending;
+  uint16_t len;
+} vdcd_xfer_t;
+
+static vdcd_xfer_t vdcd_xfer[TUP_DCD_ENDPOINT_MAX][2];
+static uint32_t vdcd_lock;
+uint32_t vdcd_lock_count;
+
+bool dcd_init(uint8_t rhport, const tusb_rhport_init_t* rh_init) {
+  (void) rhport; (void) rh_init;
+  return true;
+}
+
+void dcd_int_handler(uint8_t rhport) { (void) rhport; }
+
+// Stands in for masking the USB interrupt: one atomic exchange in, one release store out
+void dcd_int_disable(uint8_t rhport) {
+  (void) rhport;
+  while (__atomic_exchange_n(&vdcd_lock, 1, __ATOMIC_ACQUIRE)) {}
+  vdcd_lock_count++;
+}
+
+void dcd_int_enable(uint8_t rhport) {
+  (void) rhport;
+  __atomic_store_n(&vdcd_lock, 0, __ATOMIC_RELEASE);
+}
+
+// Status stage of SET_ADDRESS is the DCD's job
+void dcd_set_address(uint8_t rhport, uint8_t dev_addr) {
+  (void) dev_addr;
+  dcd_edpt_xfer(rhport, tu_edpt_addr(0, TUSB_DIR_IN), NULL, 0);
+}
+
+void dcd_remote_wakeup(uint8_t rhport) { (void) rhport; }
+void dcd_sof_enable(uint8_t rhport, bool en) { (void) rhport; (void) en; }
+
+bool dcd_edpt_open(uint8_t rhport, tusb_desc_endpoint_t const* desc_ep) {
+  (void) rhport; (void) desc_ep;
+  return true;
+}
+
+void dcd_edpt_close_all(uint8_t rhport) {
+  (void) rhport;
+  memset(vdcd_xfer, 0, sizeof(vdcd_xfer));
+}
+
+bool dcd_edpt_xfer(uint8_t rhport, uint8_t ep_addr, uint8_t* buffer, uint16_t total_bytes) {
+  (void) rhport; (void) buffer;
+  vdcd_xfer_t* xfer = &vdcd_xfer[tu_edpt_number(ep_addr)][tu_edpt_dir(ep_addr)];
+  xfer->len = total_bytes;
+  __atomic_store_n(&xfer->pending, true, __ATOMIC_RELEASE);
+  return true;
+}
+
+void dcd_edpt_close(uint8_t rhport, uint8_t ep_addr) {
+  (void) rhport;
+  __atomic_store_n(&vdcd_xfer[tu_edpt_number(ep_addr)][tu_edpt_dir(ep_addr)].pending, false, __ATOMIC_RELEASE);
+}
+
+void dcd_edpt_stall(uint8_t rhport, uint8_t ep_addr) { (void) rhport; (void) ep_addr; }
+void dcd_edpt_clear_stall(uint8_t rhport, uint8_t ep_addr) { (void) rhport; (void) ep_addr; }
+
+//--------------------------------------------------------------------+
+// Descriptors and application callbacks
+//--------------------------------------------------------------------+
+
+static uint8_t const desc_hid_report[] = {
+  TUD_HID_REPORT_DESC_GAMEPAD(HID_REPORT_ID(VDCD_REPORT_ID))
+};
+
+static tusb_desc_device_t const desc_device = {
+  .bLength            = sizeof(tusb_desc_device_t),
+  .bDescriptorType    = TUSB_DESC_DEVICE,
+  .bcdUSB             = 0x0200,
+  .bMaxPacketSize0    = CFG_TUD_ENDPOINT0_SIZE,
+  .idVendor           = 0xCAFE,
+  .idProduct          = 0x4004,
+  .bcdDevice          = 0x0100,
+  .bNumConfigurations = 1
+};
+
+#define CONFIG_TOTAL_LEN  (TUD_CONFIG_DESC_LEN + TUD_HID_DESC_LEN)
+
+static uint8_t const desc_configuration[] = {
+  TUD_CONFIG_DESCRIPTOR(1, 1, 0, CONFIG_TOTAL_LEN, 0x00, 100),
+  TUD_HID_DESCRIPTOR(0, 0, HID_ITF_PROTOCOL_NONE, sizeof(desc_hid_report), VDCD_HID_EPIN, CFG_TUD_HID_EP_BUFSIZE, 1)
+};
+
+uint8_t const* tud_descriptor_device_cb(void) {
+  return (uint8_t const*) &desc_device;
+}
+
+uint8_t const* tud_descriptor_configuration_cb(uint8_t index) {
+  (void) index;
+  return desc_configuration;
+}
+
+uint16_t const* tud_descriptor_string_cb(uint8_t index, uint16_t langid) {
+  (void) index; (void) langid;
+  return NULL;
+}
+
+uint8_t const* tud_hid_descriptor_report_cb(uint8_t instance) {
+  (void) instance;
+  return desc_hid_report;
+}
+
+uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t* buffer, uint16_t reqlen) {
+  (void) instance; (void) report_id; (void) report_type; (void) buffer; (void) reqlen;
+  return 0;
+}
+
+void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type, uint8_t const* buffer, uint16_t bufsize) {
+  (void) instance; (void) report_id; (void) report_type; (void) buffer; (void) bufsize;
+}
+
+//--------------------------------------------------------------------+
+// Bus emulation
+//--------------------------------------------------------------------+
+
+static uint32_t frame_count;
+
+TU_ATTR_WEAK void vdcd_xfer_post_cb(uint8_t ep_addr) {
+  (void) ep_addr;
+}
+
+static void post_setup(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wLength) {
+  tusb_control_request_t const request = {
+    .bmRequestType = bmRequestType,
+    .bRequest      = bRequest,
+    .wValue        = wValue,
+    .wIndex        = 0,
+    .wLength       = wLength
+  };
+  dcd_event_setup_received(0, (uint8_t const*) &request, true);
+}
+
+bool vdcd_ep0_idle(void) {
+  return !__atomic_load_n(&vdcd_xfer[0][TUSB_DIR_OUT].pending, __ATOMIC_ACQUIRE) &&
+         !__atomic_load_n(&vdcd_xfer[0][TUSB_DIR_IN].pending, __ATOMIC_ACQUIRE);
+}
+
+void vdcd_frame(bool sof) {
+  frame_count++;
+
+  if (sof) {
+    dcd_event_sof(0, frame_count & 0x7FF, true);
+  }
+
+  for (uint8_t epnum = 0; epnum < TUP_DCD_ENDPOINT_MAX; epnum++) {
+    for (uint8_t dir = 0; dir < 2; dir++) {
+      vdcd_xfer_t* xfer = &vdcd_xfer[epnum][dir];
+      if (!__atomic_exchange_n(&xfer->pending, false, __ATOMIC_ACQ_REL)) continue;
+
+      uint8_t const ep_addr = tu_edpt_addr(epnum, dir);
+      vdcd_xfer_post_cb(ep_addr);
+      dcd_event_xfer_complete(0, ep_addr, xfer->len, XFER_RESULT_SUCCESS, true);
+    }
+  }
+
+  if ((frame_count % 8) == 0 && vdcd_ep0_idle()) {
+    post_setup(0x80, TUSB_REQ_GET_STATUS, 0, 2);
+  }
+}
+
+bool vdcd_enumerate(void) {
+  dcd_event_bus_reset(0, TUSB_SPEED_FULL, true);
+  tud_task();
+
+  post_setup(0x00, TUSB_REQ_SET_ADDRESS, 5, 0);
+  tud_task();
+  for (int i = 0; i < 4 && !vdcd_ep0_idle(); i++) {
+    vdcd_frame(false);
+    tud_task();
+  }
+
+  post_setup(0x00, TUSB_REQ_SET_CONFIGURATION, 1, 0);
+  tud_task();
+  for (int i = 0; i < 4 && !vdcd_ep0_idle(); i++) {
+    vdcd_frame(false);
+    tud_task();
+  }
+
+  return tud_mounted() && tud_hid_ready();
+}
@@ -0,0 +1,56 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ha Thach (tinyusb.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * This file is part of the TinyUSB stack.
+ */
+
+#ifndef _VDCD_H_
+#define _VDCD_H_
+
+// Virtual DCD for host benchmarks of the device stack. Transfers stay pending until the next
+// emulated frame, which posts their completion from "ISR" context (in_isr = true). The device is a
+// HID gamepad on IN endpoint 0x81 with 64 byte reports, as in the firmware.
+
+#include "tusb.h"
+#include "device/dcd.h"
+
+#define VDCD_HID_EPIN     0x81
+#define VDCD_REPORT_ID    0x30
+#define VDCD_REPORT_LEN   63
+
+// Critical sections entered through dcd_int_disable() (the OS NONE queue lock)
+extern uint32_t vdcd_lock_count;
+
+// Bus reset, SET_ADDRESS and SET_CONFIGURATION, true once the HID interface is ready
+bool vdcd_enumerate(void);
+
+// One bus frame worth of controller interrupts: SOF (optional), a completion for every pending
+// transfer and, every 8th frame while EP0 is idle, a GET_STATUS setup packet
+void vdcd_frame(bool sof);
+
+bool vdcd_ep0_idle(void);
+
+// Weak, invoked right before a transfer completion is posted
+void vdcd_xfer_post_cb(uint8_t ep_addr);
+
+#endif
@@ -0,0 +1,289 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ha Thach (tinyusb.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * This file is part of the TinyUSB stack.
+ */
+
+// Host benchmark for the tu_fifo_t index mask (power-of-two depths), next to test_fifo.c which
+// covers the FIFO behaviour itself. The same build runs each case twice: as configured, and with
+// idx_mask forced to 0 so the generic (any depth) index math is used.
+//
+// 1. Equivalence: random operation sequences over item sizes, depths (power-of-two and not),
+//    start positions across the whole index space and both overwrite modes. After every
+//    operation the return values, output data, indices and FIFO memory must be bit-identical.
+// 2. Throughput: streams data through both variants per case and prints MB/s and the speedup.
+//
+//   make -C test/unit-test/bench fifo
+//   test/unit-test/bench/_build/fifo_bench [seconds_per_case, default 1]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "osal/osal.h"
+#include "common/tusb_fifo.h"
+
+#define BUF_MAX       (1024 * 16 + 8)
+#define BENCH_ROUNDS  5
+
+static const uint16_t item_sizes[] = { 1, 2, 3, 4, 12 };
+static const uint16_t depths[]     = { 1, 3, 16, 64, 100, 256, 1000, 1024 };
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+// generic: clear the mask so the helpers take the any-depth index path
+static void config_fifo(tu_fifo_t* f, void* mem, uint16_t depth, uint16_t item_size, bool overwritable,
+                        bool generic) {
+  tu_fifo_config(f, mem, depth, item_size, overwritable);
+  if (generic) f->idx_mask = 0;
+}
+
+//--------------------------------------------------------------------+
+// Equivalence
+//--------------------------------------------------------------------+
+
+typedef struct {
+  tu_fifo_t ff;
+  uint8_t mem[BUF_MAX];
+  uint8_t out[BUF_MAX];
+} side_t;
+
+static side_t mask, ref;
+static uint8_t src[BUF_MAX];
+
+enum {
+  OP_WRITE, OP_WRITE_N, OP_READ, OP_READ_N, OP_PEEK_N,
+  OP_WRITE_CONST, OP_READ_CONST, OP_DMA_WRITE, OP_DMA_READ, OP_COUNT
+};
+
+static const char* const op_name[] = {
+  "write", "write_n", "read", "read_n", "peek_n", "write_const", "read_const", "dma_write", "dma_read"
+};
+
+static void setup_pair(uint16_t depth, uint16_t item_size, bool overwritable, uint16_t start) {
+  memset(mask.mem, 0xA5, sizeof(mask.mem));
+  memset(ref.mem, 0xA5, sizeof(ref.mem));
+  config_fifo(&mask.ff, mask.mem, depth, item_size, overwritable, false);
+  config_fifo(&ref.ff, ref.mem, depth, item_size, overwritable, true);
+
+  // empty FIFO positioned anywhere in the [0..2*depth) index space
+  tu_fifo_advance_write_pointer(&mask.ff, start);
+  tu_fifo_advance_read_pointer(&mask.ff, start);
+  tu_fifo_advance_write_pointer(&ref.ff, start);
+  tu_fifo_advance_read_pointer(&ref.ff, start);
+}
+
+static uint32_t run_op(side_t* s, int op, uint16_t n) {
+  tu_fifo_t* f = &s->ff;
+  tu_fifo_buffer_info_t info;
+  uint32_t ret = 0;
+
+  switch (op) {
+    case OP_WRITE:       ret = tu_fifo_write(f, src); break;
+    case OP_WRITE_N:     ret = tu_fifo_write_n(f, src, n); break;
+    case OP_READ:        ret = tu_fifo_read(f, s->out); break;
+    case OP_READ_N:      ret = tu_fifo_read_n(f, s->out, n); break;
+    case OP_PEEK_N:      ret = tu_fifo_peek_n(f, s->out, n); break;
+    // constant address copies read and write the first word of src/out as the hardware register
+    case OP_WRITE_CONST: ret = tu_fifo_write_n_const_addr_full_words(f, src, n); break;
+    case OP_READ_CONST:  ret = tu_fifo_read_n_const_addr_full_words(f, s->out, n); break;
+    case OP_DMA_WRITE:
+      // DMA style: fill the linear part of the write info, then advance
+      tu_fifo_get_write_info(f, &info);
+      n = tu_min16(n, info.len_lin);
+      if (n) memcpy(info.ptr_lin, src, (size_t) n * f->item_size);
+      tu_fifo_advance_write_pointer(f, n);
+      ret = (uint32_t) ((info.ptr_lin ? (uint8_t*) info.ptr_lin - s->mem : 0xFFFF) << 16 | n);
+      break;
+    case OP_DMA_READ:
+      tu_fifo_get_read_info(f, &info);
+      n = tu_min16(n, info.len_lin);
+      if (n) memcpy(s->out, info.ptr_lin, (size_t) n * f->item_size);
+      tu_fifo_advance_read_pointer(f, n);
+      ret = (uint32_t) ((info.ptr_lin ? (uint8_t*) info.ptr_lin - s->mem : 0xFFFF) << 16 | n);
+      break;
+    default: break;
+  }
+
+  // status queries ride along so their index math is compared too
+  uint16_t const count  = tu_fifo_count(f);
+  uint16_t const remain = tu_fifo_remaining(f);
+  bool const ovf        = tu_fifo_overflowed(f);
+  return ret ^ ((uint32_t) count << 8) ^ ((uint32_t) remain << 20) ^ ((uint32_t) ovf << 31);
+}
+
+static bool check_equivalence(uint32_t ops_per_config) {
+  uint32_t configs = 0, ops = 0;
+
+  for (size_t i = 0; i < sizeof(item_sizes) / sizeof(item_sizes[0]); i++) {
+    for (size_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+      uint16_t const item_size = item_sizes[i];
+      uint16_t const depth = depths[d];
+      if ((uint32_t) depth * item_size + 8 > BUF_MAX) continue;
+
+      for (int ow = 0; ow < 2; ow++) {
+        // wrap positions: start, just before the end, odd offsets and the upper index half
+        uint16_t const starts[] = { 0, 1, (uint16_t) (depth - 1), (uint16_t) (depth / 2 + 1), depth,
+                                    (uint16_t) (2 * depth - 1), (uint16_t) (rng() % (2 * depth)) };
+
+        for (size_t p = 0; p < sizeof(starts) / sizeof(starts[0]); p++) {
+          setup_pair(depth, item_size, ow, starts[p]);
+          configs++;
+
+          for (uint32_t k = 0; k < ops_per_config; k++) {
+            int const op = (int) (rng() % OP_COUNT);
+            // up to 1.5x depth to cover overflow, bounded by the source buffer
+            uint16_t const n = (uint16_t) (rng() % tu_min32(depth + depth / 2 + 2, BUF_MAX / item_size));
+
+            for (size_t b = 0; b < (size_t) n * item_size; b++) src[b] = (uint8_t) rng();
+            memset(mask.out, 0, sizeof(mask.out));
+            memset(ref.out, 0, sizeof(ref.out));
+
+            uint32_t const r_mask = run_op(&mask, op, n);
+            uint32_t const r_ref = run_op(&ref, op, n);
+            ops++;
+
+            if (r_mask != r_ref || mask.ff.wr_idx != ref.ff.wr_idx || mask.ff.rd_idx != ref.ff.rd_idx ||
+                memcmp(mask.mem, ref.mem, sizeof(mask.mem)) || memcmp(mask.out, ref.out, sizeof(mask.out))) {
+              printf("MISMATCH item_size=%u depth=%u overwritable=%d start=%u op#%u %s(n=%u): "
+                     "ret %08x/%08x wr %u/%u rd %u/%u\n",
+                     item_size, depth, ow, starts[p], k, op_name[op], n, r_mask, r_ref,
+                     mask.ff.wr_idx, ref.ff.wr_idx, mask.ff.rd_idx, ref.ff.rd_idx);
+              return false;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  printf("equivalence: %u configurations, %u operations, bit-identical\n", configs, ops);
+  return true;
+}
+
+//--------------------------------------------------------------------+
+// Throughput
+//--------------------------------------------------------------------+
+
+typedef enum { MODE_BULK, MODE_SINGLE, MODE_CONST } bench_mode_t;
+
+typedef struct {
+  const char* name;
+  bench_mode_t mode;
+  uint16_t item_size;
+  uint16_t depth;
+  uint16_t chunk;   // items per write/read call
+  uint16_t start;   // initial index, shifts the wrap point
+} bench_case_t;
+
+// Power-of-two depths only, the mask is 0 otherwise and both variants run the same code
+static const bench_case_t cases[] = {
+  { "bulk 64B chunk",        MODE_BULK,   1, 256,  64, 0 },
+  { "bulk 7B chunk",         MODE_BULK,   1, 64,   7,  0 },
+  { "bulk 16x4B",            MODE_BULK,   4, 64,   16, 0 },
+  { "single byte",           MODE_SINGLE, 1, 64,   1,  0 },
+  { "single 4B item",        MODE_SINGLE, 4, 64,   1,  0 },
+  { "hw fifo 64B",           MODE_CONST,  1, 512,  64, 0 },
+  { "hw fifo 13B wrap",      MODE_CONST,  1, 256,  13, 0 },
+};
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+// Pump chunk-sized write + read pairs through the FIFO, return bytes per second
+static double run_bench(const bench_case_t* c, bool generic, double seconds) {
+  static uint8_t mem[BUF_MAX];
+  static uint8_t buf[BUF_MAX];
+  tu_fifo_t ff;
+  uint64_t bytes = 0;
+  uint32_t sink = 0;
+
+  config_fifo(&ff, mem, c->depth, c->item_size, false, generic);
+  tu_fifo_advance_write_pointer(&ff, c->start);
+  tu_fifo_advance_read_pointer(&ff, c->start);
+  memset(buf, 0x5A, sizeof(buf));
+
+  double const t0 = now_sec();
+  double t = t0;
+  while (t - t0 < seconds) {
+    for (int iter = 0; iter < 1024; iter++) {
+      uint16_t w = 0, r = 0;
+      switch (c->mode) {
+        case MODE_BULK:
+          w = tu_fifo_write_n(&ff, buf, c->chunk);
+          r = tu_fifo_read_n(&ff, buf, c->chunk);
+          break;
+        case MODE_SINGLE:
+          w = tu_fifo_write(&ff, buf);
+          r = tu_fifo_read(&ff, buf);
+          break;
+        case MODE_CONST:
+          w = tu_fifo_write_n_const_addr_full_words(&ff, buf, c->chunk);
+          r = tu_fifo_read_n_const_addr_full_words(&ff, buf, c->chunk);
+          break;
+      }
+      bytes += (uint64_t) (w + r) * c->item_size;
+      sink += buf[0];
+    }
+    t = now_sec();
+  }
+
+  if (sink == 0xFFFFFFFFu) printf(" "); // keep the loop observable
+  return (double) bytes / (t - t0);
+}
+
+int main(int argc, char** argv) {
+  double const seconds = argc > 1 ? atof(argv[1]) : 1.0;
+
+  if (!check_equivalence(2000)) return 1;
+
+  printf("\n%-24s %5s %5s %5s %5s %12s %12s %8s\n", "case", "item", "depth", "chunk", "start", "generic MB/s",
+         "mask MB/s", "speedup");
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    const bench_case_t* c = &cases[i];
+    double g = 0, m = 0;
+
+    // alternate the variants and keep the best round of each to filter out scheduling noise
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+      double const gr = run_bench(c, true, seconds / BENCH_ROUNDS);
+      double const mr = run_bench(c, false, seconds / BENCH_ROUNDS);
+      if (gr > g) g = gr;
+      if (mr > m) m = mr;
+    }
+    printf("%-24s %5u %5u %5u %5u %12.1f %12.1f %7.2fx\n", c->name, c->item_size, c->depth, c->chunk, c->start,
+           g / 1e6, m / 1e6, m / g);
+  }
+
+  return 0;
+}
@@ -0,0 +1,251 @@
+/*
+ * Linux gadget build of the Pro Controller simulator: the shared protocol
+ * engine from ../main driven by a FunctionFS gadget (ns_gadget.c) instead of
+ * TinyUSB, on one epoll loop.
+ *
+ *   make && sudo ./ns_gadget_sim [-u udc] [-n name] [-p period_us] [-s stats_s]
+ *
+ * SIGUSR1 dumps the /metrics text to stdout; SIGINT/SIGTERM unbind and exit
+ * after printing the final throughput and latency figures.
+ */
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "ns_boot.h"
+#include "ns_descriptors.h"
+#include "ns_events.h"
+#include "ns_gadget.h"
+#include "ns_loop.h"
+#include "ns_macro.h"
+#include "ns_metrics.h"
+#include "ns_proto.h"
+#include "ns_protocol.h"
+#include "tinyusb.h"
+
+static const char *TAG = "NS_SIM_MAIN";
+
+static int64_t s_period_us = NS_STD_PERIOD_MS * 1000;
+static int64_t s_stats_interval_us = 10 * 1000000;
+static int64_t s_stats_since_us;
+static bool s_last_mounted;
+static int64_t s_last_loop_us;
+
+uint8_t const *tud_hid_descriptor_report_cb(uint8_t instance)
+{
+    (void)instance;
+    return ns_descriptors_report_map();
+}
+
+uint16_t tud_hid_get_report_cb(uint8_t instance,
+                               uint8_t report_id,
+                               hid_report_type_t report_type,
+                               uint8_t *buffer,
+                               uint16_t reqlen)
+{
+    return ns_protocol_get_report(instance, report_id, report_type, buffer, reqlen);
+}
+
+void tud_hid_set_report_cb(uint8_t instance,
+                           uint8_t report_id,
+                           hid_report_type_t report_type,
+                           uint8_t const *buffer,
+                           uint16_t bufsize)
+{
+    ns_protocol_set_report(instance, report_id, report_type, buffer, bufsize);
+}
+
+static void ns_print_stats(int64_t now)
+{
+    const ns_gadget_stats_t *st = ns_gadget_stats();
+    double secs = (double)(now - s_stats_since_us) / 1e6;
+
+    if (secs <= 0) {
+        return;
+    }
+    ESP_LOGI(TAG, "in %.1f reports/s %.0f B/s, latency p50 %u p99 %u max %u us, errors %llu",
+             (double)st->in_reports / secs, (double)st->in_bytes / secs,
+             (unsigned)ns_gadget_hist_percentile(&st->in_latency, 500),
+             (unsigned)ns_gadget_hist_percentile(&st->in_latency, 990),
+             (unsigned)st->in_latency.max_us, (unsigned long long)st->in_errors);
+    ESP_LOGI(TAG, "out %llu reports, reply p50 %u p99 %u max %u us (%llu), ep0 %llu setups %llu stalls",
+             (unsigned long long)st->out_reports,
+             (unsigned)ns_gadget_hist_percentile(&st->reply_latency, 500),
+             (unsigned)ns_gadget_hist_percentile(&st->reply_latency, 990),
+             (unsigned)st->reply_latency.max_us, (unsigned long long)st->reply_latency.count,
+             (unsigned long long)st->setups, (unsigned long long)st->stalls);
+}
+
+static void ns_metrics_stdout(void *ctx, const char *text)
+{
+    (void)ctx;
+    fputs(text, stdout);
+}
+
+/* Body of the firmware's app_main loop, run from a periodic timerfd. */
+static void ns_period_tick(void *arg, uint32_t events)
+{
+    int fd = *(int *)arg;
+    uint64_t expirations;
+    int64_t now = esp_timer_get_time();
+    bool mounted;
+
+    (void)events;
+    if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+        return;
+    }
+
+    if (s_last_loop_us != 0) {
+        int32_t period_us = (int32_t)(now - s_last_loop_us);
+        int32_t jitter_us = period_us - (int32_t)s_period_us;
+
+        if (jitter_us < 0) {
+            jitter_us = -jitter_us;
+        }
+        ns_metrics_set_gauge(NS_METRIC_GAUGE_LOOP_PERIOD_US, period_us);
+        ns_metrics_max_gauge(NS_METRIC_GAUGE_LOOP_JITTER_MAX_US, jitter_us);
+        ns_metrics_inc(NS_METRIC_LOOP_ITERATIONS);
+        ns_metrics_add(NS_METRIC_LOOP_JITTER_US_SUM, (uint32_t)jitter_us);
+    }
+    s_last_loop_us = now;
+
+    mounted = tud_mounted();
+    if (mounted != s_last_mounted) {
+        ESP_LOGI(TAG, "tud_mounted changed: %d -> %d", (int)s_last_mounted, (int)mounted);
+        ns_metrics_inc(mounted ? NS_METRIC_USB_MOUNT : NS_METRIC_USB_UNMOUNT);
+        ns_events_publish(NS_EVENT_USB_MOUNT, mounted);
+        if (mounted) {
+            ns_boot_mark(NS_BOOT_USB_MOUNTED);
+            ns_gadget_stats_reset();
+            s_stats_since_us = now;
+        }
+        s_last_mounted = mounted;
+    }
+    ns_macro_periodic();
+    ns_protocol_periodic();
+
+    if (mounted && now - s_stats_since_us >= s_stats_interval_us) {
+        ns_print_stats(now);
+        ns_gadget_stats_reset();
+        s_stats_since_us = now;
+    }
+}
+
+static void ns_signal(void *arg, uint32_t events)
+{
+    int fd = *(int *)arg;
+    struct signalfd_siginfo info;
+
+    (void)events;
+    if (read(fd, &info, sizeof(info)) != sizeof(info)) {
+        return;
+    }
+    if (info.ssi_signo == SIGUSR1) {
+        ns_metrics_render(ns_metrics_stdout, NULL);
+        fflush(stdout);
+        return;
+    }
+    ns_loop_stop();
+}
+
+static void ns_usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [-u udc] [-n name] [-c configfs_dir] [-f ffs_dir] [-p period_us] [-s stats_s]\n"
+            "  -u  UDC to bind (default: first in /sys/class/udc)\n"
+            "  -n  gadget / FunctionFS instance name (default ns_pro)\n"
+            "  -p  protocol engine period in us (default %d)\n"
+            "  -s  stats interval in seconds (default 10)\n",
+            argv0, NS_STD_PERIOD_MS * 1000);
+}
+
+int main(int argc, char **argv)
+{
+    tinyusb_config_t tusb_cfg = {0};
+    ns_gadget_config_t gadget_cfg = {0};
+    struct itimerspec period = {0};
+    sigset_t mask;
+    int timer_fd;
+    int signal_fd;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "u:n:c:f:p:s:h")) != -1) {
+        switch (opt) {
+        case 'u':
+            gadget_cfg.udc = optarg;
+            break;
+        case 'n':
+            gadget_cfg.name = optarg;
+            break;
+        case 'c':
+            gadget_cfg.configfs = optarg;
+            break;
+        case 'f':
+            gadget_cfg.ffs_dir = optarg;
+            break;
+        case 'p':
+            s_period_us = strtoll(optarg, NULL, 0);
+            break;
+        case 's':
+            s_stats_interval_us = strtoll(optarg, NULL, 0) * 1000000;
+            break;
+        default:
+            ns_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (s_period_us < 100) {
+        ns_usage(argv[0]);
+        return 2;
+    }
+
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    sigaddset(&mask, SIGUSR1);
+    sigprocmask(SIG_BLOCK, &mask, NULL);
+
+    if (!ns_loop_init()) {
+        return 1;
+    }
+    signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (signal_fd < 0 || timer_fd < 0 ||
+        !ns_loop_add(signal_fd, EPOLLIN, ns_signal, &signal_fd) ||
+        !ns_loop_add(timer_fd, EPOLLIN, ns_period_tick, &timer_fd)) {
+        ESP_LOGE(TAG, "loop setup: errno %d", errno);
+        return 1;
+    }
+
+    ns_boot_mark(NS_BOOT_APP_MAIN);
+    ns_protocol_init();
+    ns_descriptors_fill_tusb_config(&tusb_cfg);
+
+    ESP_LOGI(TAG, "Nintendo Switch Pro USB simulator init (Linux gadget)");
+    ESP_LOGI(TAG, "USB VID:PID = %04X:%04X", NS_VENDOR_ID, NS_PRODUCT_ID);
+    if (!ns_gadget_start(&tusb_cfg, &gadget_cfg)) {
+        return 1;
+    }
+    ns_boot_mark(NS_BOOT_USB_INSTALLED);
+    ESP_LOGI(TAG, "Nintendo Switch Pro USB simulator ready");
+
+    period.it_value.tv_sec = period.it_interval.tv_sec = (time_t)(s_period_us / 1000000);
+    period.it_value.tv_nsec = period.it_interval.tv_nsec = (long)(s_period_us % 1000000) * 1000;
+    timerfd_settime(timer_fd, 0, &period, NULL);
+
+    ns_loop_run();
+
+    if (s_last_mounted) {
+        ns_print_stats(esp_timer_get_time());
+    }
+    ns_gadget_stop();
+    return 0;
+}
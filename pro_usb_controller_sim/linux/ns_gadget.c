@@ -0,0 +1,951 @@
+#include "ns_gadget.h"
+
+#include <dirent.h>
+#include <endian.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/aio_abi.h>
+#include <linux/usb/ch9.h>
+#include <linux/usb/functionfs.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mount.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "class/hid/hid_device.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "ns_loop.h"
+
+static const char *TAG = "NS_GADGET";
+
+#define NS_GADGET_EP_MAX    2
+#define NS_GADGET_LANG_US   0x0409
+
+enum {
+    NS_GADGET_AIO_IN = 1,
+    NS_GADGET_AIO_OUT = 2,
+};
+
+typedef struct {
+    uint16_t len;
+    uint8_t buf[CFG_TUD_HID_EP_BUFSIZE];
+} ns_gadget_slot_t;
+
+/* Same ordering contract as the hid_device.c IN queue: queued reports first, then the latest state. */
+typedef struct {
+    ns_gadget_slot_t fifo[CFG_TUD_HID_IN_QUEUE_DEPTH];
+    ns_gadget_slot_t latest;
+    uint8_t rd_idx;
+    uint8_t count;
+    bool latest_valid;
+
+    ns_gadget_slot_t inflight;
+    bool busy;
+    bool inflight_queued;
+    int64_t submit_us;
+} ns_gadget_in_t;
+
+static char s_gadget_dir[256];
+static char s_ffs_dir[256];
+static char s_name[64];
+static bool s_mounted_ffs;
+static bool s_bound;
+
+static int s_ep0_fd = -1;
+static int s_in_fd = -1;
+static int s_out_fd = -1;
+static int s_aio_efd = -1;
+static aio_context_t s_aio_ctx;
+
+static bool s_enabled;
+static bool s_suspended;
+
+/* Class descriptors kept from the registered configuration. */
+static uint8_t s_hid_desc[9];
+static uint16_t s_report_desc_len;
+static uint8_t s_protocol_mode = HID_PROTOCOL_REPORT;
+static uint8_t s_idle_rate;
+
+static ns_gadget_in_t s_in;
+static struct iocb s_in_iocb;
+static struct iocb s_out_iocb;
+static uint8_t s_out_buf[CFG_TUD_HID_EP_BUFSIZE];
+static bool s_out_busy;
+static int64_t s_reply_pending_us;
+
+static ns_gadget_stats_t s_stats;
+
+//--------------------------------------------------------------------+
+// Weak stubs, as in hid_device.c
+//--------------------------------------------------------------------+
+TU_ATTR_WEAK void tud_hid_set_protocol_cb(uint8_t instance, uint8_t protocol)
+{
+    (void)instance;
+    (void)protocol;
+}
+
+TU_ATTR_WEAK bool tud_hid_set_idle_cb(uint8_t instance, uint8_t idle_rate)
+{
+    (void)instance;
+    (void)idle_rate;
+    return true;
+}
+
+TU_ATTR_WEAK void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len)
+{
+    (void)instance;
+    (void)report;
+    (void)len;
+}
+
+//--------------------------------------------------------------------+
+// Stats
+//--------------------------------------------------------------------+
+static void ns_gadget_hist_add(ns_gadget_hist_t *hist, int64_t value_us)
+{
+    uint32_t us = value_us < 0 ? 0 : (value_us > UINT32_MAX ? UINT32_MAX : (uint32_t)value_us);
+    uint32_t bucket = us / NS_GADGET_HIST_BUCKET_US;
+
+    if (bucket >= NS_GADGET_HIST_BUCKETS) {
+        bucket = NS_GADGET_HIST_BUCKETS - 1;
+    }
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->sum_us += us;
+    if (us > hist->max_us) {
+        hist->max_us = us;
+    }
+}
+
+uint32_t ns_gadget_hist_percentile(const ns_gadget_hist_t *hist, uint32_t permille)
+{
+    uint64_t rank = (hist->count * permille + 999) / 1000;
+    uint64_t seen = 0;
+
+    if (hist->count == 0) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < NS_GADGET_HIST_BUCKETS - 1; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            /* Upper edge of the bucket, never above the observed maximum. */
+            uint32_t edge = (i + 1) * NS_GADGET_HIST_BUCKET_US;
+            return edge < hist->max_us ? edge : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+const ns_gadget_stats_t *ns_gadget_stats(void)
+{
+    return &s_stats;
+}
+
+void ns_gadget_stats_reset(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+//--------------------------------------------------------------------+
+// Linux AIO, raw syscalls (no libaio dependency)
+//--------------------------------------------------------------------+
+static int ns_aio_setup(unsigned nr, aio_context_t *ctx)
+{
+    return (int)syscall(__NR_io_setup, nr, ctx);
+}
+
+static int ns_aio_destroy(aio_context_t ctx)
+{
+    return (int)syscall(__NR_io_destroy, ctx);
+}
+
+static int ns_aio_submit(aio_context_t ctx, struct iocb *iocb)
+{
+    struct iocb *list[1] = {iocb};
+
+    return (int)syscall(__NR_io_submit, ctx, 1, list);
+}
+
+static int ns_aio_getevents(aio_context_t ctx, long max_nr, struct io_event *events)
+{
+    struct timespec zero = {0};
+
+    return (int)syscall(__NR_io_getevents, ctx, 0, max_nr, events, &zero);
+}
+
+static bool ns_gadget_aio_start(struct iocb *iocb, int fd, uint16_t opcode, uint64_t tag, void *buf, size_t len)
+{
+    memset(iocb, 0, sizeof(*iocb));
+    iocb->aio_data = tag;
+    iocb->aio_lio_opcode = opcode;
+    iocb->aio_fildes = (uint32_t)fd;
+    iocb->aio_buf = (uint64_t)(uintptr_t)buf;
+    iocb->aio_nbytes = len;
+    iocb->aio_flags = IOCB_FLAG_RESFD;
+    iocb->aio_resfd = (uint32_t)s_aio_efd;
+    if (ns_aio_submit(s_aio_ctx, iocb) != 1) {
+        ESP_LOGW(TAG, "io_submit ep%s: errno %d", tag == NS_GADGET_AIO_IN ? "in" : "out", errno);
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------+
+// Interrupt endpoints
+//--------------------------------------------------------------------+
+static void ns_gadget_in_clear(void)
+{
+    s_in.rd_idx = 0;
+    s_in.count = 0;
+    s_in.latest_valid = false;
+}
+
+static bool ns_gadget_slot_store(ns_gadget_slot_t *slot, uint8_t report_id, void const *report, uint16_t len)
+{
+    if (report_id) {
+        TU_VERIFY(len <= CFG_TUD_HID_EP_BUFSIZE - 1);
+        slot->buf[0] = report_id;
+        memcpy(slot->buf + 1, report, len);
+        len++;
+    } else {
+        TU_VERIFY(len <= CFG_TUD_HID_EP_BUFSIZE);
+        memcpy(slot->buf, report, len);
+    }
+    slot->len = len;
+    return true;
+}
+
+/* Start the next pending report if the IN endpoint is idle; its completion calls this again. */
+static void ns_gadget_in_kick(void)
+{
+    ns_gadget_slot_t *slot;
+
+    if (!s_enabled || s_in.busy) {
+        return;
+    }
+    if (s_in.count) {
+        slot = &s_in.fifo[s_in.rd_idx];
+        s_in.rd_idx = (uint8_t)((s_in.rd_idx + 1) % CFG_TUD_HID_IN_QUEUE_DEPTH);
+        s_in.count--;
+        s_in.inflight_queued = true;
+    } else if (s_in.latest_valid) {
+        slot = &s_in.latest;
+        s_in.latest_valid = false;
+        s_in.inflight_queued = false;
+    } else {
+        return;
+    }
+
+    s_in.inflight = *slot;
+    s_in.submit_us = esp_timer_get_time();
+    if (!ns_gadget_aio_start(&s_in_iocb, s_in_fd, IOCB_CMD_PWRITE, NS_GADGET_AIO_IN,
+                             s_in.inflight.buf, s_in.inflight.len)) {
+        s_stats.in_errors++;
+        return;
+    }
+    s_in.busy = true;
+}
+
+static void ns_gadget_in_done(int64_t res)
+{
+    int64_t now = esp_timer_get_time();
+
+    s_in.busy = false;
+    if (res < 0) {
+        /* -ESHUTDOWN when the host deconfigures with a report in flight. */
+        s_stats.in_errors++;
+        ns_gadget_in_kick();
+        return;
+    }
+
+    s_stats.in_reports++;
+    s_stats.in_bytes += (uint64_t)res;
+    ns_gadget_hist_add(&s_stats.in_latency, now - s_in.submit_us);
+    if (s_in.inflight_queued && s_reply_pending_us != 0 && s_in.submit_us >= s_reply_pending_us) {
+        ns_gadget_hist_add(&s_stats.reply_latency, now - s_reply_pending_us);
+        s_reply_pending_us = 0;
+    }
+
+    tud_hid_report_complete_cb(0, s_in.inflight.buf, (uint16_t)res);
+    ns_gadget_in_kick();
+}
+
+static void ns_gadget_out_arm(void)
+{
+    if (!s_enabled || s_out_busy || s_out_fd < 0) {
+        return;
+    }
+    s_out_busy = ns_gadget_aio_start(&s_out_iocb, s_out_fd, IOCB_CMD_PREAD, NS_GADGET_AIO_OUT,
+                                     s_out_buf, sizeof(s_out_buf));
+}
+
+static void ns_gadget_host_report(void)
+{
+    s_stats.out_reports++;
+    if (s_reply_pending_us == 0) {
+        s_reply_pending_us = esp_timer_get_time();
+    }
+}
+
+static void ns_gadget_out_done(int64_t res)
+{
+    s_out_busy = false;
+    if (res > 0) {
+        s_stats.out_bytes += (uint64_t)res;
+        ns_gadget_host_report();
+        tud_hid_set_report_cb(0, 0, HID_REPORT_TYPE_OUTPUT, s_out_buf, (uint16_t)res);
+    }
+    ns_gadget_out_arm();
+}
+
+static void ns_gadget_aio_ready(void *arg, uint32_t events)
+{
+    struct io_event done[NS_GADGET_EP_MAX];
+    uint64_t signalled;
+    int n;
+
+    (void)arg;
+    (void)events;
+    if (read(s_aio_efd, &signalled, sizeof(signalled)) != sizeof(signalled)) {
+        return;
+    }
+    while ((n = ns_aio_getevents(s_aio_ctx, NS_GADGET_EP_MAX, done)) > 0) {
+        for (int i = 0; i < n; i++) {
+            if (done[i].data == NS_GADGET_AIO_IN) {
+                ns_gadget_in_done(done[i].res);
+            } else {
+                ns_gadget_out_done(done[i].res);
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------+
+// ep0: FunctionFS events and HID class requests
+//--------------------------------------------------------------------+
+static void ns_gadget_ep0_stall(const struct usb_ctrlrequest *setup)
+{
+    /* FunctionFS halts ep0 on an I/O in the direction opposite to the request. */
+    if (setup->bRequestType & USB_DIR_IN) {
+        (void)!read(s_ep0_fd, NULL, 0);
+    } else {
+        (void)!write(s_ep0_fd, NULL, 0);
+    }
+    s_stats.stalls++;
+}
+
+static void ns_gadget_ep0_in(const struct usb_ctrlrequest *setup, const void *data, uint16_t len)
+{
+    uint16_t length = le16toh(setup->wLength);
+
+    if (write(s_ep0_fd, data, len < length ? len : length) < 0) {
+        ESP_LOGW(TAG, "ep0 write: errno %d", errno);
+    }
+}
+
+static void ns_gadget_ep0_ack(void)
+{
+    (void)!read(s_ep0_fd, NULL, 0);
+}
+
+static bool ns_gadget_setup_std(const struct usb_ctrlrequest *setup)
+{
+    uint8_t desc_type = (uint8_t)(le16toh(setup->wValue) >> 8);
+
+    if (setup->bRequest != USB_REQ_GET_DESCRIPTOR || !(setup->bRequestType & USB_DIR_IN)) {
+        return false;
+    }
+    if (desc_type == HID_DESC_TYPE_HID) {
+        ns_gadget_ep0_in(setup, s_hid_desc, sizeof(s_hid_desc));
+        return true;
+    }
+    if (desc_type == HID_DESC_TYPE_REPORT) {
+        ns_gadget_ep0_in(setup, tud_hid_descriptor_report_cb(0), s_report_desc_len);
+        return true;
+    }
+    return false;
+}
+
+static bool ns_gadget_setup_class(const struct usb_ctrlrequest *setup)
+{
+    uint16_t value = le16toh(setup->wValue);
+    uint16_t length = le16toh(setup->wLength);
+    uint8_t report_type = (uint8_t)(value >> 8);
+    uint8_t report_id = (uint8_t)value;
+    uint8_t buf[CFG_TUD_HID_EP_BUFSIZE];
+
+    switch (setup->bRequest) {
+    case HID_REQ_CONTROL_GET_REPORT: {
+        uint16_t req_len = length < sizeof(buf) ? length : sizeof(buf);
+        uint8_t *report_buf = buf;
+        uint16_t xferlen = 0;
+
+        /* A specific report ID is echoed as the first byte, as hid_device.c does. */
+        if (report_id != HID_REPORT_TYPE_INVALID && req_len > 1) {
+            *report_buf++ = report_id;
+            req_len--;
+            xferlen++;
+        }
+        xferlen += tud_hid_get_report_cb(0, report_id, (hid_report_type_t)report_type, report_buf, req_len);
+        if (xferlen == 0) {
+            return false;
+        }
+        ns_gadget_ep0_in(setup, buf, xferlen);
+        return true;
+    }
+    case HID_REQ_CONTROL_SET_REPORT: {
+        const uint8_t *report_buf = buf;
+        ssize_t n;
+
+        if (length > sizeof(buf)) {
+            return false;
+        }
+        n = read(s_ep0_fd, buf, length);
+        if (n < 0) {
+            ESP_LOGW(TAG, "ep0 read: errno %d", errno);
+            return true;
+        }
+        if (report_id != HID_REPORT_TYPE_INVALID && n > 1 && report_id == buf[0]) {
+            report_buf++;
+            n--;
+        }
+        ns_gadget_host_report();
+        tud_hid_set_report_cb(0, report_id, (hid_report_type_t)report_type, report_buf, (uint16_t)n);
+        return true;
+    }
+    case HID_REQ_CONTROL_SET_IDLE:
+        s_idle_rate = (uint8_t)(value >> 8);
+        if (!tud_hid_set_idle_cb(0, s_idle_rate)) {
+            return false;
+        }
+        ns_gadget_ep0_ack();
+        return true;
+    case HID_REQ_CONTROL_GET_IDLE:
+        ns_gadget_ep0_in(setup, &s_idle_rate, 1);
+        return true;
+    case HID_REQ_CONTROL_GET_PROTOCOL:
+        ns_gadget_ep0_in(setup, &s_protocol_mode, 1);
+        return true;
+    case HID_REQ_CONTROL_SET_PROTOCOL:
+        s_protocol_mode = (uint8_t)value;
+        ns_gadget_ep0_ack();
+        tud_hid_set_protocol_cb(0, s_protocol_mode);
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void ns_gadget_setup(const struct usb_ctrlrequest *setup)
+{
+    bool handled = false;
+
+    s_stats.setups++;
+    if ((setup->bRequestType & USB_RECIP_MASK) == USB_RECIP_INTERFACE && le16toh(setup->wIndex) == 0) {
+        if ((setup->bRequestType & USB_TYPE_MASK) == USB_TYPE_STANDARD) {
+            handled = ns_gadget_setup_std(setup);
+        } else if ((setup->bRequestType & USB_TYPE_MASK) == USB_TYPE_CLASS) {
+            handled = ns_gadget_setup_class(setup);
+        }
+    }
+    if (!handled) {
+        ns_gadget_ep0_stall(setup);
+    }
+}
+
+static void ns_gadget_ep0_ready(void *arg, uint32_t events)
+{
+    struct usb_functionfs_event ev[4];
+    ssize_t n;
+
+    (void)arg;
+    (void)events;
+    n = read(s_ep0_fd, ev, sizeof(ev));
+    if (n < 0) {
+        if (errno != EAGAIN && errno != EINTR) {
+            ESP_LOGE(TAG, "ep0 read: errno %d", errno);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < (size_t)n / sizeof(ev[0]); i++) {
+        switch (ev[i].type) {
+        case FUNCTIONFS_ENABLE:
+            /* Reports queued for the previous configuration are stale. */
+            ns_gadget_in_clear();
+            s_protocol_mode = HID_PROTOCOL_REPORT;
+            s_enabled = true;
+            s_suspended = false;
+            ESP_LOGI(TAG, "configured");
+            ns_gadget_out_arm();
+            break;
+        case FUNCTIONFS_DISABLE:
+        case FUNCTIONFS_UNBIND:
+            if (s_enabled) {
+                ESP_LOGI(TAG, "deconfigured");
+            }
+            s_enabled = false;
+            break;
+        case FUNCTIONFS_SUSPEND:
+            s_suspended = true;
+            break;
+        case FUNCTIONFS_RESUME:
+            s_suspended = false;
+            break;
+        case FUNCTIONFS_SETUP:
+            ns_gadget_setup(&ev[i].u.setup);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+//--------------------------------------------------------------------+
+// APPLICATION API (hid_device.h / usbd.h subset)
+//--------------------------------------------------------------------+
+bool tud_mounted(void)
+{
+    return s_enabled;
+}
+
+bool tud_suspended(void)
+{
+    return s_suspended;
+}
+
+bool tud_hid_n_ready(uint8_t instance)
+{
+    return instance == 0 && tud_ready() && !s_in.busy;
+}
+
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, void const *report, uint16_t len)
+{
+    TU_VERIFY(tud_hid_n_ready(instance) && s_in.count == 0);
+    TU_VERIFY(ns_gadget_slot_store(&s_in.latest, report_id, report, len));
+    s_in.latest_valid = true;
+    ns_gadget_in_kick();
+    return true;
+}
+
+bool tud_hid_n_report_queued(uint8_t instance, uint8_t report_id, void const *report, uint16_t len)
+{
+    uint8_t wr_idx;
+
+    TU_VERIFY(instance == 0 && s_enabled);
+    TU_VERIFY(s_in.count < CFG_TUD_HID_IN_QUEUE_DEPTH);
+    wr_idx = (uint8_t)((s_in.rd_idx + s_in.count) % CFG_TUD_HID_IN_QUEUE_DEPTH);
+    TU_VERIFY(ns_gadget_slot_store(&s_in.fifo[wr_idx], report_id, report, len));
+    s_in.count++;
+    ns_gadget_in_kick();
+    return true;
+}
+
+bool tud_hid_n_report_latest(uint8_t instance, uint8_t report_id, void const *report, uint16_t len)
+{
+    TU_VERIFY(instance == 0 && s_enabled);
+    TU_VERIFY(ns_gadget_slot_store(&s_in.latest, report_id, report, len));
+    s_in.latest_valid = true;
+    ns_gadget_in_kick();
+    return true;
+}
+
+uint8_t tud_hid_n_report_queue_count(uint8_t instance)
+{
+    return instance == 0 ? s_in.count : 0;
+}
+
+//--------------------------------------------------------------------+
+// configfs + FunctionFS setup
+//--------------------------------------------------------------------+
+static bool ns_gadget_write_attr(const char *dir, const char *attr, const char *fmt, ...)
+{
+    char path[512];
+    char value[256];
+    va_list ap;
+    int fd;
+    ssize_t n;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, attr);
+    va_start(ap, fmt);
+    vsnprintf(value, sizeof(value), fmt, ap);
+    va_end(ap);
+
+    fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "open %s: errno %d", path, errno);
+        return false;
+    }
+    n = write(fd, value, strlen(value));
+    close(fd);
+    if (n < 0) {
+        ESP_LOGE(TAG, "write %s = \"%s\": errno %d", path, value, errno);
+        return false;
+    }
+    return true;
+}
+
+static bool ns_gadget_mkdir(const char *fmt, ...)
+{
+    char path[512];
+    va_list ap;
+
+    va_start(ap, fmt);
+    vsnprintf(path, sizeof(path), fmt, ap);
+    va_end(ap);
+    if (mkdir(path, 0755) < 0 && errno != EEXIST) {
+        ESP_LOGE(TAG, "mkdir %s: errno %d", path, errno);
+        return false;
+    }
+    return true;
+}
+
+static bool ns_gadget_find_udc(char *out, size_t out_len)
+{
+    DIR *dir = opendir("/sys/class/udc");
+    struct dirent *entry;
+    bool found = false;
+
+    if (dir == NULL) {
+        return false;
+    }
+    while (!found && (entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] != '.') {
+            snprintf(out, out_len, "%s", entry->d_name);
+            found = true;
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+/* bInterval counts frames at full speed and 2^(n-1) microframes at high speed. */
+static uint8_t ns_gadget_hs_interval(uint8_t fs_interval)
+{
+    uint8_t interval = 1;
+
+    while (interval < 16 && (1u << (interval - 1)) < fs_interval * 8u) {
+        interval++;
+    }
+    return interval;
+}
+
+/*
+ * Interface, HID and endpoint descriptors of the configuration, written to ep0
+ * once per speed. FunctionFS numbers string indices from 1 within the function,
+ * so iInterface is rewritten to the single function string.
+ */
+static bool ns_gadget_write_descs(const uint8_t *config, const char *itf_string)
+{
+    uint16_t total = (uint16_t)(config[2] | (config[3] << 8));
+    uint16_t body_len = total - config[0];
+    uint8_t fs_body[128];
+    uint8_t hs_body[128];
+    uint32_t count = 0;
+    uint8_t blob[sizeof(struct usb_functionfs_descs_head_v2) + 8 + sizeof(fs_body) + sizeof(hs_body)];
+    struct usb_functionfs_descs_head_v2 head;
+    uint32_t le;
+    size_t pos = 0;
+
+    if (body_len > sizeof(fs_body)) {
+        ESP_LOGE(TAG, "configuration too large: %u", (unsigned)total);
+        return false;
+    }
+    memcpy(fs_body, config + config[0], body_len);
+    memcpy(hs_body, fs_body, body_len);
+    for (uint16_t off = 0; off + 1 < body_len && fs_body[off] != 0; off += fs_body[off]) {
+        count++;
+        switch (fs_body[off + 1]) {
+        case USB_DT_INTERFACE:
+            fs_body[off + 8] = hs_body[off + 8] = itf_string != NULL ? 1 : 0;
+            break;
+        case HID_DESC_TYPE_HID:
+            memcpy(s_hid_desc, &fs_body[off], sizeof(s_hid_desc));
+            s_report_desc_len = (uint16_t)(fs_body[off + 7] | (fs_body[off + 8] << 8));
+            break;
+        case USB_DT_ENDPOINT:
+            hs_body[off + 6] = ns_gadget_hs_interval(fs_body[off + 6]);
+            break;
+        default:
+            break;
+        }
+    }
+
+    head.magic = htole32(FUNCTIONFS_DESCRIPTORS_MAGIC_V2);
+    head.flags = htole32(FUNCTIONFS_HAS_FS_DESC | FUNCTIONFS_HAS_HS_DESC);
+    head.length = htole32((uint32_t)(sizeof(head) + 8 + 2 * body_len));
+    memcpy(blob + pos, &head, sizeof(head));
+    pos += sizeof(head);
+    le = htole32(count);
+    memcpy(blob + pos, &le, 4);
+    memcpy(blob + pos + 4, &le, 4);
+    pos += 8;
+    memcpy(blob + pos, fs_body, body_len);
+    pos += body_len;
+    memcpy(blob + pos, hs_body, body_len);
+    pos += body_len;
+
+    if (write(s_ep0_fd, blob, pos) != (ssize_t)pos) {
+        ESP_LOGE(TAG, "ep0 descriptors: errno %d", errno);
+        return false;
+    }
+    return true;
+}
+
+static bool ns_gadget_write_strings(const char *itf_string)
+{
+    uint8_t blob[sizeof(struct usb_functionfs_strings_head) + 2 + 128];
+    struct usb_functionfs_strings_head head;
+    size_t str_len = itf_string != NULL ? strlen(itf_string) + 1 : 0;
+    uint16_t lang = htole16(NS_GADGET_LANG_US);
+    size_t pos = 0;
+
+    if (str_len > 128) {
+        return false;
+    }
+    head.magic = htole32(FUNCTIONFS_STRINGS_MAGIC);
+    head.length = htole32((uint32_t)(sizeof(head) + (str_len ? 2 + str_len : 0)));
+    head.str_count = htole32(str_len ? 1 : 0);
+    head.lang_count = htole32(str_len ? 1 : 0);
+    memcpy(blob, &head, sizeof(head));
+    pos += sizeof(head);
+    if (str_len) {
+        memcpy(blob + pos, &lang, 2);
+        memcpy(blob + pos + 2, itf_string, str_len);
+        pos += 2 + str_len;
+    }
+
+    if (write(s_ep0_fd, blob, pos) != (ssize_t)pos) {
+        ESP_LOGE(TAG, "ep0 strings: errno %d", errno);
+        return false;
+    }
+    return true;
+}
+
+/* FunctionFS names endpoint files ep1.. in descriptor order. */
+static bool ns_gadget_open_eps(const uint8_t *config)
+{
+    uint16_t total = (uint16_t)(config[2] | (config[3] << 8));
+    int index = 0;
+
+    for (uint16_t off = config[0]; off + 1 < total && config[off] != 0; off += config[off]) {
+        char path[512];
+        int fd;
+
+        if (config[off + 1] != USB_DT_ENDPOINT) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/ep%d", s_ffs_dir, ++index);
+        fd = open(path, O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            ESP_LOGE(TAG, "open %s: errno %d", path, errno);
+            return false;
+        }
+        if (config[off + 2] & USB_DIR_IN) {
+            s_in_fd = fd;
+        } else {
+            s_out_fd = fd;
+        }
+    }
+    return s_in_fd >= 0;
+}
+
+static bool ns_gadget_configfs(const tinyusb_config_t *cfg, const char *root)
+{
+    const tusb_desc_device_t *dev = cfg->descriptor.device;
+    const uint8_t *config = cfg->descriptor.full_speed_config;
+    const char **str = cfg->descriptor.string;
+    int str_count = cfg->descriptor.string_count;
+    char path[512];
+
+    snprintf(s_gadget_dir, sizeof(s_gadget_dir), "%s/%s", root, s_name);
+    if (!ns_gadget_mkdir("%s", s_gadget_dir)) {
+        return false;
+    }
+    bool ok = ns_gadget_write_attr(s_gadget_dir, "idVendor", "0x%04x", dev->idVendor) &&
+              ns_gadget_write_attr(s_gadget_dir, "idProduct", "0x%04x", dev->idProduct) &&
+              ns_gadget_write_attr(s_gadget_dir, "bcdDevice", "0x%04x", dev->bcdDevice) &&
+              ns_gadget_write_attr(s_gadget_dir, "bcdUSB", "0x%04x", dev->bcdUSB) &&
+              ns_gadget_write_attr(s_gadget_dir, "bDeviceClass", "%u", dev->bDeviceClass) &&
+              ns_gadget_write_attr(s_gadget_dir, "bDeviceSubClass", "%u", dev->bDeviceSubClass) &&
+              ns_gadget_write_attr(s_gadget_dir, "bDeviceProtocol", "%u", dev->bDeviceProtocol) &&
+              ns_gadget_write_attr(s_gadget_dir, "bMaxPacketSize0", "%u", dev->bMaxPacketSize0);
+    if (!ok) {
+        return false;
+    }
+
+    snprintf(path, sizeof(path), "%s/strings/0x409", s_gadget_dir);
+    if (!ns_gadget_mkdir("%s", path)) {
+        return false;
+    }
+    if (dev->iManufacturer && dev->iManufacturer < str_count) {
+        ok &= ns_gadget_write_attr(path, "manufacturer", "%s", str[dev->iManufacturer]);
+    }
+    if (dev->iProduct && dev->iProduct < str_count) {
+        ok &= ns_gadget_write_attr(path, "product", "%s", str[dev->iProduct]);
+    }
+    if (dev->iSerialNumber && dev->iSerialNumber < str_count) {
+        ok &= ns_gadget_write_attr(path, "serialnumber", "%s", str[dev->iSerialNumber]);
+    }
+
+    snprintf(path, sizeof(path), "%s/configs/c.1", s_gadget_dir);
+    ok = ok && ns_gadget_mkdir("%s", path) &&
+         ns_gadget_write_attr(path, "bmAttributes", "0x%02x", config[7]) &&
+         ns_gadget_write_attr(path, "MaxPower", "%u", config[8] * 2u);
+    if (!ok) {
+        return false;
+    }
+
+    snprintf(path, sizeof(path), "%s/functions/ffs.%s", s_gadget_dir, s_name);
+    if (!ns_gadget_mkdir("%s", path)) {
+        return false;
+    }
+    {
+        char link[512];
+
+        snprintf(link, sizeof(link), "%s/configs/c.1/ffs.%s", s_gadget_dir, s_name);
+        if (symlink(path, link) < 0 && errno != EEXIST) {
+            ESP_LOGE(TAG, "symlink %s: errno %d", link, errno);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ns_gadget_start(const tinyusb_config_t *cfg, const ns_gadget_config_t *gcfg)
+{
+    const uint8_t *config = cfg->descriptor.full_speed_config;
+    const char *itf_string = NULL;
+    char udc[256];
+    char path[512];
+
+    snprintf(s_name, sizeof(s_name), "%s", gcfg->name ? gcfg->name : "ns_pro");
+    if (gcfg->ffs_dir) {
+        snprintf(s_ffs_dir, sizeof(s_ffs_dir), "%s", gcfg->ffs_dir);
+    } else {
+        snprintf(s_ffs_dir, sizeof(s_ffs_dir), "/dev/ffs-%s", s_name);
+    }
+    if (gcfg->udc) {
+        snprintf(udc, sizeof(udc), "%s", gcfg->udc);
+    } else if (!ns_gadget_find_udc(udc, sizeof(udc))) {
+        ESP_LOGE(TAG, "no UDC in /sys/class/udc (modprobe dummy_hcd?)");
+        return false;
+    }
+
+    /* Interface string: the descriptor's iInterface entry of the string table. */
+    for (uint16_t off = config[0]; off < (uint16_t)(config[2] | (config[3] << 8)); off += config[off]) {
+        if (config[off + 1] == USB_DT_INTERFACE) {
+            uint8_t idx = config[off + 8];
+            if (idx && idx < cfg->descriptor.string_count) {
+                itf_string = cfg->descriptor.string[idx];
+            }
+            break;
+        }
+    }
+
+    if (!ns_gadget_configfs(cfg, gcfg->configfs ? gcfg->configfs : "/sys/kernel/config/usb_gadget")) {
+        ns_gadget_stop();
+        return false;
+    }
+
+    if (!ns_gadget_mkdir("%s", s_ffs_dir)) {
+        ns_gadget_stop();
+        return false;
+    }
+    if (mount(s_name, s_ffs_dir, "functionfs", 0, NULL) < 0 && errno != EBUSY) {
+        ESP_LOGE(TAG, "mount functionfs %s: errno %d", s_ffs_dir, errno);
+        ns_gadget_stop();
+        return false;
+    }
+    s_mounted_ffs = true;
+
+    snprintf(path, sizeof(path), "%s/ep0", s_ffs_dir);
+    s_ep0_fd = open(path, O_RDWR | O_CLOEXEC);
+    if (s_ep0_fd < 0 || !ns_gadget_write_descs(config, itf_string) || !ns_gadget_write_strings(itf_string) ||
+        !ns_gadget_open_eps(config)) {
+        ESP_LOGE(TAG, "FunctionFS setup on %s failed", s_ffs_dir);
+        ns_gadget_stop();
+        return false;
+    }
+
+    s_aio_efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (s_aio_efd < 0 || ns_aio_setup(NS_GADGET_EP_MAX, &s_aio_ctx) < 0 ||
+        !ns_loop_add(s_ep0_fd, EPOLLIN, ns_gadget_ep0_ready, NULL) ||
+        !ns_loop_add(s_aio_efd, EPOLLIN, ns_gadget_aio_ready, NULL)) {
+        ESP_LOGE(TAG, "aio setup: errno %d", errno);
+        ns_gadget_stop();
+        return false;
+    }
+
+    /* Binding enumerates on the host; FUNCTIONFS_ENABLE arrives on ep0 once configured. */
+    if (!ns_gadget_write_attr(s_gadget_dir, "UDC", "%s", udc)) {
+        ns_gadget_stop();
+        return false;
+    }
+    s_bound = true;
+    ESP_LOGI(TAG, "bound to %s (%s)", udc, s_ffs_dir);
+    return true;
+}
+
+void ns_gadget_stop(void)
+{
+    char path[512];
+
+    if (s_bound) {
+        ns_gadget_write_attr(s_gadget_dir, "UDC", "\n");
+        s_bound = false;
+    }
+    s_enabled = false;
+
+    if (s_aio_ctx) {
+        ns_aio_destroy(s_aio_ctx);
+        s_aio_ctx = 0;
+    }
+    if (s_aio_efd >= 0) {
+        ns_loop_del(s_aio_efd);
+        close(s_aio_efd);
+        s_aio_efd = -1;
+    }
+    if (s_ep0_fd >= 0) {
+        ns_loop_del(s_ep0_fd);
+        close(s_ep0_fd);
+        s_ep0_fd = -1;
+    }
+    if (s_in_fd >= 0) {
+        close(s_in_fd);
+        s_in_fd = -1;
+    }
+    if (s_out_fd >= 0) {
+        close(s_out_fd);
+        s_out_fd = -1;
+    }
+    s_in.busy = false;
+    s_out_busy = false;
+
+    if (s_mounted_ffs) {
+        umount(s_ffs_dir);
+        rmdir(s_ffs_dir);
+        s_mounted_ffs = false;
+    }
+
+    /* configfs teardown runs in reverse order of creation; missing entries are fine. */
+    if (s_gadget_dir[0] != '\0') {
+        snprintf(path, sizeof(path), "%s/configs/c.1/ffs.%s", s_gadget_dir, s_name);
+        unlink(path);
+        snprintf(path, sizeof(path), "%s/functions/ffs.%s", s_gadget_dir, s_name);
+        rmdir(path);
+        snprintf(path, sizeof(path), "%s/configs/c.1", s_gadget_dir);
+        rmdir(path);
+        snprintf(path, sizeof(path), "%s/strings/0x409", s_gadget_dir);
+        rmdir(path);
+        rmdir(s_gadget_dir);
+        s_gadget_dir[0] = '\0';
+    }
+}
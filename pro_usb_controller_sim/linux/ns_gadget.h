@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tinyusb.h"
+
+/*
+ * FunctionFS gadget standing in for TinyUSB on Linux. It registers the
+ * ns_descriptors.c descriptors through configfs, answers the HID control
+ * requests on ep0 the way hid_device.c does, and pumps the interrupt IN/OUT
+ * endpoints with Linux AIO completions signalled on an eventfd in ns_loop.
+ * The tud_hid_* / tud_mounted() API the protocol engine calls and the
+ * tud_hid_*_cb callbacks it implements keep their TinyUSB meaning.
+ */
+
+typedef struct {
+    const char *name;       /* configfs gadget and FunctionFS instance, default "ns_pro" */
+    const char *udc;        /* NULL: first controller in /sys/class/udc (dummy_udc.0 with dummy_hcd) */
+    const char *configfs;   /* NULL: /sys/kernel/config/usb_gadget */
+    const char *ffs_dir;    /* NULL: /dev/ffs-<name> */
+} ns_gadget_config_t;
+
+#define NS_GADGET_HIST_BUCKET_US    10
+#define NS_GADGET_HIST_BUCKETS      2000
+
+typedef struct {
+    uint32_t buckets[NS_GADGET_HIST_BUCKETS]; /* last bucket collects everything slower */
+    uint64_t count;
+    uint64_t sum_us;
+    uint32_t max_us;
+} ns_gadget_hist_t;
+
+typedef struct {
+    uint64_t in_reports;
+    uint64_t in_bytes;
+    uint64_t in_errors;
+    uint64_t out_reports;
+    uint64_t out_bytes;
+    uint64_t setups;
+    uint64_t stalls;
+    ns_gadget_hist_t in_latency;    /* IN transfer submitted -> completed by the host poll */
+    ns_gadget_hist_t reply_latency; /* OUT / SET_REPORT received -> next queued IN report completed */
+} ns_gadget_stats_t;
+
+bool ns_gadget_start(const tinyusb_config_t *cfg, const ns_gadget_config_t *gcfg);
+void ns_gadget_stop(void);
+const ns_gadget_stats_t *ns_gadget_stats(void);
+void ns_gadget_stats_reset(void);
+uint32_t ns_gadget_hist_percentile(const ns_gadget_hist_t *hist, uint32_t permille);
@@ -0,0 +1,96 @@
+#include "ns_loop.h"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "esp_log.h"
+
+static const char *TAG = "NS_LOOP";
+
+typedef struct {
+    int fd;
+    ns_loop_cb_t cb;
+    void *arg;
+} ns_loop_handler_t;
+
+static int s_epoll_fd = -1;
+static ns_loop_handler_t s_handlers[NS_LOOP_MAX_FDS];
+static bool s_running;
+
+bool ns_loop_init(void)
+{
+    for (int i = 0; i < NS_LOOP_MAX_FDS; i++) {
+        s_handlers[i].fd = -1;
+    }
+    s_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (s_epoll_fd < 0) {
+        ESP_LOGE(TAG, "epoll_create1: errno %d", errno);
+        return false;
+    }
+    return true;
+}
+
+bool ns_loop_add(int fd, uint32_t events, ns_loop_cb_t cb, void *arg)
+{
+    for (int i = 0; i < NS_LOOP_MAX_FDS; i++) {
+        ns_loop_handler_t *h = &s_handlers[i];
+        struct epoll_event ev = {.events = events, .data.ptr = h};
+
+        if (h->fd >= 0) {
+            continue;
+        }
+        if (epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            ESP_LOGE(TAG, "epoll add fd %d: errno %d", fd, errno);
+            return false;
+        }
+        h->fd = fd;
+        h->cb = cb;
+        h->arg = arg;
+        return true;
+    }
+    ESP_LOGE(TAG, "no free handler for fd %d", fd);
+    return false;
+}
+
+void ns_loop_del(int fd)
+{
+    for (int i = 0; i < NS_LOOP_MAX_FDS; i++) {
+        if (s_handlers[i].fd == fd) {
+            epoll_ctl(s_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+            /* Events already returned for this fd in the current batch are skipped. */
+            s_handlers[i].fd = -1;
+            return;
+        }
+    }
+}
+
+void ns_loop_run(void)
+{
+    struct epoll_event events[NS_LOOP_MAX_FDS];
+
+    s_running = true;
+    while (s_running) {
+        int n = epoll_wait(s_epoll_fd, events, NS_LOOP_MAX_FDS, -1);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ESP_LOGE(TAG, "epoll_wait: errno %d", errno);
+            break;
+        }
+        for (int i = 0; i < n && s_running; i++) {
+            ns_loop_handler_t *h = events[i].data.ptr;
+
+            if (h->fd >= 0) {
+                h->cb(h->arg, events[i].events);
+            }
+        }
+    }
+}
+
+void ns_loop_stop(void)
+{
+    s_running = false;
+}
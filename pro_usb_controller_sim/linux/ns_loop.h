@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Single-threaded epoll loop of the Linux backend. The gadget endpoints, the
+ * esp_timer port, the report period timer and the signal fd all dispatch from
+ * here, so the shared ns_* modules see the same one-task world as on the ESP32.
+ */
+
+#define NS_LOOP_MAX_FDS 16
+
+typedef void (*ns_loop_cb_t)(void *arg, uint32_t events);
+
+bool ns_loop_init(void);
+bool ns_loop_add(int fd, uint32_t events, ns_loop_cb_t cb, void *arg);
+void ns_loop_del(int fd);
+void ns_loop_run(void);
+void ns_loop_stop(void);
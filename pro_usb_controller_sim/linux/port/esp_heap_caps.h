@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/* Linux port: one heap, capabilities are ignored. */
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+
+static inline void *heap_caps_malloc(size_t size, unsigned caps)
+{
+    (void)caps;
+    return malloc(size);
+}
+
+static inline void heap_caps_free(void *ptr)
+{
+    free(ptr);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+/* Linux port: ESP_LOGx lines go to stderr in the ESP-IDF console format. */
+
+#include <stdio.h>
+
+#include "esp_timer.h"
+
+#define NS_PORT_LOG(letter, tag, fmt, ...) \
+    fprintf(stderr, letter " (%lld) %s: " fmt "\n", (long long)(esp_timer_get_time() / 1000), tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, fmt, ...) NS_PORT_LOG("E", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) NS_PORT_LOG("W", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) NS_PORT_LOG("I", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) do { (void)(tag); } while (0)
+#define ESP_LOGV(tag, fmt, ...) do { (void)(tag); } while (0)
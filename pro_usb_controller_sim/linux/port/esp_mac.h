@@ -0,0 +1,5 @@
+#pragma once
+
+/* Linux port: no factory MAC; the controller address comes from ns_protocol.c defaults. */
+
+#include "esp_err.h"
@@ -0,0 +1,145 @@
+/*
+ * Linux implementations of the ESP-IDF calls the shared ns_* modules make:
+ * esp_timer on CLOCK_MONOTONIC and timerfd, heap figures from /proc/meminfo.
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "ns_loop.h"
+
+static const char *TAG = "NS_PORT";
+
+struct esp_timer {
+    int fd;
+    bool armed;
+    esp_timer_cb_t callback;
+    void *arg;
+};
+
+static struct timespec s_start;
+static uint32_t s_min_free_heap = UINT32_MAX;
+
+__attribute__((constructor)) static void esp_port_clock_init(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &s_start);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)(now.tv_sec - s_start.tv_sec) * 1000000 + (now.tv_nsec - s_start.tv_nsec) / 1000;
+}
+
+static void esp_timer_fired(void *arg, uint32_t events)
+{
+    struct esp_timer *timer = arg;
+    uint64_t expirations;
+
+    (void)events;
+    if (read(timer->fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+        /* Stopped or re-armed after the expiry was reported. */
+        return;
+    }
+    timer->armed = false;
+    timer->callback(timer->arg);
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle)
+{
+    struct esp_timer *timer;
+
+    if (args == NULL || args->callback == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    timer = calloc(1, sizeof(*timer));
+    if (timer == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    timer->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    timer->callback = args->callback;
+    timer->arg = args->arg;
+    if (timer->fd < 0 || !ns_loop_add(timer->fd, EPOLLIN, esp_timer_fired, timer)) {
+        ESP_LOGE(TAG, "timer %s: errno %d", args->name ? args->name : "?", errno);
+        if (timer->fd >= 0) {
+            close(timer->fd);
+        }
+        free(timer);
+        return ESP_FAIL;
+    }
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    struct itimerspec spec = {0};
+
+    if (timer->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    /* A zero it_value would disarm the timerfd. */
+    if (timeout_us == 0) {
+        timeout_us = 1;
+    }
+    spec.it_value.tv_sec = (time_t)(timeout_us / 1000000);
+    spec.it_value.tv_nsec = (long)(timeout_us % 1000000) * 1000;
+    if (timerfd_settime(timer->fd, 0, &spec, NULL) < 0) {
+        return ESP_FAIL;
+    }
+    timer->armed = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    struct itimerspec spec = {0};
+
+    if (!timer->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timerfd_settime(timer->fd, 0, &spec, NULL);
+    timer->armed = false;
+    return ESP_OK;
+}
+
+uint32_t esp_get_free_heap_size(void)
+{
+    FILE *f = fopen("/proc/meminfo", "r");
+    char line[128];
+    unsigned long long kb = 0;
+
+    if (f == NULL) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "MemAvailable: %llu kB", &kb) == 1) {
+            break;
+        }
+    }
+    fclose(f);
+    kb *= 1024;
+    if (kb > UINT32_MAX) {
+        kb = UINT32_MAX;
+    }
+    if (kb < s_min_free_heap) {
+        s_min_free_heap = (uint32_t)kb;
+    }
+    return (uint32_t)kb;
+}
+
+uint32_t esp_get_minimum_free_heap_size(void)
+{
+    esp_get_free_heap_size();
+    return s_min_free_heap;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/* Linux port: MemAvailable from /proc/meminfo and its lowest value seen. */
+uint32_t esp_get_free_heap_size(void);
+uint32_t esp_get_minimum_free_heap_size(void);
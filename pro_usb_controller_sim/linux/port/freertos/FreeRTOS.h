@@ -0,0 +1,23 @@
+#pragma once
+
+/*
+ * Linux port: the protocol engine, its timers and the gadget I/O all run on the
+ * single ns_loop thread, so the critical sections the shared modules take are
+ * compiled out and there is one metrics slot.
+ */
+
+#include <stdint.h>
+
+typedef struct {
+    int unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    {0}
+#define portNUM_PROCESSORS              1
+
+#define taskENTER_CRITICAL(mux)         ((void)(mux))
+#define taskEXIT_CRITICAL(mux)          ((void)(mux))
+#define taskENTER_CRITICAL_ISR(mux)     ((void)(mux))
+#define taskEXIT_CRITICAL_ISR(mux)      ((void)(mux))
+
+#define xPortGetCoreID()                0
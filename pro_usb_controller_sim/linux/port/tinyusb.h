@@ -0,0 +1,21 @@
+#pragma once
+
+/*
+ * Linux port: only the descriptor part of the esp_tinyusb configuration, which
+ * ns_descriptors_fill_tusb_config() fills and ns_gadget.c registers with FunctionFS.
+ */
+
+#include "tusb.h"
+
+typedef struct {
+    const tusb_desc_device_t *device;
+    const tusb_desc_device_qualifier_t *qualifier;
+    const char **string;
+    int string_count;
+    const uint8_t *full_speed_config;
+    const uint8_t *high_speed_config;
+} tinyusb_desc_config_t;
+
+typedef struct {
+    tinyusb_desc_config_t descriptor;
+} tinyusb_config_t;
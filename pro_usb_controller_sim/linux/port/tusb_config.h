@@ -0,0 +1,22 @@
+#ifndef _TUSB_CONFIG_H_
+#define _TUSB_CONFIG_H_
+
+/*
+ * Linux port: TinyUSB headers are used for the descriptor macros and HID types
+ * only; the USB stack itself is the kernel gadget driver behind FunctionFS.
+ */
+
+#define CFG_TUSB_MCU                OPT_MCU_NONE
+#define CFG_TUSB_OS                 OPT_OS_NONE
+#define CFG_TUSB_DEBUG              0
+
+#define TUP_DCD_ENDPOINT_MAX        8
+
+#define CFG_TUD_ENABLED             1
+#define CFG_TUD_ENDPOINT0_SIZE      64
+
+#define CFG_TUD_HID                 1
+#define CFG_TUD_HID_EP_BUFSIZE      64
+#define CFG_TUD_HID_IN_QUEUE_DEPTH  8
+
+#endif
@@ -1,10 +1,19 @@
+#include "esp_attr.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
+#include "ns_boot.h"
 #include "ns_descriptors.h"
+#include "ns_events.h"
+#include "ns_gpio_buttons.h"
+#include "ns_i2c_link.h"
+#include "ns_macro.h"
+#include "ns_metrics.h"
 #include "ns_proto.h"
 #include "ns_protocol.h"
+#include "ns_uart_link.h"
 #include "ns_wifi_control.h"
 #include "tinyusb.h"
 #include "tinyusb_default_config.h"
@@ -35,27 +44,89 @@ void tud_hid_set_report_cb(uint8_t instance,
     ns_protocol_set_report(instance, report_id, report_type, buffer, bufsize);
 }
 
+/* ISR-to-callback latency of HID IN completions: the USB ISR stamps each HID IN transfer completion
+ * it queues, the IN completion callback in the TinyUSB task measures against the latest stamp.
+ * EP0 and HID OUT completions are not stamped. Low 32 bits of the microsecond timer so the ISR
+ * store cannot tear. */
+static volatile uint32_t s_usb_xfer_posted_us;
+
+void IRAM_ATTR tud_xfer_complete_hook_cb(uint8_t rhport, uint8_t ep_addr, bool in_isr)
+{
+    (void)rhport;
+    if (in_isr && ep_addr == USB_HID_EP_IN) {
+        s_usb_xfer_posted_us = (uint32_t)esp_timer_get_time() | 1;
+    }
+}
+
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len)
+{
+    uint32_t posted = s_usb_xfer_posted_us;
+    uint32_t latency_us;
+
+    (void)instance;
+    (void)report;
+    (void)len;
+    if (posted == 0) {
+        return;
+    }
+    s_usb_xfer_posted_us = 0;
+    latency_us = (uint32_t)esp_timer_get_time() - posted;
+    ns_metrics_inc(NS_METRIC_USB_IN_COMPLETE_COUNT);
+    ns_metrics_add(NS_METRIC_USB_IN_COMPLETE_US_SUM, latency_us);
+    ns_metrics_max_gauge(NS_METRIC_GAUGE_USB_IN_COMPLETE_MAX_US, (int32_t)latency_us);
+}
+
 void app_main(void)
 {
     tinyusb_config_t tusb_cfg = TINYUSB_DEFAULT_CONFIG();
 
+    ns_boot_mark(NS_BOOT_APP_MAIN);
     ns_protocol_init();
+    ns_gpio_buttons_start();
     ns_descriptors_fill_tusb_config(&tusb_cfg);
-    ns_wifi_control_start();
 
+    /* USB first: enumeration must not wait for NVS, Wi-Fi or httpd. */
     ESP_LOGI(TAG, "Nintendo Switch Pro USB simulator init");
     ESP_LOGI(TAG, "USB VID:PID = %04X:%04X", NS_VENDOR_ID, NS_PRODUCT_ID);
     ESP_ERROR_CHECK(tinyusb_driver_install(&tusb_cfg));
+    ns_boot_mark(NS_BOOT_USB_INSTALLED);
     ESP_LOGI(TAG, "Nintendo Switch Pro USB simulator ready");
 
+    ns_wifi_control_start();
+    ns_uart_link_start();
+    ns_i2c_link_start();
+
     bool last_mounted = false;
+    int64_t last_loop_us = 0;
     while (1) {
         bool mounted = tud_mounted();
+        int64_t now = esp_timer_get_time();
+
+        if (last_loop_us != 0) {
+            int32_t period_us = (int32_t)(now - last_loop_us);
+            int32_t jitter_us = period_us - NS_STD_PERIOD_MS * 1000;
+
+            if (jitter_us < 0) {
+                jitter_us = -jitter_us;
+            }
+            ns_metrics_set_gauge(NS_METRIC_GAUGE_LOOP_PERIOD_US, period_us);
+            ns_metrics_max_gauge(NS_METRIC_GAUGE_LOOP_JITTER_MAX_US, jitter_us);
+            ns_metrics_inc(NS_METRIC_LOOP_ITERATIONS);
+            ns_metrics_add(NS_METRIC_LOOP_JITTER_US_SUM, (uint32_t)jitter_us);
+        }
+        last_loop_us = now;
+
         if (mounted != last_mounted) {
             ESP_LOGI(TAG, "tud_mounted changed: %d -> %d", (int)last_mounted, (int)mounted);
+            ns_metrics_inc(mounted ? NS_METRIC_USB_MOUNT : NS_METRIC_USB_UNMOUNT);
+            ns_events_publish(NS_EVENT_USB_MOUNT, mounted);
+            if (mounted) {
+                ns_boot_mark(NS_BOOT_USB_MOUNTED);
+            }
             last_mounted = mounted;
         }
         ns_wifi_control_periodic();
+        ns_macro_periodic();
         ns_protocol_periodic();
         vTaskDelay(pdMS_TO_TICKS(NS_STD_PERIOD_MS));
     }
@@ -0,0 +1,47 @@
+#include "ns_boot.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "NS_BOOT";
+
+static int64_t s_phase_us[NS_BOOT_PHASE_COUNT];
+
+static const char *s_phase_names[NS_BOOT_PHASE_COUNT] = {
+    [NS_BOOT_APP_MAIN] = "app_main",
+    [NS_BOOT_USB_INSTALLED] = "usb_installed",
+    [NS_BOOT_USB_MOUNTED] = "usb_mounted",
+    [NS_BOOT_USB_HANDSHAKE] = "usb_handshake",
+    [NS_BOOT_NVS_READY] = "nvs_ready",
+    [NS_BOOT_WIFI_STARTED] = "wifi_started",
+    [NS_BOOT_HTTP_READY] = "http_ready",
+    [NS_BOOT_WIFI_GOT_IP] = "wifi_got_ip",
+};
+
+void ns_boot_mark(ns_boot_phase_t phase)
+{
+    int64_t now = esp_timer_get_time();
+    int64_t unset = 0;
+
+    if (phase >= NS_BOOT_PHASE_COUNT) {
+        return;
+    }
+    /* Phases are marked from the main loop, the USB task and the Wi-Fi boot task. */
+    if (__atomic_compare_exchange_n(&s_phase_us[phase], &unset, now, false,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        ESP_LOGI(TAG, "%s at %lld us", s_phase_names[phase], (long long)now);
+    }
+}
+
+int64_t ns_boot_phase_us(ns_boot_phase_t phase)
+{
+    if (phase >= NS_BOOT_PHASE_COUNT) {
+        return 0;
+    }
+    return __atomic_load_n(&s_phase_us[phase], __ATOMIC_RELAXED);
+}
+
+const char *ns_boot_phase_name(ns_boot_phase_t phase)
+{
+    return phase < NS_BOOT_PHASE_COUNT ? s_phase_names[phase] : "unknown";
+}
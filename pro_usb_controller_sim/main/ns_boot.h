@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef enum {
+    NS_BOOT_APP_MAIN = 0,
+    NS_BOOT_USB_INSTALLED,
+    NS_BOOT_USB_MOUNTED,
+    NS_BOOT_USB_HANDSHAKE,
+    NS_BOOT_NVS_READY,
+    NS_BOOT_WIFI_STARTED,
+    NS_BOOT_HTTP_READY,
+    NS_BOOT_WIFI_GOT_IP,
+    NS_BOOT_PHASE_COUNT,
+} ns_boot_phase_t;
+
+/*
+ * Boot timeline on the esp_timer clock (time since the application started,
+ * bootloader excluded). Only the first occurrence of each phase is kept, so
+ * a later remount or reconnect does not overwrite the cold-boot numbers.
+ */
+void ns_boot_mark(ns_boot_phase_t phase);
+/* 0 while the phase has not been reached. */
+int64_t ns_boot_phase_us(ns_boot_phase_t phase);
+const char *ns_boot_phase_name(ns_boot_phase_t phase);
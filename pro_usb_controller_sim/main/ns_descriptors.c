@@ -4,7 +4,6 @@
 #include "ns_proto.h"
 
 #define USB_HID_ITF_NUM                     0
-#define USB_HID_EP_IN                       0x81
 #define USB_HID_EP_OUT                      0x01
 #define USB_HID_EP_SIZE                     64
 #define USB_HID_EP_INTERVAL                 1
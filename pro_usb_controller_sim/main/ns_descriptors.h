@@ -4,5 +4,7 @@
 
 #include "tinyusb.h"
 
+#define USB_HID_EP_IN                       0x81
+
 uint8_t const *ns_descriptors_report_map(void);
 void ns_descriptors_fill_tusb_config(tinyusb_config_t *cfg);
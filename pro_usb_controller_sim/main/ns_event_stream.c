@@ -0,0 +1,202 @@
+#include "ns_event_stream.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "ns_events.h"
+
+static const char *TAG = "NS_EVENTS";
+
+#define NS_EVENT_STREAM_TASK_STACK 4096
+#define NS_EVENT_STREAM_TASK_PRIO 3
+#define NS_EVENT_STREAM_POLL_MS 20
+#define NS_EVENT_STREAM_KEEPALIVE_US (15000000LL)
+/* Events drained per client per poll; the rest waits for the next pass. */
+#define NS_EVENT_STREAM_BATCH 16
+
+typedef struct {
+    httpd_req_t *req;
+    bool fresh;
+    uint32_t cursor;
+    int64_t last_send_us;
+} ns_event_client_t;
+
+typedef struct {
+    char buf[640];
+    size_t len;
+    bool failed;
+} ns_event_chunk_t;
+
+static portMUX_TYPE s_clients_lock = portMUX_INITIALIZER_UNLOCKED;
+static ns_event_client_t s_clients[NS_EVENT_STREAM_MAX_CLIENTS];
+static bool s_task_started;
+
+static void ns_event_chunk_flush(httpd_req_t *req, ns_event_chunk_t *chunk)
+{
+    if (chunk->len == 0 || chunk->failed) {
+        return;
+    }
+    if (httpd_resp_send_chunk(req, chunk->buf, (ssize_t)chunk->len) != ESP_OK) {
+        chunk->failed = true;
+    }
+    chunk->len = 0;
+}
+
+static void ns_event_chunk_append(httpd_req_t *req, ns_event_chunk_t *chunk, const ns_event_t *event)
+{
+    char line[128];
+    int len = snprintf(line, sizeof(line),
+                       "id: %u\nevent: %s\ndata: {\"value\":%u,\"ts_us\":%lld}\n\n",
+                       (unsigned)event->seq, ns_events_type_name(event->type),
+                       (unsigned)event->value, (long long)event->ts_us);
+
+    /* A failed client gets nothing more; the rest of this pass is dropped with it. */
+    if (chunk->failed || len <= 0 || (size_t)len >= sizeof(line)) {
+        return;
+    }
+    if (chunk->len + (size_t)len > sizeof(chunk->buf)) {
+        ns_event_chunk_flush(req, chunk);
+        if (chunk->failed || chunk->len + (size_t)len > sizeof(chunk->buf)) {
+            return;
+        }
+    }
+    memcpy(&chunk->buf[chunk->len], line, (size_t)len);
+    chunk->len += (size_t)len;
+}
+
+/* Latest value of every type; used on connect and after an overrun. */
+static void ns_event_chunk_snapshot(httpd_req_t *req, ns_event_chunk_t *chunk)
+{
+    ns_event_t event;
+
+    for (uint8_t type = 0; type < NS_EVENT_TYPE_COUNT; type++) {
+        if (ns_events_latest((ns_event_type_t)type, &event)) {
+            ns_event_chunk_append(req, chunk, &event);
+        }
+    }
+}
+
+static bool ns_event_client_service(ns_event_client_t *client, int64_t now)
+{
+    ns_event_chunk_t chunk = {0};
+    ns_event_t event;
+
+    if (client->fresh) {
+        httpd_resp_set_type(client->req, "text/event-stream");
+        httpd_resp_set_hdr(client->req, "Cache-Control", "no-cache");
+        /* Take the cursor first so nothing published during the snapshot is lost. */
+        client->cursor = ns_events_head();
+        memcpy(chunk.buf, "retry: 2000\n\n", 13);
+        chunk.len = 13;
+        ns_event_chunk_snapshot(client->req, &chunk);
+        client->fresh = false;
+    }
+
+    for (uint8_t i = 0; i < NS_EVENT_STREAM_BATCH && !chunk.failed; i++) {
+        ns_events_read_t rc = ns_events_read(&client->cursor, &event);
+
+        if (rc == NS_EVENTS_NONE) {
+            break;
+        }
+        if (rc == NS_EVENTS_OVERRUN) {
+            ns_event_chunk_snapshot(client->req, &chunk);
+            continue;
+        }
+        ns_event_chunk_append(client->req, &chunk, &event);
+    }
+
+    if (chunk.len == 0 && (now - client->last_send_us) >= NS_EVENT_STREAM_KEEPALIVE_US) {
+        memcpy(chunk.buf, ": ping\n\n", 8);
+        chunk.len = 8;
+    }
+    if (chunk.len > 0) {
+        ns_event_chunk_flush(client->req, &chunk);
+        client->last_send_us = now;
+    }
+    return !chunk.failed;
+}
+
+static void ns_event_stream_task(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        int64_t now = esp_timer_get_time();
+
+        for (uint8_t i = 0; i < NS_EVENT_STREAM_MAX_CLIENTS; i++) {
+            ns_event_client_t *client = &s_clients[i];
+            httpd_req_t *req;
+
+            taskENTER_CRITICAL(&s_clients_lock);
+            req = client->req;
+            taskEXIT_CRITICAL(&s_clients_lock);
+            if (req == NULL || ns_event_client_service(client, now)) {
+                continue;
+            }
+
+            ESP_LOGI(TAG, "event client %u disconnected", (unsigned)i);
+            httpd_req_async_handler_complete(req);
+            taskENTER_CRITICAL(&s_clients_lock);
+            client->req = NULL;
+            taskEXIT_CRITICAL(&s_clients_lock);
+        }
+        vTaskDelay(pdMS_TO_TICKS(NS_EVENT_STREAM_POLL_MS));
+    }
+}
+
+void ns_event_stream_start(void)
+{
+    if (s_task_started) {
+        return;
+    }
+    if (xTaskCreate(ns_event_stream_task, "ns_events", NS_EVENT_STREAM_TASK_STACK,
+                    NULL, NS_EVENT_STREAM_TASK_PRIO, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "create event stream task failed");
+        return;
+    }
+    s_task_started = true;
+}
+
+esp_err_t ns_event_stream_handler(httpd_req_t *req)
+{
+    ns_event_client_t *client = NULL;
+    httpd_req_t *async_req = NULL;
+
+    taskENTER_CRITICAL(&s_clients_lock);
+    for (uint8_t i = 0; i < NS_EVENT_STREAM_MAX_CLIENTS; i++) {
+        if (s_clients[i].req == NULL && !s_clients[i].fresh) {
+            client = &s_clients[i];
+            /* Reserve the slot until the async request is attached. */
+            client->fresh = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&s_clients_lock);
+
+    if (!s_task_started || client == NULL) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_sendstr(req, "{\"ok\":false,\"error\":\"too many event clients\"}");
+        return ESP_OK;
+    }
+
+    if (httpd_req_async_handler_begin(req, &async_req) != ESP_OK) {
+        taskENTER_CRITICAL(&s_clients_lock);
+        client->fresh = false;
+        taskEXIT_CRITICAL(&s_clients_lock);
+        return ESP_FAIL;
+    }
+
+    client->last_send_us = esp_timer_get_time();
+    taskENTER_CRITICAL(&s_clients_lock);
+    client->req = async_req;
+    taskEXIT_CRITICAL(&s_clients_lock);
+    ESP_LOGI(TAG, "event client connected");
+    return ESP_OK;
+}
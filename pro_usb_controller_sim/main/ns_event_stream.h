@@ -0,0 +1,14 @@
+#pragma once
+
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+#define NS_EVENT_STREAM_MAX_CLIENTS 3
+
+/*
+ * GET /events handler. The request is detached from the HTTP server task and
+ * served as a Server-Sent Events stream by a dedicated task, so other
+ * endpoints keep working while clients stay connected.
+ */
+void ns_event_stream_start(void);
+esp_err_t ns_event_stream_handler(httpd_req_t *req);
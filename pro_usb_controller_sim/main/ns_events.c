@@ -0,0 +1,133 @@
+#include "ns_events.h"
+
+#include "esp_timer.h"
+
+#define NS_EVENTS_RING_MASK (NS_EVENTS_RING_SIZE - 1U)
+
+_Static_assert((NS_EVENTS_RING_SIZE & (NS_EVENTS_RING_SIZE - 1)) == 0, "ring size must be a power of two");
+
+static ns_event_t s_ring[NS_EVENTS_RING_SIZE];
+static uint32_t s_head_seq;
+/* Latest event per type; seq 0 means that type was never published. */
+static ns_event_t s_latest[NS_EVENT_TYPE_COUNT];
+
+static const char *s_type_names[NS_EVENT_TYPE_COUNT] = {
+    [NS_EVENT_USB_MOUNT] = "usb_mount",
+    [NS_EVENT_HANDSHAKE] = "handshake",
+    [NS_EVENT_REPORT_MODE] = "report_mode",
+    [NS_EVENT_PLAYER_LIGHTS] = "player_lights",
+    [NS_EVENT_IMU_ENABLE] = "imu_enable",
+    [NS_EVENT_VIBRATION_ENABLE] = "vibration_enable",
+};
+
+/*
+ * Entries are written seqlock style: seq is zeroed, the payload stored, then
+ * seq published with release order. A reader copies the entry and accepts it
+ * only if seq matched before and after the copy.
+ */
+static void ns_events_store(ns_event_t *slot, uint32_t seq, uint8_t type, uint32_t value, int64_t ts_us)
+{
+    __atomic_store_n(&slot->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot->type = type;
+    slot->value = value;
+    slot->ts_us = ts_us;
+    __atomic_store_n(&slot->seq, seq, __ATOMIC_RELEASE);
+}
+
+static bool ns_events_load(const ns_event_t *slot, uint32_t seq, ns_event_t *out)
+{
+    if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != seq) {
+        return false;
+    }
+    out->type = slot->type;
+    out->value = slot->value;
+    out->ts_us = slot->ts_us;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq) {
+        return false;
+    }
+    out->seq = seq;
+    return true;
+}
+
+void ns_events_publish(ns_event_type_t type, uint32_t value)
+{
+    int64_t now = esp_timer_get_time();
+    uint32_t seq;
+
+    if (type >= NS_EVENT_TYPE_COUNT) {
+        return;
+    }
+
+    seq = __atomic_add_fetch(&s_head_seq, 1U, __ATOMIC_ACQ_REL);
+    if (seq == 0) {
+        /* 0 marks an entry being written; skip it on wrap. */
+        seq = __atomic_add_fetch(&s_head_seq, 1U, __ATOMIC_ACQ_REL);
+    }
+    ns_events_store(&s_latest[type], seq, (uint8_t)type, value, now);
+    ns_events_store(&s_ring[seq & NS_EVENTS_RING_MASK], seq, (uint8_t)type, value, now);
+}
+
+void ns_events_publish_changed(ns_event_type_t type, uint32_t value)
+{
+    ns_event_t latest;
+
+    if (ns_events_latest(type, &latest) && latest.value == value) {
+        return;
+    }
+    ns_events_publish(type, value);
+}
+
+ns_events_read_t ns_events_read(uint32_t *cursor, ns_event_t *out)
+{
+    uint32_t head = __atomic_load_n(&s_head_seq, __ATOMIC_ACQUIRE);
+    uint32_t next = *cursor + 1U;
+
+    if (*cursor == head) {
+        return NS_EVENTS_NONE;
+    }
+    if ((uint32_t)(head - *cursor) > NS_EVENTS_RING_SIZE) {
+        *cursor = head;
+        return NS_EVENTS_OVERRUN;
+    }
+    if (next == 0) {
+        next++;
+    }
+    if (!ns_events_load(&s_ring[next & NS_EVENTS_RING_MASK], next, out)) {
+        /* Either still being written or already overwritten by a lap. */
+        if ((uint32_t)(__atomic_load_n(&s_head_seq, __ATOMIC_ACQUIRE) - *cursor) > NS_EVENTS_RING_SIZE) {
+            *cursor = __atomic_load_n(&s_head_seq, __ATOMIC_ACQUIRE);
+            return NS_EVENTS_OVERRUN;
+        }
+        return NS_EVENTS_NONE;
+    }
+    *cursor = next;
+    return NS_EVENTS_OK;
+}
+
+uint32_t ns_events_head(void)
+{
+    return __atomic_load_n(&s_head_seq, __ATOMIC_ACQUIRE);
+}
+
+bool ns_events_latest(ns_event_type_t type, ns_event_t *out)
+{
+    uint32_t seq;
+
+    if (type >= NS_EVENT_TYPE_COUNT) {
+        return false;
+    }
+    for (uint8_t attempt = 0; attempt < 4; attempt++) {
+        seq = __atomic_load_n(&s_latest[type].seq, __ATOMIC_ACQUIRE);
+        if (seq != 0 && ns_events_load(&s_latest[type], seq, out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *ns_events_type_name(uint8_t type)
+{
+    return type < NS_EVENT_TYPE_COUNT ? s_type_names[type] : "unknown";
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NS_EVENTS_RING_SIZE 64
+
+typedef enum {
+    NS_EVENT_USB_MOUNT = 0,
+    NS_EVENT_HANDSHAKE,
+    NS_EVENT_REPORT_MODE,
+    NS_EVENT_PLAYER_LIGHTS,
+    NS_EVENT_IMU_ENABLE,
+    NS_EVENT_VIBRATION_ENABLE,
+    NS_EVENT_TYPE_COUNT,
+} ns_event_type_t;
+
+typedef struct {
+    uint32_t seq;
+    uint8_t type;
+    uint32_t value;
+    int64_t ts_us;
+} ns_event_t;
+
+typedef enum {
+    NS_EVENTS_NONE = 0,
+    NS_EVENTS_OK,
+    /* Reader fell a full ring behind; resync from ns_events_latest(). */
+    NS_EVENTS_OVERRUN,
+} ns_events_read_t;
+
+/*
+ * Host-visible session events. Publishers never wait: the ring overwrites
+ * the oldest entry and every reader keeps its own cursor, so slow consumers
+ * only lose history and catch up through the latest value of each type.
+ */
+void ns_events_publish(ns_event_type_t type, uint32_t value);
+/* Publishes only when the value differs from the latest one of that type. */
+void ns_events_publish_changed(ns_event_type_t type, uint32_t value);
+ns_events_read_t ns_events_read(uint32_t *cursor, ns_event_t *out);
+/* Current sequence; a new reader starts here after taking a snapshot. */
+uint32_t ns_events_head(void);
+bool ns_events_latest(ns_event_type_t type, ns_event_t *out);
+const char *ns_events_type_name(uint8_t type);
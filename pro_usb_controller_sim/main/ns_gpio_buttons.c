@@ -0,0 +1,507 @@
+#include "ns_gpio_buttons.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "driver/gpio.h"
+#include "driver/gptimer.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "ns_input_layer.h"
+#include "ns_metrics.h"
+#include "ns_protocol.h"
+
+static const char *TAG = "NS_GPIO_BTN";
+
+/*
+ * Build-time layout, e.g. from main/CMakeLists.txt:
+ *   target_compile_definitions(${COMPONENT_LIB} PRIVATE NS_GPIO_BUTTONS_LAYOUT=1)
+ * BOOT (GPIO0) is always key 0. Pins avoid I2C (8/9), UART (17/18), USB (19/20),
+ * flash (26-32), the provisioning key (35), the console (43/44) and the straps.
+ */
+#define NS_GPIO_LAYOUT_BOOT_ONLY 0
+#define NS_GPIO_LAYOUT_DIRECT    1
+#define NS_GPIO_LAYOUT_MATRIX    2
+
+#ifndef NS_GPIO_BUTTONS_LAYOUT
+#define NS_GPIO_BUTTONS_LAYOUT NS_GPIO_LAYOUT_BOOT_ONLY
+#endif
+
+/* The first edge is taken at once; the key is sampled again only after this long. */
+#define NS_GPIO_DEBOUNCE_MS       5
+#define NS_GPIO_TICK_US           1000
+/* Row to column propagation before the columns are read. */
+#define NS_GPIO_MATRIX_SETTLE_US  2
+#define NS_GPIO_TASK_STACK        3072
+#define NS_GPIO_TASK_PRIO         10
+#define NS_GPIO_TRIGGER_KEY       0
+
+typedef struct {
+    gpio_num_t pin;
+    /* NS_BUTTON_NONE: read but not sent to the controller */
+    ns_button_id_t button;
+} ns_gpio_direct_key_t;
+
+static const ns_gpio_direct_key_t s_direct_keys[] = {
+    /* Most ESP32-S3 dev boards expose BOOT on GPIO0 (active low). */
+    {GPIO_NUM_0, NS_BUTTON_NONE},
+#if NS_GPIO_BUTTONS_LAYOUT == NS_GPIO_LAYOUT_DIRECT
+    {GPIO_NUM_1, NS_BUTTON_Y},
+    {GPIO_NUM_2, NS_BUTTON_X},
+    {GPIO_NUM_4, NS_BUTTON_B},
+    {GPIO_NUM_5, NS_BUTTON_A},
+    {GPIO_NUM_6, NS_BUTTON_L},
+    {GPIO_NUM_7, NS_BUTTON_R},
+    {GPIO_NUM_10, NS_BUTTON_ZL},
+    {GPIO_NUM_11, NS_BUTTON_ZR},
+    {GPIO_NUM_12, NS_BUTTON_MINUS},
+    {GPIO_NUM_13, NS_BUTTON_PLUS},
+    {GPIO_NUM_14, NS_BUTTON_L_STICK},
+    {GPIO_NUM_15, NS_BUTTON_R_STICK},
+    {GPIO_NUM_16, NS_BUTTON_HOME},
+    {GPIO_NUM_21, NS_BUTTON_CAPTURE},
+    {GPIO_NUM_38, NS_BUTTON_UP},
+    {GPIO_NUM_39, NS_BUTTON_DOWN},
+    {GPIO_NUM_40, NS_BUTTON_LEFT},
+    {GPIO_NUM_41, NS_BUTTON_RIGHT},
+#endif
+};
+
+#define NS_GPIO_DIRECT_COUNT (sizeof(s_direct_keys) / sizeof(s_direct_keys[0]))
+
+#if NS_GPIO_BUTTONS_LAYOUT == NS_GPIO_LAYOUT_MATRIX
+/*
+ * Rows are open-drain outputs, columns inputs with pull-ups; a key joins its
+ * row and column. Put a diode in series with each key (anode on the column) if
+ * three keys on a rectangle may be held together, or a fourth shows up.
+ */
+static const gpio_num_t s_matrix_rows[] = {GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_4};
+static const gpio_num_t s_matrix_cols[] = {GPIO_NUM_5, GPIO_NUM_6, GPIO_NUM_7,
+                                           GPIO_NUM_10, GPIO_NUM_11, GPIO_NUM_12};
+/* Row-major: key (row, col) is s_matrix_buttons[row * NS_GPIO_MATRIX_COLS + col]. */
+static const ns_button_id_t s_matrix_buttons[] = {
+    NS_BUTTON_Y, NS_BUTTON_X, NS_BUTTON_B, NS_BUTTON_A, NS_BUTTON_L, NS_BUTTON_R,
+    NS_BUTTON_ZL, NS_BUTTON_ZR, NS_BUTTON_MINUS, NS_BUTTON_PLUS, NS_BUTTON_L_STICK, NS_BUTTON_R_STICK,
+    NS_BUTTON_HOME, NS_BUTTON_CAPTURE, NS_BUTTON_UP, NS_BUTTON_DOWN, NS_BUTTON_LEFT, NS_BUTTON_RIGHT,
+};
+
+#define NS_GPIO_MATRIX_ROWS (sizeof(s_matrix_rows) / sizeof(s_matrix_rows[0]))
+#define NS_GPIO_MATRIX_COLS (sizeof(s_matrix_cols) / sizeof(s_matrix_cols[0]))
+_Static_assert(sizeof(s_matrix_buttons) / sizeof(s_matrix_buttons[0]) == NS_GPIO_MATRIX_ROWS * NS_GPIO_MATRIX_COLS,
+               "one button per matrix key");
+#else
+#define NS_GPIO_MATRIX_ROWS 0U
+#define NS_GPIO_MATRIX_COLS 0U
+#endif
+
+#define NS_GPIO_KEY_COUNT (NS_GPIO_DIRECT_COUNT + NS_GPIO_MATRIX_ROWS * NS_GPIO_MATRIX_COLS)
+#define NS_GPIO_MATRIX_KEYS (((NS_GPIO_KEY_COUNT < 32) ? (1U << NS_GPIO_KEY_COUNT) : 0U) - \
+                             (1U << NS_GPIO_DIRECT_COUNT))
+_Static_assert(NS_GPIO_KEY_COUNT <= 32, "key masks are 32 bits");
+
+/*
+ * Per-key debounce state machine, all of it under s_lock:
+ *   idle      s_settle[key] == 0; a direct key has its edge interrupt armed,
+ *             a matrix key is compared with every scan.
+ *   settling  s_settle[key] ticks left; the pin is not looked at. When it
+ *             reaches 0 the key is sampled once more: a new level is taken
+ *             and settles again, the same level makes the key idle.
+ * A press is therefore reported on its first edge, and a release the same way;
+ * contact bounce shorter than NS_GPIO_DEBOUNCE_MS is never seen.
+ */
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t s_stable;
+/* Last mask sent to the task, under s_lock. */
+static uint32_t s_buttons;
+static uint32_t s_key_buttons[NS_GPIO_KEY_COUNT];
+static uint8_t s_settle[NS_GPIO_KEY_COUNT];
+static uint32_t s_settling;
+static bool s_scanning;
+static bool s_timer_running;
+/* Low 32 bits of esp_timer time of the last accepted change, for the publish latency. */
+static volatile uint32_t s_changed_us;
+static gptimer_handle_t s_timer;
+static TaskHandle_t s_task;
+static bool s_started;
+
+static void ns_gpio_accept_locked(uint8_t key, bool pressed)
+{
+    uint32_t bit = 1U << key;
+
+    s_stable = pressed ? (s_stable | bit) : (s_stable & ~bit);
+    s_settle[key] = NS_GPIO_DEBOUNCE_MS * 1000 / NS_GPIO_TICK_US;
+    s_settling |= bit;
+    s_changed_us = (uint32_t)esp_timer_get_time();
+    ns_metrics_inc(NS_METRIC_GPIO_CHANGES);
+}
+
+static bool ns_gpio_direct_pressed(uint8_t key)
+{
+    return gpio_get_level(s_direct_keys[key].pin) == 0;
+}
+
+#if NS_GPIO_BUTTONS_LAYOUT == NS_GPIO_LAYOUT_MATRIX
+/* Raw matrix keys, bit per key index; leaves every row released. */
+static uint32_t ns_gpio_matrix_scan(void)
+{
+    uint32_t raw = 0;
+
+    for (size_t row = 0; row < NS_GPIO_MATRIX_ROWS; row++) {
+        gpio_set_level(s_matrix_rows[row], 1);
+    }
+    for (size_t row = 0; row < NS_GPIO_MATRIX_ROWS; row++) {
+        gpio_set_level(s_matrix_rows[row], 0);
+        esp_rom_delay_us(NS_GPIO_MATRIX_SETTLE_US);
+        for (size_t col = 0; col < NS_GPIO_MATRIX_COLS; col++) {
+            if (gpio_get_level(s_matrix_cols[col]) == 0) {
+                raw |= 1U << (NS_GPIO_DIRECT_COUNT + row * NS_GPIO_MATRIX_COLS + col);
+            }
+        }
+        gpio_set_level(s_matrix_rows[row], 1);
+    }
+    return raw;
+}
+
+/* All rows low and column edges armed, so any press interrupts; false if one is already down. */
+static bool ns_gpio_matrix_arm(void)
+{
+    for (size_t row = 0; row < NS_GPIO_MATRIX_ROWS; row++) {
+        gpio_set_level(s_matrix_rows[row], 0);
+    }
+    esp_rom_delay_us(NS_GPIO_MATRIX_SETTLE_US);
+    for (size_t col = 0; col < NS_GPIO_MATRIX_COLS; col++) {
+        gpio_intr_enable(s_matrix_cols[col]);
+    }
+    for (size_t col = 0; col < NS_GPIO_MATRIX_COLS; col++) {
+        if (gpio_get_level(s_matrix_cols[col]) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void ns_gpio_matrix_disarm(void)
+{
+    for (size_t col = 0; col < NS_GPIO_MATRIX_COLS; col++) {
+        gpio_intr_disable(s_matrix_cols[col]);
+    }
+}
+#endif
+
+/* Runs the debounce state machines; tick is false when called from an edge rather than the timer. */
+static void ns_gpio_service_locked(bool tick)
+{
+    uint32_t settling = tick ? s_settling : 0;
+    uint32_t raw = 0;
+
+#if NS_GPIO_BUTTONS_LAYOUT == NS_GPIO_LAYOUT_MATRIX
+    if (s_scanning) {
+        raw = ns_gpio_matrix_scan();
+    }
+#endif
+
+    for (uint8_t key = 0; key < NS_GPIO_KEY_COUNT; key++) {
+        uint32_t bit = 1U << key;
+        bool matrix = key >= NS_GPIO_DIRECT_COUNT;
+        bool pressed;
+
+        if ((settling & bit) == 0 || --s_settle[key] != 0) {
+            continue;
+        }
+        s_settling &= ~bit;
+        pressed = matrix ? (raw & bit) != 0 : ns_gpio_direct_pressed(key);
+        if (pressed != ((s_stable & bit) != 0)) {
+            /* Changed again while settling: bounce longer than the debounce time, or a quick tap */
+            ns_gpio_accept_locked(key, pressed);
+            ns_metrics_inc(NS_METRIC_GPIO_BOUNCES);
+        } else if (!matrix) {
+            gpio_intr_enable(s_direct_keys[key].pin);
+            /* An edge between the sample and the re-arm would otherwise be lost */
+            if (ns_gpio_direct_pressed(key) != pressed) {
+                gpio_intr_disable(s_direct_keys[key].pin);
+                ns_gpio_accept_locked(key, !pressed);
+            }
+        }
+    }
+
+    if (s_scanning) {
+        uint32_t idle = NS_GPIO_MATRIX_KEYS & ~s_settling;
+
+        for (uint8_t key = NS_GPIO_DIRECT_COUNT; key < NS_GPIO_KEY_COUNT; key++) {
+            uint32_t bit = 1U << key;
+
+            if ((idle & bit) != 0 && ((raw ^ s_stable) & bit) != 0) {
+                ns_gpio_accept_locked(key, (raw & bit) != 0);
+            }
+        }
+#if NS_GPIO_BUTTONS_LAYOUT == NS_GPIO_LAYOUT_MATRIX
+        /* Keep scanning while a key is held: its column stays low and hides other presses */
+        if ((s_stable & NS_GPIO_MATRIX_KEYS) == 0 && (s_settling & NS_GPIO_MATRIX_KEYS) == 0 &&
+            ns_gpio_matrix_arm()) {
+            s_scanning = false;
+        } else {
+            ns_gpio_matrix_disarm();
+        }
+#endif
+    }
+}
+
+/* The timer only runs while a key settles or the matrix is scanned. */
+static void ns_gpio_timer_update_locked(void)
+{
+    bool run = s_settling != 0 || s_scanning;
+
+    if (run == s_timer_running) {
+        return;
+    }
+    if (run) {
+        gptimer_set_raw_count(s_timer, 0);
+        gptimer_start(s_timer);
+    } else {
+        gptimer_stop(s_timer);
+    }
+    s_timer_running = run;
+}
+
+/* Mapped button mask; true when it differs from what was last handed to the task. */
+static bool ns_gpio_buttons_changed_locked(uint32_t *out)
+{
+    uint32_t buttons = 0;
+
+    for (uint8_t key = 0; key < NS_GPIO_KEY_COUNT; key++) {
+        if (s_stable & (1U << key)) {
+            buttons |= s_key_buttons[key];
+        }
+    }
+    if (buttons == s_buttons) {
+        return false;
+    }
+    s_buttons = buttons;
+    *out = buttons;
+    return true;
+}
+
+static void ns_gpio_notify_from_isr(bool changed, uint32_t buttons)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (!changed) {
+        return;
+    }
+    xTaskNotifyFromISR(s_task, buttons, eSetValueWithOverwrite, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void ns_gpio_direct_isr(void *arg)
+{
+    uint8_t key = (uint8_t)(uintptr_t)arg;
+    uint32_t buttons = 0;
+    bool changed;
+    bool pressed;
+
+    portENTER_CRITICAL_ISR(&s_lock);
+    pressed = ns_gpio_direct_pressed(key);
+    /* Settling keys have their interrupt off; a level back at the stable one was a glitch */
+    if ((s_settling & (1U << key)) == 0 && pressed != ((s_stable & (1U << key)) != 0)) {
+        gpio_intr_disable(s_direct_keys[key].pin);
+        ns_gpio_accept_locked(key, pressed);
+        ns_gpio_timer_update_locked();
+    }
+    changed = ns_gpio_buttons_changed_locked(&buttons);
+    portEXIT_CRITICAL_ISR(&s_lock);
+    ns_gpio_notify_from_isr(changed, buttons);
+}
+
+#if NS_GPIO_BUTTONS_LAYOUT == NS_GPIO_LAYOUT_MATRIX
+static void ns_gpio_column_isr(void *arg)
+{
+    uint32_t buttons = 0;
+    bool changed;
+
+    (void)arg;
+    portENTER_CRITICAL_ISR(&s_lock);
+    if (!s_scanning) {
+        ns_gpio_matrix_disarm();
+        s_scanning = true;
+        /* Scan right away instead of on the next tick: capture latency is the ISR latency */
+        ns_gpio_service_locked(false);
+        ns_gpio_timer_update_locked();
+    }
+    changed = ns_gpio_buttons_changed_locked(&buttons);
+    portEXIT_CRITICAL_ISR(&s_lock);
+    ns_gpio_notify_from_isr(changed, buttons);
+}
+#endif
+
+static bool ns_gpio_on_tick(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *ctx)
+{
+    BaseType_t woken = pdFALSE;
+    uint32_t buttons = 0;
+    bool changed;
+
+    (void)timer;
+    (void)edata;
+    (void)ctx;
+    portENTER_CRITICAL_ISR(&s_lock);
+    ns_gpio_service_locked(true);
+    ns_gpio_timer_update_locked();
+    changed = ns_gpio_buttons_changed_locked(&buttons);
+    portEXIT_CRITICAL_ISR(&s_lock);
+    if (changed) {
+        xTaskNotifyFromISR(s_task, buttons, eSetValueWithOverwrite, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+/* Moves the mask from interrupt context into the input layer, which takes a task-level lock. */
+static void ns_gpio_buttons_task(void *arg)
+{
+    uint32_t buttons;
+
+    (void)arg;
+    while (1) {
+        xTaskNotifyWait(0, 0, &buttons, portMAX_DELAY);
+        ns_metrics_inc(NS_METRIC_GPIO_PUBLISHES);
+        ns_metrics_add(NS_METRIC_GPIO_PUBLISH_US_SUM, (uint32_t)esp_timer_get_time() - s_changed_us);
+        if (buttons != 0) {
+            ns_input_layer_set_buttons(NS_INPUT_LAYER_GPIO, buttons, 0);
+        } else {
+            ns_input_layer_clear(NS_INPUT_LAYER_GPIO);
+        }
+        ESP_LOGD(TAG, "buttons 0x%05" PRIx32, buttons);
+    }
+}
+
+static void ns_gpio_timer_init(void)
+{
+    const gptimer_config_t config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,
+    };
+    const gptimer_alarm_config_t alarm = {
+        .alarm_count = NS_GPIO_TICK_US,
+        .reload_count = 0,
+        .flags.auto_reload_on_alarm = true,
+    };
+    const gptimer_event_callbacks_t callbacks = {
+        .on_alarm = ns_gpio_on_tick,
+    };
+
+    ESP_ERROR_CHECK(gptimer_new_timer(&config, &s_timer));
+    ESP_ERROR_CHECK(gptimer_register_event_callbacks(s_timer, &callbacks, NULL));
+    ESP_ERROR_CHECK(gptimer_set_alarm_action(s_timer, &alarm));
+    ESP_ERROR_CHECK(gptimer_enable(s_timer));
+}
+
+void ns_gpio_buttons_start(void)
+{
+    gpio_config_t direct = {
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+    uint32_t buttons = 0;
+    bool changed;
+    esp_err_t err;
+
+    if (s_started) {
+        return;
+    }
+
+    for (uint8_t key = 0; key < NS_GPIO_DIRECT_COUNT; key++) {
+        direct.pin_bit_mask |= 1ULL << s_direct_keys[key].pin;
+        if (s_direct_keys[key].button != NS_BUTTON_NONE) {
+            s_key_buttons[key] = NS_BUTTON_MASK(s_direct_keys[key].button);
+        }
+    }
+#if NS_GPIO_BUTTONS_LAYOUT == NS_GPIO_LAYOUT_MATRIX
+    for (uint8_t key = 0; key < NS_GPIO_MATRIX_ROWS * NS_GPIO_MATRIX_COLS; key++) {
+        s_key_buttons[NS_GPIO_DIRECT_COUNT + key] = NS_BUTTON_MASK(s_matrix_buttons[key]);
+    }
+#endif
+
+    /* Checked before the task and timer exist, so a failed start leaves nothing behind. */
+    err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "gpio isr service: %s", esp_err_to_name(err));
+        return;
+    }
+    if (xTaskCreate(ns_gpio_buttons_task, "ns_gpio_btn", NS_GPIO_TASK_STACK, NULL, NS_GPIO_TASK_PRIO,
+                    &s_task) != pdPASS) {
+        ESP_LOGE(TAG, "gpio button task create failed");
+        return;
+    }
+    ns_gpio_timer_init();
+
+    ESP_ERROR_CHECK(gpio_config(&direct));
+    portENTER_CRITICAL(&s_lock);
+    for (uint8_t key = 0; key < NS_GPIO_DIRECT_COUNT; key++) {
+        if (ns_gpio_direct_pressed(key)) {
+            s_stable |= 1U << key;
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+    for (uint8_t key = 0; key < NS_GPIO_DIRECT_COUNT; key++) {
+        ESP_ERROR_CHECK(gpio_isr_handler_add(s_direct_keys[key].pin, ns_gpio_direct_isr,
+                                             (void *)(uintptr_t)key));
+    }
+
+#if NS_GPIO_BUTTONS_LAYOUT == NS_GPIO_LAYOUT_MATRIX
+    gpio_config_t rows = {
+        .mode = GPIO_MODE_INPUT_OUTPUT_OD,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE,
+    };
+    gpio_config_t cols = {
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_NEGEDGE,
+    };
+
+    for (size_t row = 0; row < NS_GPIO_MATRIX_ROWS; row++) {
+        rows.pin_bit_mask |= 1ULL << s_matrix_rows[row];
+    }
+    for (size_t col = 0; col < NS_GPIO_MATRIX_COLS; col++) {
+        cols.pin_bit_mask |= 1ULL << s_matrix_cols[col];
+    }
+    ESP_ERROR_CHECK(gpio_config(&rows));
+    ESP_ERROR_CHECK(gpio_config(&cols));
+    for (size_t col = 0; col < NS_GPIO_MATRIX_COLS; col++) {
+        ESP_ERROR_CHECK(gpio_isr_handler_add(s_matrix_cols[col], ns_gpio_column_isr, NULL));
+    }
+    portENTER_CRITICAL(&s_lock);
+    if (!ns_gpio_matrix_arm()) {
+        /* Held at boot: scan from the start */
+        ns_gpio_matrix_disarm();
+        s_scanning = true;
+        ns_gpio_service_locked(false);
+        ns_gpio_timer_update_locked();
+    }
+    portEXIT_CRITICAL(&s_lock);
+#endif
+
+    portENTER_CRITICAL(&s_lock);
+    changed = ns_gpio_buttons_changed_locked(&buttons);
+    portEXIT_CRITICAL(&s_lock);
+    if (changed) {
+        xTaskNotify(s_task, buttons, eSetValueWithOverwrite);
+    }
+    s_started = true;
+    ESP_LOGI(TAG, "gpio buttons: %u direct, %ux%u matrix, debounce %d ms", (unsigned)NS_GPIO_DIRECT_COUNT,
+             (unsigned)NS_GPIO_MATRIX_ROWS, (unsigned)NS_GPIO_MATRIX_COLS, NS_GPIO_DEBOUNCE_MS);
+}
+
+bool ns_gpio_buttons_trigger_pressed(void)
+{
+    return (s_stable & (1U << NS_GPIO_TRIGGER_KEY)) != 0;
+}
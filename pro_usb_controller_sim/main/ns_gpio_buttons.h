@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdbool.h>
+
+/*
+ * Physical buttons: direct pins (one per key, active low) and optionally a
+ * scanned row/column matrix, up to all 18 controller buttons. Pin edges raise
+ * an interrupt, the new level is taken at once, and a per-key debounce state
+ * machine run from a 1 ms hardware timer ignores the bounce that follows.
+ * The debounced mask goes to the "gpio" input layer, so the report path never
+ * reads a pin. The layout is chosen at build time, see ns_gpio_buttons.c.
+ */
+void ns_gpio_buttons_start(void);
+
+/* Debounced BOOT key (GPIO0), which starts the auto key test. */
+bool ns_gpio_buttons_trigger_pressed(void);
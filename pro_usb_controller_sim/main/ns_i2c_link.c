@@ -0,0 +1,256 @@
+#include "ns_i2c_link.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "driver/i2c_slave.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "hal/i2c_ll.h"
+#include "soc/soc_caps.h"
+
+#include "ns_input_layer.h"
+#include "ns_metrics.h"
+#include "ns_proto.h"
+
+static const char *TAG = "NS_I2C_LINK";
+
+#define NS_I2C_LINK_PORT I2C_NUM_0
+#define NS_I2C_LINK_SDA_GPIO 8
+#define NS_I2C_LINK_SCL_GPIO 9
+#define NS_I2C_LINK_BUF_DEPTH 128
+#define NS_I2C_LINK_QUEUE_LEN 8
+#define NS_I2C_LINK_TASK_STACK 3072
+#define NS_I2C_LINK_TASK_PRIO 6
+#define NS_I2C_LINK_WRITE_TIMEOUT_MS 10
+#define NS_I2C_LINK_DEFAULT_LEASE_MS 500
+
+/* A read reply must sit in the hardware FIFO alone: the RX ISR empties it, not the driver's ring buffer. */
+_Static_assert(NS_I2C_REG_COUNT - NS_I2C_STATUS_BLOCK_END <= SOC_I2C_FIFO_LEN, "frame block exceeds the TX FIFO");
+
+/* One write transaction ([reg, data...]); length 0 marks a read request. */
+typedef struct {
+    uint8_t len;
+    uint8_t data[NS_I2C_REG_COUNT + 1];
+} ns_i2c_link_event_t;
+
+static i2c_slave_dev_handle_t s_slave;
+static QueueHandle_t s_event_queue;
+static bool s_started;
+
+/* Only the link task touches these. */
+static uint8_t s_regs[NS_I2C_REG_COUNT];
+static uint8_t s_reg_ptr;
+
+static uint16_t ns_i2c_rd_u16(uint8_t reg)
+{
+    return (uint16_t)(s_regs[reg] | ((uint16_t)s_regs[reg + 1] << 8));
+}
+
+static void ns_i2c_wr_u16(uint8_t reg, uint16_t value)
+{
+    s_regs[reg] = (uint8_t)value;
+    s_regs[reg + 1] = (uint8_t)(value >> 8);
+}
+
+static void ns_i2c_clear_shadow(void)
+{
+    memset(&s_regs[NS_I2C_REG_BUTTONS], 0, NS_I2C_REG_COUNT - NS_I2C_REG_BUTTONS);
+    ns_i2c_wr_u16(NS_I2C_REG_LX, NS_STICK_CENTER);
+    ns_i2c_wr_u16(NS_I2C_REG_LY, NS_STICK_CENTER);
+    ns_i2c_wr_u16(NS_I2C_REG_RX, NS_STICK_CENTER);
+    ns_i2c_wr_u16(NS_I2C_REG_RY, NS_STICK_CENTER);
+    ns_i2c_wr_u16(NS_I2C_REG_LEASE_MS, NS_I2C_LINK_DEFAULT_LEASE_MS);
+    s_regs[NS_I2C_REG_STATUS] &= (uint8_t)~NS_I2C_STATUS_DIRTY;
+}
+
+static void ns_i2c_commit(void)
+{
+    ns_input_state_t input = {0};
+
+    input.buttons = ((uint32_t)ns_i2c_rd_u16(NS_I2C_REG_BUTTONS) |
+                     ((uint32_t)ns_i2c_rd_u16(NS_I2C_REG_BUTTONS + 2) << 16)) & NS_BUTTON_MASK_ALL;
+    input.lx = ns_i2c_rd_u16(NS_I2C_REG_LX);
+    input.ly = ns_i2c_rd_u16(NS_I2C_REG_LY);
+    input.rx = ns_i2c_rd_u16(NS_I2C_REG_RX);
+    input.ry = ns_i2c_rd_u16(NS_I2C_REG_RY);
+    input.imu_override = (s_regs[NS_I2C_REG_FLAGS] & NS_I2C_FLAG_IMU) != 0;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        input.accel[axis] = (int16_t)ns_i2c_rd_u16(NS_I2C_REG_ACCEL + axis * 2U);
+        input.gyro[axis] = (int16_t)ns_i2c_rd_u16(NS_I2C_REG_GYRO + axis * 2U);
+    }
+
+    /* The layer takes the whole state under its lock: the report path sees old or new, never a mix. */
+    ns_input_layer_set(NS_INPUT_LAYER_I2C, &input, ns_i2c_rd_u16(NS_I2C_REG_LEASE_MS));
+    s_regs[NS_I2C_REG_COMMITS]++;
+    s_regs[NS_I2C_REG_STATUS] &= (uint8_t)~NS_I2C_STATUS_DIRTY;
+    ns_metrics_inc(NS_METRIC_I2C_COMMITS);
+}
+
+static uint8_t ns_i2c_write_reg(uint8_t reg, uint8_t value)
+{
+    if (reg >= NS_I2C_REG_COUNT) {
+        return NS_I2C_ERR_BAD_REGISTER;
+    }
+    if (reg < NS_I2C_STATUS_BLOCK_END) {
+        if (reg != NS_I2C_REG_COMMAND) {
+            return NS_I2C_ERR_READ_ONLY;
+        }
+        if (value == NS_I2C_CMD_RELEASE) {
+            ns_input_layer_clear(NS_INPUT_LAYER_I2C);
+        } else if (value == NS_I2C_CMD_CLEAR_SHADOW) {
+            ns_i2c_clear_shadow();
+        } else {
+            return NS_I2C_ERR_BAD_VALUE;
+        }
+        return NS_I2C_ERR_NONE;
+    }
+    if (reg == NS_I2C_REG_COMMIT) {
+        if (value != NS_I2C_COMMIT_APPLY) {
+            return NS_I2C_ERR_BAD_VALUE;
+        }
+        ns_i2c_commit();
+        return NS_I2C_ERR_NONE;
+    }
+    s_regs[reg] = value;
+    s_regs[NS_I2C_REG_STATUS] |= NS_I2C_STATUS_DIRTY;
+    return NS_I2C_ERR_NONE;
+}
+
+static void ns_i2c_handle_write(const uint8_t *data, uint8_t len)
+{
+    uint8_t error = NS_I2C_ERR_NONE;
+
+    s_reg_ptr = data[0];
+    for (uint8_t i = 1; i < len; i++) {
+        uint8_t result = ns_i2c_write_reg(s_reg_ptr++, data[i]);
+
+        if (result != NS_I2C_ERR_NONE) {
+            error = result;
+        }
+    }
+    if (len > 1) {
+        s_regs[NS_I2C_REG_LAST_ERROR] = error;
+    }
+}
+
+static void ns_i2c_handle_read(void)
+{
+    uint8_t start = s_reg_ptr < NS_I2C_REG_COUNT ? s_reg_ptr : NS_I2C_REG_COUNT - 1U;
+    uint8_t end = start < NS_I2C_STATUS_BLOCK_END ? NS_I2C_STATUS_BLOCK_END : NS_I2C_REG_COUNT;
+    ns_input_layer_info_t info;
+    uint32_t written = 0;
+
+    ns_input_layer_get_info(NS_INPUT_LAYER_I2C, esp_timer_get_time(), &info);
+    s_regs[NS_I2C_REG_STATUS] = (uint8_t)((s_regs[NS_I2C_REG_STATUS] & NS_I2C_STATUS_DIRTY) |
+                                          (info.active ? NS_I2C_STATUS_ACTIVE : 0) |
+                                          (s_regs[NS_I2C_REG_LAST_ERROR] ? NS_I2C_STATUS_ERROR : 0));
+    i2c_slave_write(s_slave, &s_regs[start], end - start, &written, NS_I2C_LINK_WRITE_TIMEOUT_MS);
+    s_reg_ptr = end;
+}
+
+static bool ns_i2c_on_receive(i2c_slave_dev_handle_t slave, const i2c_slave_rx_done_event_data_t *evt, void *arg)
+{
+    ns_i2c_link_event_t event;
+    BaseType_t woken = pdFALSE;
+
+    (void)slave;
+    (void)arg;
+
+    if (evt->length == 0) {
+        return false;
+    }
+    /*
+     * A read pushes its whole block, and the master may stop early. Drop what
+     * it left before the repeated start of the next read, which would
+     * otherwise clock out stale bytes without ever raising a request.
+     */
+    i2c_ll_txfifo_rst(I2C_LL_GET_HW(NS_I2C_LINK_PORT));
+    event.len = (uint8_t)(evt->length < sizeof(event.data) ? evt->length : sizeof(event.data));
+    memcpy(event.data, evt->buffer, event.len);
+    if (xQueueSendFromISR(s_event_queue, &event, &woken) != pdTRUE) {
+        ns_metrics_inc(NS_METRIC_I2C_DROPPED);
+    }
+    return woken == pdTRUE;
+}
+
+static bool ns_i2c_on_request(i2c_slave_dev_handle_t slave, const i2c_slave_request_event_data_t *evt, void *arg)
+{
+    ns_i2c_link_event_t event = {.len = 0};
+    BaseType_t woken = pdFALSE;
+
+    (void)slave;
+    (void)evt;
+    (void)arg;
+
+    /* The bus is stretched until the task has queued the reply. */
+    if (xQueueSendFromISR(s_event_queue, &event, &woken) != pdTRUE) {
+        ns_metrics_inc(NS_METRIC_I2C_DROPPED);
+    }
+    return woken == pdTRUE;
+}
+
+static void ns_i2c_link_task(void *arg)
+{
+    ns_i2c_link_event_t event;
+
+    (void)arg;
+
+    while (1) {
+        if (xQueueReceive(s_event_queue, &event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (event.len == 0) {
+            ns_i2c_handle_read();
+        } else {
+            ns_i2c_handle_write(event.data, event.len);
+        }
+    }
+}
+
+void ns_i2c_link_start(void)
+{
+    const i2c_slave_config_t config = {
+        .i2c_port = NS_I2C_LINK_PORT,
+        .sda_io_num = NS_I2C_LINK_SDA_GPIO,
+        .scl_io_num = NS_I2C_LINK_SCL_GPIO,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .send_buf_depth = NS_I2C_LINK_BUF_DEPTH,
+        .receive_buf_depth = NS_I2C_LINK_BUF_DEPTH,
+        .slave_addr = NS_I2C_ADDR,
+        .addr_bit_len = I2C_ADDR_BIT_LEN_7,
+        .flags.enable_internal_pullup = true,
+    };
+    const i2c_slave_event_callbacks_t callbacks = {
+        .on_request = ns_i2c_on_request,
+        .on_receive = ns_i2c_on_receive,
+    };
+
+    if (s_started) {
+        return;
+    }
+
+    s_regs[NS_I2C_REG_WHO_AM_I] = NS_I2C_WHO_AM_I;
+    s_regs[NS_I2C_REG_VERSION] = NS_I2C_MAP_VERSION;
+    ns_i2c_clear_shadow();
+
+    s_event_queue = xQueueCreate(NS_I2C_LINK_QUEUE_LEN, sizeof(ns_i2c_link_event_t));
+    if (s_event_queue == NULL) {
+        ESP_LOGE(TAG, "event queue create failed");
+        return;
+    }
+    ESP_ERROR_CHECK(i2c_new_slave_device(&config, &s_slave));
+    ESP_ERROR_CHECK(i2c_slave_register_event_callbacks(s_slave, &callbacks, NULL));
+    if (xTaskCreate(ns_i2c_link_task, "ns_i2c_link", NS_I2C_LINK_TASK_STACK, NULL,
+                    NS_I2C_LINK_TASK_PRIO, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "i2c link task create failed");
+        return;
+    }
+    s_started = true;
+    ESP_LOGI(TAG, "I2C slave ready: addr=0x%02X sda=%d scl=%d", NS_I2C_ADDR,
+             NS_I2C_LINK_SDA_GPIO, NS_I2C_LINK_SCL_GPIO);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "ns_i2c_regs.h"
+
+/*
+ * I2C slave access layer for co-processors without a network stack. The
+ * register map is in ns_i2c_regs.h; committed frames go to the "i2c" input layer.
+ */
+void ns_i2c_link_start(void);
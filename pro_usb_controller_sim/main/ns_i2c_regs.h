@@ -0,0 +1,63 @@
+#pragma once
+
+/*
+ * I2C slave register map (ns_i2c_link.c), shared with host tools such as
+ * tools/i2c_host_test.c. Plain C, no ESP-IDF headers.
+ *
+ * Register addresses are one byte and auto-increment. Multi-byte values are
+ * little-endian. A write transaction is [reg, data...]; a read is a
+ * one-byte write of the start register followed by a repeated-start read.
+ * A read queues the bytes up to the end of the block the start register is
+ * in (status: 0x00-0x07, frame: 0x08-0x24). Every write empties the slave TX
+ * FIFO, so a short read is fine as long as each read starts with its
+ * register write.
+ *
+ * The frame registers are a shadow copy. Nothing reaches the controller
+ * until NS_I2C_REG_COMMIT is written, and then the whole frame is applied
+ * at once, so the report builder never sees a half-written state. COMMIT is
+ * the last frame register: one burst from NS_I2C_REG_BUTTONS through COMMIT
+ * writes and applies a full frame in a single transaction.
+ */
+
+#define NS_I2C_ADDR                 0x42
+#define NS_I2C_WHO_AM_I             0x4E
+#define NS_I2C_MAP_VERSION          1
+
+/* Status block, read-only except COMMAND. */
+#define NS_I2C_REG_WHO_AM_I         0x00
+#define NS_I2C_REG_VERSION          0x01
+#define NS_I2C_REG_STATUS           0x02    /* NS_I2C_STATUS_* */
+#define NS_I2C_REG_COMMITS          0x03    /* commit counter, wraps at 256 */
+#define NS_I2C_REG_COMMAND          0x04    /* write NS_I2C_CMD_* */
+#define NS_I2C_REG_LAST_ERROR       0x05    /* NS_I2C_ERR_*, cleared by the next accepted write */
+
+/* Frame block (shadow). */
+#define NS_I2C_REG_BUTTONS          0x08    /* u32, bit n = ns_button_id_t n */
+#define NS_I2C_REG_LX               0x0C    /* u16 x4, 12-bit, 0x800 = center */
+#define NS_I2C_REG_LY               0x0E
+#define NS_I2C_REG_RX               0x10
+#define NS_I2C_REG_RY               0x12
+#define NS_I2C_REG_ACCEL            0x14    /* i16 x3 */
+#define NS_I2C_REG_GYRO             0x1A    /* i16 x3 */
+#define NS_I2C_REG_FLAGS            0x20    /* NS_I2C_FLAG_* */
+#define NS_I2C_REG_LEASE_MS         0x22    /* u16, 0 = hold until released; default 500 */
+#define NS_I2C_REG_COMMIT           0x24    /* write NS_I2C_COMMIT_APPLY */
+
+#define NS_I2C_STATUS_BLOCK_END     0x08
+#define NS_I2C_REG_COUNT            0x25
+
+#define NS_I2C_STATUS_ACTIVE        0x01    /* committed input is held */
+#define NS_I2C_STATUS_DIRTY         0x02    /* shadow written since the last commit */
+#define NS_I2C_STATUS_ERROR         0x04    /* see NS_I2C_REG_LAST_ERROR */
+
+#define NS_I2C_CMD_RELEASE          0x01    /* drop the held input */
+#define NS_I2C_CMD_CLEAR_SHADOW     0x02    /* no buttons, sticks centered, no IMU */
+
+#define NS_I2C_FLAG_IMU             0x01
+
+#define NS_I2C_COMMIT_APPLY         0xA5
+
+#define NS_I2C_ERR_NONE             0
+#define NS_I2C_ERR_READ_ONLY        1
+#define NS_I2C_ERR_BAD_REGISTER     2
+#define NS_I2C_ERR_BAD_VALUE        3
@@ -0,0 +1,321 @@
+#include "ns_input_layer.h"
+
+#include <string.h>
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "ns_metrics.h"
+#include "ns_proto.h"
+
+typedef struct {
+    bool active;
+    bool has_sticks;
+    uint32_t owner;
+    int64_t updated_us;
+    int64_t lease_until_us;
+    /* Due time of a timed release not yet seen by a merge; 0 = none. */
+    int64_t release_stamp_us;
+    uint32_t expired;
+    ns_input_source_t source;
+    ns_input_state_t state;
+} ns_input_layer_t;
+
+static portMUX_TYPE s_layer_lock = portMUX_INITIALIZER_UNLOCKED;
+static ns_input_layer_t s_layers[NS_INPUT_LAYER_COUNT];
+static ns_input_stick_policy_t s_policy = NS_INPUT_STICKS_PRIORITY;
+
+/* Higher wins stick arbitration under NS_INPUT_STICKS_PRIORITY. */
+static const uint8_t s_layer_priority[NS_INPUT_LAYER_COUNT] = {
+    [NS_INPUT_LAYER_HTTP0 ... NS_INPUT_LAYER_UDP - 1] = 40,
+    [NS_INPUT_LAYER_UDP] = 50,
+    [NS_INPUT_LAYER_UART] = 50,
+    [NS_INPUT_LAYER_I2C] = 50,
+    [NS_INPUT_LAYER_MACRO] = 30,
+    [NS_INPUT_LAYER_RULES] = 60,
+    [NS_INPUT_LAYER_GPIO] = 20,
+    [NS_INPUT_LAYER_AUTO_TEST] = 0,
+};
+
+static const char *s_layer_names[NS_INPUT_LAYER_COUNT] = {
+    [NS_INPUT_LAYER_HTTP0] = "http0",
+    [NS_INPUT_LAYER_HTTP0 + 1] = "http1",
+    [NS_INPUT_LAYER_HTTP0 + 2] = "http2",
+    [NS_INPUT_LAYER_HTTP0 + 3] = "http3",
+    [NS_INPUT_LAYER_UDP] = "udp",
+    [NS_INPUT_LAYER_UART] = "uart",
+    [NS_INPUT_LAYER_I2C] = "i2c",
+    [NS_INPUT_LAYER_MACRO] = "macro",
+    [NS_INPUT_LAYER_RULES] = "rules",
+    [NS_INPUT_LAYER_GPIO] = "gpio",
+    [NS_INPUT_LAYER_AUTO_TEST] = "auto_test",
+};
+
+_Static_assert(NS_INPUT_HTTP_CLIENTS == 4, "update s_layer_names");
+_Static_assert(NS_INPUT_LAYER_COUNT <= 32, "contributor mask is 32 bits");
+
+static int64_t ns_input_lease_until(int64_t now, uint32_t lease_ms)
+{
+    return lease_ms == 0 ? 0 : now + (int64_t)lease_ms * 1000LL;
+}
+
+static void ns_input_layer_store(uint8_t layer, const ns_input_state_t *input, bool has_sticks,
+                                 uint32_t lease_ms)
+{
+    int64_t now = esp_timer_get_time();
+
+    if (layer >= NS_INPUT_LAYER_COUNT) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_layer_lock);
+    s_layers[layer].state = *input;
+    s_layers[layer].has_sticks = has_sticks;
+    s_layers[layer].active = true;
+    s_layers[layer].updated_us = now;
+    s_layers[layer].lease_until_us = ns_input_lease_until(now, lease_ms);
+    s_layers[layer].release_stamp_us = 0;
+    taskEXIT_CRITICAL(&s_layer_lock);
+}
+
+void ns_input_layer_set(uint8_t layer, const ns_input_state_t *input, uint32_t lease_ms)
+{
+    if (input == NULL) {
+        ns_input_layer_clear(layer);
+        return;
+    }
+    ns_input_layer_store(layer, input, true, lease_ms);
+}
+
+void ns_input_layer_set_buttons(uint8_t layer, uint32_t buttons, uint32_t lease_ms)
+{
+    ns_input_state_t input = {
+        .buttons = buttons & NS_BUTTON_MASK_ALL,
+        .lx = NS_STICK_CENTER,
+        .ly = NS_STICK_CENTER,
+        .rx = NS_STICK_CENTER,
+        .ry = NS_STICK_CENTER,
+    };
+
+    ns_input_layer_store(layer, &input, false, lease_ms);
+}
+
+void ns_input_layer_clear(uint8_t layer)
+{
+    ns_input_layer_release(layer, 0);
+}
+
+void ns_input_layer_release(uint8_t layer, int64_t stamp_us)
+{
+    if (layer >= NS_INPUT_LAYER_COUNT) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_layer_lock);
+    s_layers[layer].active = false;
+    s_layers[layer].updated_us = esp_timer_get_time();
+    s_layers[layer].release_stamp_us = stamp_us;
+    taskEXIT_CRITICAL(&s_layer_lock);
+}
+
+void ns_input_layer_renew(uint8_t layer, uint32_t lease_ms)
+{
+    if (layer >= NS_INPUT_LAYER_COUNT) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_layer_lock);
+    if (s_layers[layer].active && s_layers[layer].lease_until_us != 0) {
+        s_layers[layer].lease_until_us = ns_input_lease_until(esp_timer_get_time(), lease_ms);
+    }
+    taskEXIT_CRITICAL(&s_layer_lock);
+}
+
+void ns_input_layer_set_source(uint8_t layer, ns_input_source_t source)
+{
+    if (layer >= NS_INPUT_LAYER_COUNT) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_layer_lock);
+    s_layers[layer].source = source;
+    taskEXIT_CRITICAL(&s_layer_lock);
+}
+
+uint8_t ns_input_layer_for_client(uint32_t owner, bool create)
+{
+    uint8_t found = NS_INPUT_LAYER_NONE;
+    uint8_t idle = NS_INPUT_LAYER_NONE;
+
+    taskENTER_CRITICAL(&s_layer_lock);
+    for (uint8_t i = 0; i < NS_INPUT_HTTP_CLIENTS; i++) {
+        ns_input_layer_t *layer = &s_layers[NS_INPUT_LAYER_HTTP0 + i];
+
+        if (layer->owner == owner && layer->updated_us != 0) {
+            found = NS_INPUT_LAYER_HTTP0 + i;
+            break;
+        }
+        /* Prefer never-used slots, then the idle slot untouched the longest. */
+        if (!layer->active && (idle == NS_INPUT_LAYER_NONE ||
+                               layer->updated_us < s_layers[idle].updated_us)) {
+            idle = NS_INPUT_LAYER_HTTP0 + i;
+        }
+    }
+    if (found == NS_INPUT_LAYER_NONE && create && idle != NS_INPUT_LAYER_NONE) {
+        s_layers[idle].owner = owner;
+        s_layers[idle].updated_us = esp_timer_get_time();
+        found = idle;
+    }
+    taskEXIT_CRITICAL(&s_layer_lock);
+    return found;
+}
+
+void ns_input_layer_set_policy(ns_input_stick_policy_t policy)
+{
+    s_policy = policy;
+}
+
+ns_input_stick_policy_t ns_input_layer_get_policy(void)
+{
+    return s_policy;
+}
+
+void ns_input_layer_get_info(uint8_t layer, int64_t now_us, ns_input_layer_info_t *out)
+{
+    const ns_input_layer_t *l;
+
+    if (out == NULL || layer >= NS_INPUT_LAYER_COUNT) {
+        return;
+    }
+
+    l = &s_layers[layer];
+    taskENTER_CRITICAL(&s_layer_lock);
+    out->active = l->active && (l->lease_until_us == 0 || now_us < l->lease_until_us);
+    out->has_source = l->source != NULL;
+    out->has_sticks = l->has_sticks;
+    out->priority = s_layer_priority[layer];
+    out->owner = l->owner;
+    out->buttons = out->active ? l->state.buttons : 0;
+    out->lease_left_ms = (out->active && l->lease_until_us != 0) ?
+                         (uint32_t)((l->lease_until_us - now_us) / 1000LL) : 0;
+    out->expired = l->expired;
+    taskEXIT_CRITICAL(&s_layer_lock);
+}
+
+const char *ns_input_layer_name(uint8_t layer)
+{
+    return layer < NS_INPUT_LAYER_COUNT ? s_layer_names[layer] : "unknown";
+}
+
+static bool ns_input_layer_wins(uint8_t candidate, int64_t candidate_us,
+                                uint8_t current, int64_t current_us)
+{
+    if (current == NS_INPUT_LAYER_NONE) {
+        return true;
+    }
+    if (s_policy == NS_INPUT_STICKS_LATEST || s_layer_priority[candidate] == s_layer_priority[current]) {
+        return candidate_us > current_us;
+    }
+    return s_layer_priority[candidate] > s_layer_priority[current];
+}
+
+bool ns_input_layer_merge(int64_t now_us, ns_input_state_t *out, uint32_t *contributors)
+{
+    ns_input_state_t states[NS_INPUT_LAYER_COUNT];
+    ns_input_source_t sources[NS_INPUT_LAYER_COUNT];
+    int64_t updated[NS_INPUT_LAYER_COUNT];
+    int64_t released[NS_INPUT_LAYER_COUNT];
+    uint32_t active = 0;
+    uint32_t sticks = 0;
+    uint32_t mask = 0;
+    uint8_t stick_layer = NS_INPUT_LAYER_NONE;
+    uint8_t imu_layer = NS_INPUT_LAYER_NONE;
+
+    /* Snapshot under the lock; sources take their own locks and run outside it. */
+    taskENTER_CRITICAL(&s_layer_lock);
+    for (uint8_t i = 0; i < NS_INPUT_LAYER_COUNT; i++) {
+        ns_input_layer_t *layer = &s_layers[i];
+
+        if (layer->active && layer->lease_until_us != 0 && now_us >= layer->lease_until_us) {
+            layer->active = false;
+            layer->expired++;
+        }
+        sources[i] = layer->source;
+        updated[i] = layer->updated_us;
+        released[i] = layer->release_stamp_us;
+        layer->release_stamp_us = 0;
+        if (layer->active) {
+            states[i] = layer->state;
+            active |= 1U << i;
+            if (layer->has_sticks) {
+                sticks |= 1U << i;
+            }
+        }
+    }
+    taskEXIT_CRITICAL(&s_layer_lock);
+
+    /* This merge builds the first report without the released input. */
+    for (uint8_t i = 0; i < NS_INPUT_LAYER_COUNT; i++) {
+        if (released[i] != 0) {
+            int32_t late_us = (int32_t)(now_us - released[i]);
+
+            ns_metrics_inc(NS_METRIC_HOLD_RELEASE_REPORTS);
+            ns_metrics_add(NS_METRIC_HOLD_RELEASE_REPORT_US_SUM, (uint32_t)late_us);
+            ns_metrics_max_gauge(NS_METRIC_GAUGE_HOLD_RELEASE_REPORT_MAX_US, late_us);
+        }
+    }
+
+    for (uint8_t i = 0; i < NS_INPUT_LAYER_COUNT; i++) {
+        if (sources[i] != NULL && sources[i](now_us, &states[i])) {
+            active |= 1U << i;
+            sticks |= 1U << i;
+            updated[i] = now_us;
+        }
+    }
+
+    if (active & ~(1U << NS_INPUT_LAYER_AUTO_TEST)) {
+        active &= ~(1U << NS_INPUT_LAYER_AUTO_TEST);
+    }
+    if (active == 0) {
+        return false;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->lx = NS_STICK_CENTER;
+    out->ly = NS_STICK_CENTER;
+    out->rx = NS_STICK_CENTER;
+    out->ry = NS_STICK_CENTER;
+
+    for (uint8_t i = 0; i < NS_INPUT_LAYER_COUNT; i++) {
+        if ((active & (1U << i)) == 0) {
+            continue;
+        }
+        mask |= 1U << i;
+        out->buttons |= states[i].buttons;
+        if ((sticks & (1U << i)) &&
+            ns_input_layer_wins(i, updated[i], stick_layer,
+                                stick_layer == NS_INPUT_LAYER_NONE ? 0 : updated[stick_layer])) {
+            stick_layer = i;
+        }
+        if (states[i].imu_override &&
+            ns_input_layer_wins(i, updated[i], imu_layer,
+                                imu_layer == NS_INPUT_LAYER_NONE ? 0 : updated[imu_layer])) {
+            imu_layer = i;
+        }
+    }
+
+    if (stick_layer != NS_INPUT_LAYER_NONE) {
+        out->lx = states[stick_layer].lx;
+        out->ly = states[stick_layer].ly;
+        out->rx = states[stick_layer].rx;
+        out->ry = states[stick_layer].ry;
+    }
+    if (imu_layer != NS_INPUT_LAYER_NONE) {
+        out->imu_override = true;
+        memcpy(out->accel, states[imu_layer].accel, sizeof(out->accel));
+        memcpy(out->gyro, states[imu_layer].gyro, sizeof(out->gyro));
+    }
+    if (contributors != NULL) {
+        *contributors = mask;
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ns_protocol.h"
+
+#define NS_INPUT_HTTP_CLIENTS   4
+#define NS_INPUT_LAYER_NONE     0xFF
+
+typedef enum {
+    NS_INPUT_LAYER_HTTP0 = 0,
+    NS_INPUT_LAYER_UDP = NS_INPUT_LAYER_HTTP0 + NS_INPUT_HTTP_CLIENTS,
+    NS_INPUT_LAYER_UART,
+    NS_INPUT_LAYER_I2C,
+    NS_INPUT_LAYER_MACRO,
+    NS_INPUT_LAYER_RULES,
+    NS_INPUT_LAYER_GPIO,
+    /* Fallback: only merged while no other layer contributes. */
+    NS_INPUT_LAYER_AUTO_TEST,
+    NS_INPUT_LAYER_COUNT,
+} ns_input_layer_id_t;
+
+typedef enum {
+    /* Sticks and IMU come from the highest-priority contributing layer. */
+    NS_INPUT_STICKS_PRIORITY = 0,
+    /* Sticks and IMU come from the most recently updated contributing layer. */
+    NS_INPUT_STICKS_LATEST,
+} ns_input_stick_policy_t;
+
+typedef struct {
+    bool active;
+    bool has_source;
+    bool has_sticks;
+    uint8_t priority;
+    uint32_t owner;
+    uint32_t buttons;
+    uint32_t lease_left_ms;
+    uint32_t expired;
+} ns_input_layer_info_t;
+
+/*
+ * Per-source input layers merged once per report: buttons are ORed, sticks
+ * and IMU follow the stick policy. Every layer lives in a fixed slot, so the
+ * merge is allocation-free and bounded by NS_INPUT_LAYER_COUNT.
+ *
+ * A state with a lease is dropped once the lease runs out (0 = no lease), so
+ * a client that disappears cannot leave buttons held.
+ */
+void ns_input_layer_set(uint8_t layer, const ns_input_state_t *input, uint32_t lease_ms);
+/* Buttons only; the layer does not take part in stick arbitration. */
+void ns_input_layer_set_buttons(uint8_t layer, uint32_t buttons, uint32_t lease_ms);
+void ns_input_layer_clear(uint8_t layer);
+/*
+ * Clear for a timed release due at stamp_us: the next merge records how long
+ * after stamp_us the release reached a report. A newer set drops the stamp.
+ */
+void ns_input_layer_release(uint8_t layer, int64_t stamp_us);
+/* Extends the lease of an active layer; no-op otherwise. */
+void ns_input_layer_renew(uint8_t layer, uint32_t lease_ms);
+/* Optional per-report provider for a layer; wins over its stored state when it returns true. */
+void ns_input_layer_set_source(uint8_t layer, ns_input_source_t source);
+
+/*
+ * HTTP client slot for an owner key (client id or httpd session, see
+ * ns_wifi_control.c). With create set, a free or the least recently used idle
+ * slot is claimed.
+ */
+uint8_t ns_input_layer_for_client(uint32_t owner, bool create);
+
+void ns_input_layer_set_policy(ns_input_stick_policy_t policy);
+ns_input_stick_policy_t ns_input_layer_get_policy(void);
+void ns_input_layer_get_info(uint8_t layer, int64_t now_us, ns_input_layer_info_t *out);
+const char *ns_input_layer_name(uint8_t layer);
+
+/* Report path: merged state, and a bitmask of the layers that contributed. */
+bool ns_input_layer_merge(int64_t now_us, ns_input_state_t *out, uint32_t *contributors);
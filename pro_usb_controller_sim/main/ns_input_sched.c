@@ -0,0 +1,213 @@
+#include "ns_input_sched.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "ns_input_layer.h"
+
+static const char *TAG = "NS_INPUT_SCHED";
+
+typedef struct {
+    int64_t apply_at_us;
+    uint8_t layer;
+    bool release;
+    ns_input_state_t input;
+} ns_input_sched_entry_t;
+
+static portMUX_TYPE s_sched_lock = portMUX_INITIALIZER_UNLOCKED;
+/* Sorted by apply_at_us; index 0 is the next entry to fire. */
+static ns_input_sched_entry_t s_queue[NS_INPUT_SCHED_DEPTH];
+static uint32_t s_queue_len;
+/* Bumped on every queue change, so an arm can tell whether its stop/start raced one. */
+static uint32_t s_queue_seq;
+static ns_input_sched_stats_t s_stats;
+static esp_timer_handle_t s_timer;
+
+static void ns_input_sched_apply(const ns_input_sched_entry_t *entry)
+{
+    if (entry->release) {
+        ns_input_layer_clear(entry->layer);
+    } else {
+        ns_input_layer_set(entry->layer, &entry->input, 0);
+    }
+}
+
+/*
+ * Called after every queue change, from producers and from the timer task.
+ * The stop/start runs outside the spinlock, so a concurrent arm can cancel
+ * ours with a stale view (the timer task seeing an empty queue just before a
+ * push). Repeat until no queue change happened while we re-armed: whichever
+ * arm finishes last then left the timer set for the current head.
+ */
+static void ns_input_sched_arm(void)
+{
+    int64_t head_us;
+    int64_t delay_us;
+    uint32_t seq;
+    bool has_head;
+    bool stable;
+
+    do {
+        taskENTER_CRITICAL(&s_sched_lock);
+        seq = s_queue_seq;
+        has_head = (s_queue_len > 0);
+        head_us = has_head ? s_queue[0].apply_at_us : 0;
+        taskEXIT_CRITICAL(&s_sched_lock);
+
+        esp_timer_stop(s_timer);
+        if (has_head) {
+            delay_us = head_us - esp_timer_get_time();
+            if (delay_us < 1) {
+                delay_us = 1;
+            }
+            esp_timer_start_once(s_timer, (uint64_t)delay_us);
+        }
+
+        taskENTER_CRITICAL(&s_sched_lock);
+        stable = (seq == s_queue_seq);
+        taskEXIT_CRITICAL(&s_sched_lock);
+    } while (!stable);
+}
+
+static void ns_input_sched_timer_cb(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        ns_input_sched_entry_t entry;
+        int64_t now = esp_timer_get_time();
+        uint32_t error_us;
+
+        taskENTER_CRITICAL(&s_sched_lock);
+        if (s_queue_len == 0 || s_queue[0].apply_at_us > now) {
+            taskEXIT_CRITICAL(&s_sched_lock);
+            break;
+        }
+        entry = s_queue[0];
+        s_queue_len--;
+        memmove(&s_queue[0], &s_queue[1], s_queue_len * sizeof(s_queue[0]));
+        s_queue_seq++;
+        error_us = (uint32_t)(now - entry.apply_at_us);
+        s_stats.applied++;
+        s_stats.depth = s_queue_len;
+        if (error_us > s_stats.max_fire_error_us) {
+            s_stats.max_fire_error_us = error_us;
+        }
+        taskEXIT_CRITICAL(&s_sched_lock);
+
+        ns_input_sched_apply(&entry);
+    }
+
+    ns_input_sched_arm();
+}
+
+void ns_input_sched_init(void)
+{
+    const esp_timer_create_args_t args = {
+        .callback = ns_input_sched_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "ns_input_sched",
+    };
+
+    if (s_timer != NULL) {
+        return;
+    }
+
+    if (esp_timer_create(&args, &s_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "create timer failed");
+        s_timer = NULL;
+    }
+}
+
+bool ns_input_sched_push(uint8_t layer, int64_t apply_at_us, const ns_input_state_t *input)
+{
+    ns_input_sched_entry_t entry = {
+        .apply_at_us = apply_at_us,
+        .layer = layer,
+        .release = (input == NULL),
+    };
+    int64_t now = esp_timer_get_time();
+    uint32_t pos;
+    bool is_head;
+
+    if (input != NULL) {
+        entry.input = *input;
+    }
+
+    if (s_timer == NULL) {
+        return false;
+    }
+
+    if (apply_at_us <= now) {
+        uint32_t late_us = (uint32_t)(now - apply_at_us);
+        taskENTER_CRITICAL(&s_sched_lock);
+        s_stats.queued++;
+        s_stats.applied++;
+        s_stats.late++;
+        if (late_us > s_stats.max_late_us) {
+            s_stats.max_late_us = late_us;
+        }
+        taskEXIT_CRITICAL(&s_sched_lock);
+        ns_input_sched_apply(&entry);
+        return true;
+    }
+
+    taskENTER_CRITICAL(&s_sched_lock);
+    if (s_queue_len >= NS_INPUT_SCHED_DEPTH) {
+        s_stats.dropped_full++;
+        taskEXIT_CRITICAL(&s_sched_lock);
+        return false;
+    }
+    /* Equal deadlines keep submission order. */
+    pos = s_queue_len;
+    while (pos > 0 && s_queue[pos - 1].apply_at_us > apply_at_us) {
+        s_queue[pos] = s_queue[pos - 1];
+        pos--;
+    }
+    s_queue[pos] = entry;
+    s_queue_len++;
+    s_queue_seq++;
+    s_stats.queued++;
+    s_stats.depth = s_queue_len;
+    is_head = (pos == 0);
+    taskEXIT_CRITICAL(&s_sched_lock);
+
+    if (is_head) {
+        ns_input_sched_arm();
+    }
+    return true;
+}
+
+void ns_input_sched_clear_layer(uint8_t layer)
+{
+    uint32_t kept = 0;
+
+    taskENTER_CRITICAL(&s_sched_lock);
+    for (uint32_t i = 0; i < s_queue_len; i++) {
+        if (s_queue[i].layer != layer) {
+            s_queue[kept++] = s_queue[i];
+        }
+    }
+    s_queue_len = kept;
+    s_queue_seq++;
+    s_stats.depth = s_queue_len;
+    taskEXIT_CRITICAL(&s_sched_lock);
+
+    if (s_timer != NULL) {
+        ns_input_sched_arm();
+    }
+}
+
+void ns_input_sched_get_stats(ns_input_sched_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_sched_lock);
+    *out = s_stats;
+    taskEXIT_CRITICAL(&s_sched_lock);
+}
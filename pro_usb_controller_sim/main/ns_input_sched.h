@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ns_protocol.h"
+
+#define NS_INPUT_SCHED_DEPTH 32
+
+typedef struct {
+    uint32_t queued;
+    uint32_t applied;
+    uint32_t late;
+    uint32_t dropped_full;
+    uint32_t depth;
+    uint32_t max_late_us;
+    uint32_t max_fire_error_us;
+} ns_input_sched_stats_t;
+
+void ns_input_sched_init(void);
+/*
+ * Queue an input state (or a release when input is NULL) for an input layer,
+ * applied at apply_at_us on the esp_timer_get_time() clock. Entries already
+ * due are applied immediately and counted as late.
+ */
+bool ns_input_sched_push(uint8_t layer, int64_t apply_at_us, const ns_input_state_t *input);
+/* Drops the pending entries of one layer; other layers keep their schedule. */
+void ns_input_sched_clear_layer(uint8_t layer);
+void ns_input_sched_get_stats(ns_input_sched_stats_t *out);
@@ -0,0 +1,204 @@
+#include "ns_jitter_buffer.h"
+
+#include "freertos/FreeRTOS.h"
+
+/* Headroom added on top of the p95 transit variation. */
+#define NS_JITTER_BUFFER_MARGIN_US 2000
+
+typedef struct {
+    int64_t sender_ts_us;
+    int64_t arrival_us;
+    ns_input_state_t input;
+} ns_jitter_sample_t;
+
+static portMUX_TYPE s_jb_lock = portMUX_INITIALIZER_UNLOCKED;
+static ns_jitter_sample_t s_slots[NS_JITTER_BUFFER_SLOTS];
+static uint32_t s_head;
+static uint32_t s_count;
+static int64_t s_base_transit_us;
+static int64_t s_last_playout_us;
+static bool s_in_underrun;
+static ns_jitter_buffer_stats_t s_stats;
+
+/* Transit history, only touched by the producer. */
+static int64_t s_transit[NS_JITTER_BUFFER_WINDOW];
+static uint32_t s_transit_len;
+static uint32_t s_transit_pos;
+
+static ns_jitter_sample_t *ns_jb_slot(uint32_t index)
+{
+    return &s_slots[(s_head + index) % NS_JITTER_BUFFER_SLOTS];
+}
+
+static uint16_t ns_jb_lerp(uint16_t a, uint16_t b, int64_t num, int64_t den)
+{
+    return (uint16_t)((int64_t)a + (((int64_t)b - (int64_t)a) * num) / den);
+}
+
+/* Returns the p95 of transit above the window minimum, written to *base_us. */
+static uint32_t ns_jb_update_window(int64_t transit_us, int64_t *base_us)
+{
+    uint32_t spread[NS_JITTER_BUFFER_WINDOW];
+    int64_t base;
+    uint32_t i;
+
+    s_transit[s_transit_pos] = transit_us;
+    s_transit_pos = (s_transit_pos + 1U) % NS_JITTER_BUFFER_WINDOW;
+    if (s_transit_len < NS_JITTER_BUFFER_WINDOW) {
+        s_transit_len++;
+    }
+
+    base = s_transit[0];
+    for (i = 1; i < s_transit_len; i++) {
+        if (s_transit[i] < base) {
+            base = s_transit[i];
+        }
+    }
+
+    for (i = 0; i < s_transit_len; i++) {
+        int64_t spread_us = s_transit[i] - base;
+        uint32_t value = spread_us > NS_JITTER_BUFFER_MAX_US ? NS_JITTER_BUFFER_MAX_US : (uint32_t)spread_us;
+        uint32_t j = i;
+
+        while (j > 0 && spread[j - 1] > value) {
+            spread[j] = spread[j - 1];
+            j--;
+        }
+        spread[j] = value;
+    }
+
+    *base_us = base;
+    return spread[(s_transit_len * 95U) / 100U];
+}
+
+void ns_jitter_buffer_reset(void)
+{
+    taskENTER_CRITICAL(&s_jb_lock);
+    s_head = 0;
+    s_count = 0;
+    s_base_transit_us = 0;
+    s_last_playout_us = INT64_MIN;
+    s_in_underrun = false;
+    s_stats.active = false;
+    s_stats.depth = 0;
+    taskEXIT_CRITICAL(&s_jb_lock);
+
+    s_transit_len = 0;
+    s_transit_pos = 0;
+}
+
+void ns_jitter_buffer_push(uint64_t sender_ts_us, int64_t arrival_us, const ns_input_state_t *input)
+{
+    int64_t ts = (int64_t)sender_ts_us;
+    int64_t base_us;
+    uint32_t p95_us = ns_jb_update_window(arrival_us - ts, &base_us);
+    uint32_t target_us = p95_us + NS_JITTER_BUFFER_MARGIN_US;
+    ns_jitter_sample_t *slot;
+    uint32_t pos;
+
+    if (target_us > NS_JITTER_BUFFER_MAX_US) {
+        target_us = NS_JITTER_BUFFER_MAX_US;
+    }
+
+    taskENTER_CRITICAL(&s_jb_lock);
+    s_base_transit_us = base_us;
+    s_stats.target_us = target_us;
+    s_stats.jitter_p95_us = p95_us;
+    s_stats.pushed++;
+    s_stats.active = true;
+
+    if (ts <= s_last_playout_us) {
+        /* Its playout slot already passed; applying it now would step backwards. */
+        s_stats.late++;
+        taskEXIT_CRITICAL(&s_jb_lock);
+        return;
+    }
+
+    if (s_count == NS_JITTER_BUFFER_SLOTS) {
+        s_head = (s_head + 1U) % NS_JITTER_BUFFER_SLOTS;
+        s_count--;
+        s_stats.overflows++;
+    }
+
+    /* Reordered packets are slotted back into sender order. */
+    pos = s_count;
+    while (pos > 0 && ns_jb_slot(pos - 1)->sender_ts_us >= ts) {
+        if (ns_jb_slot(pos - 1)->sender_ts_us == ts) {
+            taskEXIT_CRITICAL(&s_jb_lock);
+            return;
+        }
+        *ns_jb_slot(pos) = *ns_jb_slot(pos - 1);
+        pos--;
+    }
+
+    slot = ns_jb_slot(pos);
+    slot->sender_ts_us = ts;
+    slot->arrival_us = arrival_us;
+    slot->input = *input;
+    s_count++;
+    s_stats.depth = s_count;
+    taskEXIT_CRITICAL(&s_jb_lock);
+}
+
+bool ns_jitter_buffer_sample(int64_t now_us, ns_input_state_t *out)
+{
+    const ns_jitter_sample_t *a;
+    int64_t playout_us;
+    int64_t waited_us;
+
+    taskENTER_CRITICAL(&s_jb_lock);
+    if (s_count == 0) {
+        taskEXIT_CRITICAL(&s_jb_lock);
+        return false;
+    }
+
+    playout_us = now_us - s_base_transit_us - (int64_t)s_stats.target_us;
+    s_last_playout_us = playout_us;
+
+    while (s_count >= 2 && ns_jb_slot(1)->sender_ts_us <= playout_us) {
+        s_head = (s_head + 1U) % NS_JITTER_BUFFER_SLOTS;
+        s_count--;
+    }
+
+    a = ns_jb_slot(0);
+    *out = a->input;
+    if (s_count >= 2 && playout_us > a->sender_ts_us) {
+        const ns_jitter_sample_t *b = ns_jb_slot(1);
+        int64_t num = playout_us - a->sender_ts_us;
+        int64_t den = b->sender_ts_us - a->sender_ts_us;
+
+        out->lx = ns_jb_lerp(a->input.lx, b->input.lx, num, den);
+        out->ly = ns_jb_lerp(a->input.ly, b->input.ly, num, den);
+        out->rx = ns_jb_lerp(a->input.rx, b->input.rx, num, den);
+        out->ry = ns_jb_lerp(a->input.ry, b->input.ry, num, den);
+        s_in_underrun = false;
+    } else if (s_count == 1 && playout_us > a->sender_ts_us) {
+        /* Ran past the newest sample: hold it until the next one arrives. */
+        if (!s_in_underrun) {
+            s_stats.underruns++;
+            s_in_underrun = true;
+        }
+    }
+
+    s_stats.depth = s_count;
+    /* EWMA (1/8) of how long the played sample waited on the device. */
+    waited_us = now_us - a->arrival_us;
+    if (waited_us < 0) {
+        waited_us = 0;
+    }
+    s_stats.added_latency_us = (uint32_t)((int64_t)s_stats.added_latency_us +
+                                          (waited_us - (int64_t)s_stats.added_latency_us) / 8);
+    taskEXIT_CRITICAL(&s_jb_lock);
+    return true;
+}
+
+void ns_jitter_buffer_get_stats(ns_jitter_buffer_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_jb_lock);
+    *out = s_stats;
+    taskEXIT_CRITICAL(&s_jb_lock);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ns_protocol.h"
+
+#define NS_JITTER_BUFFER_SLOTS      32
+#define NS_JITTER_BUFFER_WINDOW     64
+#define NS_JITTER_BUFFER_MAX_US     100000
+
+typedef struct {
+    bool active;
+    uint32_t depth;
+    uint32_t target_us;
+    uint32_t jitter_p95_us;
+    uint32_t added_latency_us;
+    uint32_t pushed;
+    uint32_t late;
+    uint32_t overflows;
+    uint32_t underruns;
+} ns_jitter_buffer_stats_t;
+
+/*
+ * Playout buffer for one streaming client. Samples are stamped with the
+ * sender clock and played back delayed by the p95 of observed transit
+ * variation; sticks are interpolated between neighbouring samples.
+ */
+void ns_jitter_buffer_reset(void);
+void ns_jitter_buffer_push(uint64_t sender_ts_us, int64_t arrival_us, const ns_input_state_t *input);
+/* ns_input_source_t compatible; installed with ns_input_layer_set_source(NS_INPUT_LAYER_UDP, ...). */
+bool ns_jitter_buffer_sample(int64_t now_us, ns_input_state_t *out);
+void ns_jitter_buffer_get_stats(ns_jitter_buffer_stats_t *out);
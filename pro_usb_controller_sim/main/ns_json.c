@@ -0,0 +1,182 @@
+#include "ns_json.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NS_JSON_END_UNSET 0xFFFF
+
+static int ns_json_alloc(ns_json_tok_t *toks, unsigned max_toks, int *count,
+                         ns_json_type_t type, size_t start, int parent)
+{
+    ns_json_tok_t *tok;
+
+    if ((unsigned)*count >= max_toks) {
+        return NS_JSON_ERR_NOMEM;
+    }
+
+    tok = &toks[*count];
+    tok->type = type;
+    tok->start = (uint16_t)start;
+    tok->end = NS_JSON_END_UNSET;
+    tok->parent = (int16_t)parent;
+    tok->size = 0;
+    if (parent >= 0) {
+        toks[parent].size++;
+    }
+    return (*count)++;
+}
+
+static bool ns_json_is_delim(char c)
+{
+    return c == ',' || c == ':' || c == ']' || c == '}' ||
+           c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+int ns_json_parse(const char *js, size_t len, ns_json_tok_t *toks, unsigned max_toks)
+{
+    int count = 0;
+    int parent = -1;
+    size_t pos = 0;
+
+    if (js == NULL || toks == NULL || len >= NS_JSON_END_UNSET) {
+        return NS_JSON_ERR_INVALID;
+    }
+
+    while (pos < len && js[pos] != '\0') {
+        char c = js[pos];
+
+        switch (c) {
+        case '{':
+        case '[': {
+            int idx = ns_json_alloc(toks, max_toks, &count,
+                                    c == '{' ? NS_JSON_OBJECT : NS_JSON_ARRAY, pos, parent);
+            if (idx < 0) {
+                return idx;
+            }
+            parent = idx;
+            pos++;
+            break;
+        }
+        case '}':
+        case ']': {
+            ns_json_type_t type = (c == '}') ? NS_JSON_OBJECT : NS_JSON_ARRAY;
+            if (parent < 0 || toks[parent].type != type) {
+                return NS_JSON_ERR_INVALID;
+            }
+            toks[parent].end = (uint16_t)(pos + 1);
+            parent = toks[parent].parent;
+            pos++;
+            break;
+        }
+        case '"': {
+            size_t start = ++pos;
+            int idx;
+
+            while (pos < len && js[pos] != '"') {
+                if (js[pos] == '\\') {
+                    pos++;
+                }
+                pos++;
+            }
+            if (pos >= len) {
+                return NS_JSON_ERR_PARTIAL;
+            }
+            idx = ns_json_alloc(toks, max_toks, &count, NS_JSON_STRING, start, parent);
+            if (idx < 0) {
+                return idx;
+            }
+            toks[idx].end = (uint16_t)pos;
+            pos++;
+            break;
+        }
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+        case ':':
+        case ',':
+            pos++;
+            break;
+        default: {
+            size_t start = pos;
+            int idx;
+
+            if (!(c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n')) {
+                return NS_JSON_ERR_INVALID;
+            }
+            while (pos < len && js[pos] != '\0' && !ns_json_is_delim(js[pos])) {
+                pos++;
+            }
+            idx = ns_json_alloc(toks, max_toks, &count, NS_JSON_PRIMITIVE, start, parent);
+            if (idx < 0) {
+                return idx;
+            }
+            toks[idx].end = (uint16_t)pos;
+            break;
+        }
+        }
+    }
+
+    if (parent >= 0) {
+        return NS_JSON_ERR_PARTIAL;
+    }
+    return count;
+}
+
+int ns_json_next(const ns_json_tok_t *toks, int count, int index)
+{
+    int next = index + 1;
+
+    while (next < count && toks[next].start < toks[index].end) {
+        next++;
+    }
+    return next;
+}
+
+bool ns_json_tok_eq(const char *js, const ns_json_tok_t *tok, const char *str)
+{
+    size_t tok_len = (size_t)(tok->end - tok->start);
+
+    return tok->type == NS_JSON_STRING &&
+           strlen(str) == tok_len &&
+           strncmp(&js[tok->start], str, tok_len) == 0;
+}
+
+bool ns_json_tok_int(const char *js, const ns_json_tok_t *tok, long *out)
+{
+    char num[16];
+    size_t tok_len = (size_t)(tok->end - tok->start);
+    char *end = NULL;
+    long value;
+
+    if (tok->type != NS_JSON_PRIMITIVE || tok_len == 0 || tok_len >= sizeof(num)) {
+        return false;
+    }
+
+    memcpy(num, &js[tok->start], tok_len);
+    num[tok_len] = '\0';
+    value = strtol(num, &end, 10);
+    if (end == num || *end != '\0') {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+bool ns_json_tok_bool(const char *js, const ns_json_tok_t *tok, bool *out)
+{
+    size_t tok_len = (size_t)(tok->end - tok->start);
+
+    if (tok->type != NS_JSON_PRIMITIVE) {
+        return false;
+    }
+    if (tok_len == 4 && strncmp(&js[tok->start], "true", 4) == 0) {
+        *out = true;
+        return true;
+    }
+    if (tok_len == 5 && strncmp(&js[tok->start], "false", 5) == 0) {
+        *out = false;
+        return true;
+    }
+    return false;
+}
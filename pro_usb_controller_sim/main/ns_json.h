@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * In-place JSON tokenizer: tokens index into the caller's buffer, nothing is
+ * copied or allocated. String tokens exclude the surrounding quotes.
+ */
+typedef enum {
+    NS_JSON_UNDEFINED = 0,
+    NS_JSON_OBJECT,
+    NS_JSON_ARRAY,
+    NS_JSON_STRING,
+    NS_JSON_PRIMITIVE,
+} ns_json_type_t;
+
+typedef struct {
+    ns_json_type_t type;
+    uint16_t start;
+    uint16_t end;
+    int16_t parent;
+    uint16_t size;
+} ns_json_tok_t;
+
+#define NS_JSON_ERR_NOMEM   (-1)
+#define NS_JSON_ERR_INVALID (-2)
+#define NS_JSON_ERR_PARTIAL (-3)
+
+/* Returns the token count, or NS_JSON_ERR_* on failure. */
+int ns_json_parse(const char *js, size_t len, ns_json_tok_t *toks, unsigned max_toks);
+/* Index of the token following toks[index] and all of its children. */
+int ns_json_next(const ns_json_tok_t *toks, int count, int index);
+bool ns_json_tok_eq(const char *js, const ns_json_tok_t *tok, const char *str);
+bool ns_json_tok_int(const char *js, const ns_json_tok_t *tok, long *out);
+bool ns_json_tok_bool(const char *js, const ns_json_tok_t *tok, bool *out);
@@ -0,0 +1,537 @@
+#include "ns_macro.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+
+#include "ns_input_layer.h"
+#include "ns_proto.h"
+
+static const char *TAG = "NS_MACRO";
+
+#define NS_MACRO_LINE_MAX       128
+#define NS_MACRO_AXIS_MAX       0x0FFF
+#define NS_MACRO_PRESS_DEFAULT_US (100000U)
+/* Longest single wait; keeps durations in a u32 of microseconds. */
+#define NS_MACRO_WAIT_MAX_US    (3600000000U)
+/* Instructions executed per report at most, so a loop without waits cannot stall USB. */
+#define NS_MACRO_TICK_BUDGET    64
+
+typedef enum {
+    NS_MACRO_OP_END = 0x00,
+    NS_MACRO_OP_HOLD = 0x01,      /* u32 mask */
+    NS_MACRO_OP_RELEASE = 0x02,   /* u32 mask */
+    NS_MACRO_OP_STICK = 0x03,     /* u8 side, u16 x, u16 y */
+    NS_MACRO_OP_WAIT = 0x04,      /* u32 us */
+    NS_MACRO_OP_LOOP = 0x05,      /* u32 target, u8 counter, u16 count (0 = forever) */
+} ns_macro_op_t;
+
+typedef struct {
+    uint8_t *code;
+    size_t cap;
+    size_t len;
+    uint32_t instructions;
+    uint8_t label_count;
+    uint8_t loop_count;
+    char labels[NS_MACRO_MAX_LABELS][NS_MACRO_LABEL_LEN];
+    uint32_t label_pc[NS_MACRO_MAX_LABELS];
+} ns_macro_compiler_t;
+
+static portMUX_TYPE s_macro_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t *s_code;
+static size_t s_code_len;
+static uint32_t s_instructions;
+static bool s_running;
+static bool s_start_requested;
+/* Main loop only. */
+static bool s_attached;
+static uint32_t s_pc;
+static uint32_t s_runs;
+static uint32_t s_max_late_us;
+static int64_t s_started_us;
+static int64_t s_next_at_us;
+static int64_t s_elapsed_us;
+static uint16_t s_loop_counters[NS_MACRO_MAX_LOOPS];
+static ns_input_state_t s_macro_input;
+
+void *ns_macro_alloc(size_t size)
+{
+    void *ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+
+    if (ptr == NULL) {
+        ptr = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    }
+    return ptr;
+}
+
+void ns_macro_free(void *ptr)
+{
+    heap_caps_free(ptr);
+}
+
+static bool ns_macro_emit(ns_macro_compiler_t *c, const uint8_t *bytes, size_t len)
+{
+    if (c->len + len > c->cap) {
+        return false;
+    }
+    memcpy(&c->code[c->len], bytes, len);
+    c->len += len;
+    return true;
+}
+
+static bool ns_macro_emit_u32(ns_macro_compiler_t *c, uint8_t op, uint32_t value)
+{
+    uint8_t insn[5] = {
+        op, (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24),
+    };
+
+    c->instructions++;
+    return ns_macro_emit(c, insn, sizeof(insn));
+}
+
+static uint32_t ns_macro_rd_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t ns_macro_rd_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static bool ns_macro_parse_uint(const char *token, unsigned long max, unsigned long *out)
+{
+    char *end = NULL;
+    unsigned long value;
+
+    if (token == NULL || token[0] < '0' || token[0] > '9') {
+        return false;
+    }
+    value = strtoul(token, &end, 10);
+    if (*end != '\0' || value > max) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
+
+/* Plain numbers are milliseconds; "ms", "us" and "s" suffixes are accepted. */
+static bool ns_macro_parse_duration(const char *token, uint32_t *out_us)
+{
+    char *end = NULL;
+    unsigned long long value;
+    unsigned long long scale = 1000ULL;
+
+    if (token == NULL || token[0] < '0' || token[0] > '9') {
+        return false;
+    }
+    value = strtoull(token, &end, 10);
+    if (strcasecmp(end, "us") == 0) {
+        scale = 1ULL;
+    } else if (strcasecmp(end, "s") == 0) {
+        scale = 1000000ULL;
+    } else if (*end != '\0' && strcasecmp(end, "ms") != 0) {
+        return false;
+    }
+    if (value > NS_MACRO_WAIT_MAX_US / scale) {
+        return false;
+    }
+    *out_us = (uint32_t)(value * scale);
+    return true;
+}
+
+static bool ns_macro_parse_buttons(char *token, uint32_t *out_mask)
+{
+    char *save = NULL;
+    uint32_t mask = 0;
+
+    for (char *name = strtok_r(token, "+", &save); name != NULL; name = strtok_r(NULL, "+", &save)) {
+        ns_button_id_t button;
+
+        if (!ns_protocol_button_from_name(name, &button) || button == NS_BUTTON_NONE) {
+            return false;
+        }
+        mask |= NS_BUTTON_MASK(button);
+    }
+    *out_mask = mask;
+    return mask != 0;
+}
+
+static const char *ns_macro_compile_line(ns_macro_compiler_t *c, char *line)
+{
+    char *argv[5] = {0};
+    char *save = NULL;
+    int argc = 0;
+    char *hash = strchr(line, '#');
+
+    if (hash != NULL) {
+        *hash = '\0';
+    }
+    for (char *tok = strtok_r(line, " \t\r", &save); tok != NULL; tok = strtok_r(NULL, " \t\r", &save)) {
+        if (argc == (int)(sizeof(argv) / sizeof(argv[0]))) {
+            return "too many arguments";
+        }
+        argv[argc++] = tok;
+    }
+    if (argc == 0) {
+        return NULL;
+    }
+
+    if (strcasecmp(argv[0], "label") == 0) {
+        if (argc != 2 || strlen(argv[1]) >= NS_MACRO_LABEL_LEN) {
+            return "label needs a name (max 15 chars)";
+        }
+        for (uint8_t i = 0; i < c->label_count; i++) {
+            if (strcasecmp(c->labels[i], argv[1]) == 0) {
+                return "duplicate label";
+            }
+        }
+        if (c->label_count == NS_MACRO_MAX_LABELS) {
+            return "too many labels";
+        }
+        strcpy(c->labels[c->label_count], argv[1]);
+        c->label_pc[c->label_count++] = (uint32_t)c->len;
+        return NULL;
+    }
+
+    if (strcasecmp(argv[0], "press") == 0 || strcasecmp(argv[0], "hold") == 0) {
+        bool press = strcasecmp(argv[0], "press") == 0;
+        uint32_t duration_us = NS_MACRO_PRESS_DEFAULT_US;
+        uint32_t mask;
+
+        if (argc < 2 || argc > (press ? 3 : 2) || !ns_macro_parse_buttons(argv[1], &mask)) {
+            return press ? "usage: press BTN[+BTN] [DURATION]" : "usage: hold BTN[+BTN]";
+        }
+        if (argc == 3 && !ns_macro_parse_duration(argv[2], &duration_us)) {
+            return "invalid duration";
+        }
+        if (!ns_macro_emit_u32(c, NS_MACRO_OP_HOLD, mask)) {
+            return "program too large";
+        }
+        if (press && (!ns_macro_emit_u32(c, NS_MACRO_OP_WAIT, duration_us) ||
+                      !ns_macro_emit_u32(c, NS_MACRO_OP_RELEASE, mask))) {
+            return "program too large";
+        }
+        return NULL;
+    }
+
+    if (strcasecmp(argv[0], "release") == 0) {
+        uint32_t mask = NS_BUTTON_MASK_ALL;
+
+        if (argc > 2 || (argc == 2 && !ns_macro_parse_buttons(argv[1], &mask))) {
+            return "usage: release [BTN[+BTN]]";
+        }
+        return ns_macro_emit_u32(c, NS_MACRO_OP_RELEASE, mask) ? NULL : "program too large";
+    }
+
+    if (strcasecmp(argv[0], "wait") == 0) {
+        uint32_t duration_us;
+
+        if (argc != 2 || !ns_macro_parse_duration(argv[1], &duration_us)) {
+            return "usage: wait DURATION";
+        }
+        return ns_macro_emit_u32(c, NS_MACRO_OP_WAIT, duration_us) ? NULL : "program too large";
+    }
+
+    if (strcasecmp(argv[0], "stick") == 0) {
+        unsigned long x;
+        unsigned long y;
+        uint8_t insn[6];
+
+        if (argc != 4 || (strcasecmp(argv[1], "L") != 0 && strcasecmp(argv[1], "R") != 0) ||
+            !ns_macro_parse_uint(argv[2], NS_MACRO_AXIS_MAX, &x) ||
+            !ns_macro_parse_uint(argv[3], NS_MACRO_AXIS_MAX, &y)) {
+            return "usage: stick L|R X Y (0..4095)";
+        }
+        insn[0] = NS_MACRO_OP_STICK;
+        insn[1] = (strcasecmp(argv[1], "R") == 0) ? 1U : 0U;
+        insn[2] = (uint8_t)x;
+        insn[3] = (uint8_t)(x >> 8);
+        insn[4] = (uint8_t)y;
+        insn[5] = (uint8_t)(y >> 8);
+        c->instructions++;
+        return ns_macro_emit(c, insn, sizeof(insn)) ? NULL : "program too large";
+    }
+
+    if (strcasecmp(argv[0], "loop") == 0) {
+        unsigned long count = 0;
+        uint32_t target = UINT32_MAX;
+        uint8_t insn[8];
+
+        if (argc < 2 || argc > 3 || (argc == 3 && !ns_macro_parse_uint(argv[2], UINT16_MAX, &count))) {
+            return "usage: loop LABEL [COUNT]";
+        }
+        for (uint8_t i = 0; i < c->label_count; i++) {
+            if (strcasecmp(c->labels[i], argv[1]) == 0) {
+                target = c->label_pc[i];
+                break;
+            }
+        }
+        if (target == UINT32_MAX) {
+            return "loop label must be defined above";
+        }
+        if (count == 1) {
+            /* Body already ran once; nothing to repeat. */
+            return NULL;
+        }
+        if (count > 1 && c->loop_count == NS_MACRO_MAX_LOOPS) {
+            return "too many counted loops";
+        }
+        insn[0] = NS_MACRO_OP_LOOP;
+        insn[1] = (uint8_t)target;
+        insn[2] = (uint8_t)(target >> 8);
+        insn[3] = (uint8_t)(target >> 16);
+        insn[4] = (uint8_t)(target >> 24);
+        insn[5] = count > 1 ? c->loop_count++ : 0U;
+        insn[6] = (uint8_t)count;
+        insn[7] = (uint8_t)(count >> 8);
+        c->instructions++;
+        return ns_macro_emit(c, insn, sizeof(insn)) ? NULL : "program too large";
+    }
+
+    return "unknown statement";
+}
+
+/* On success c->code holds the program; on failure it is freed and err is set. */
+static bool ns_macro_compile(ns_macro_compiler_t *c, const char *src, size_t len, char *err,
+                             size_t err_len)
+{
+    const uint8_t end_op = NS_MACRO_OP_END;
+    size_t pos = 0;
+    uint32_t line_no = 0;
+
+    /* Every statement compiles to fewer than two bytes per source character. */
+    c->cap = len * 2U + 16U;
+    c->code = ns_macro_alloc(c->cap);
+    if (c->code == NULL) {
+        snprintf(err, err_len, "out of memory");
+        return false;
+    }
+
+    while (pos < len) {
+        char line[NS_MACRO_LINE_MAX];
+        size_t line_len = 0;
+        const char *error;
+
+        line_no++;
+        while (pos < len && src[pos] != '\n') {
+            if (line_len + 1U >= sizeof(line)) {
+                snprintf(err, err_len, "line %u: too long", (unsigned)line_no);
+                ns_macro_free(c->code);
+                return false;
+            }
+            line[line_len++] = src[pos++];
+        }
+        line[line_len] = '\0';
+        pos++;
+
+        error = ns_macro_compile_line(c, line);
+        if (error != NULL) {
+            snprintf(err, err_len, "line %u: %s", (unsigned)line_no, error);
+            ns_macro_free(c->code);
+            return false;
+        }
+    }
+    ns_macro_emit(c, &end_op, 1);
+    return true;
+}
+
+bool ns_macro_load(const char *src, size_t len, char *err, size_t err_len)
+{
+    ns_macro_compiler_t *c;
+    uint8_t *old_code;
+
+    if (len > NS_MACRO_SOURCE_MAX) {
+        snprintf(err, err_len, "source too large (max %d bytes)", NS_MACRO_SOURCE_MAX);
+        return false;
+    }
+
+    /* Per call: httpd and the UART task may compile at the same time. */
+    c = calloc(1, sizeof(*c));
+    if (c == NULL) {
+        snprintf(err, err_len, "out of memory");
+        return false;
+    }
+    if (!ns_macro_compile(c, src, len, err, err_len)) {
+        free(c);
+        return false;
+    }
+
+    taskENTER_CRITICAL(&s_macro_lock);
+    old_code = s_code;
+    s_code = c->code;
+    s_code_len = c->len;
+    s_instructions = c->instructions;
+    s_running = false;
+    s_start_requested = false;
+    s_pc = 0;
+    taskEXIT_CRITICAL(&s_macro_lock);
+
+    ns_macro_free(old_code);
+    ESP_LOGI(TAG, "macro loaded: %u instructions, %u bytes",
+             (unsigned)c->instructions, (unsigned)c->len);
+    free(c);
+    return true;
+}
+
+bool ns_macro_request_start(void)
+{
+    bool loaded;
+
+    taskENTER_CRITICAL(&s_macro_lock);
+    loaded = s_code != NULL;
+    s_start_requested = loaded;
+    taskEXIT_CRITICAL(&s_macro_lock);
+    return loaded;
+}
+
+/* Runs with s_macro_lock held. */
+static void ns_macro_start_locked(void)
+{
+    memset(s_loop_counters, 0, sizeof(s_loop_counters));
+    memset(&s_macro_input, 0, sizeof(s_macro_input));
+    s_macro_input.lx = NS_STICK_CENTER;
+    s_macro_input.ly = NS_STICK_CENTER;
+    s_macro_input.rx = NS_STICK_CENTER;
+    s_macro_input.ry = NS_STICK_CENTER;
+    s_pc = 0;
+    s_next_at_us = 0;
+    s_elapsed_us = 0;
+    s_max_late_us = 0;
+    s_runs++;
+    s_running = true;
+}
+
+void ns_macro_stop(void)
+{
+    taskENTER_CRITICAL(&s_macro_lock);
+    s_running = false;
+    s_start_requested = false;
+    taskEXIT_CRITICAL(&s_macro_lock);
+}
+
+void ns_macro_periodic(void)
+{
+    bool running;
+
+    taskENTER_CRITICAL(&s_macro_lock);
+    if (s_start_requested && s_code != NULL) {
+        ns_macro_start_locked();
+    }
+    s_start_requested = false;
+    running = s_running;
+    taskEXIT_CRITICAL(&s_macro_lock);
+
+    /* A finished program stays attached until here; its sample reports nothing meanwhile. */
+    if (running != s_attached) {
+        ns_input_layer_set_source(NS_INPUT_LAYER_MACRO, running ? ns_macro_sample : NULL);
+        s_attached = running;
+    }
+}
+
+/* Runs with s_macro_lock held; returns false to end the current report tick. */
+static bool ns_macro_step(int64_t now_us)
+{
+    const uint8_t *insn = &s_code[s_pc];
+
+    switch (insn[0]) {
+    case NS_MACRO_OP_HOLD:
+        s_macro_input.buttons |= ns_macro_rd_u32(&insn[1]);
+        s_pc += 5;
+        break;
+    case NS_MACRO_OP_RELEASE: {
+        uint32_t released = s_macro_input.buttons & ns_macro_rd_u32(&insn[1]);
+
+        s_macro_input.buttons &= ~released;
+        s_pc += 5;
+        /* Let the release reach a report before a following press can re-hold it. */
+        return released == 0;
+    }
+    case NS_MACRO_OP_STICK:
+        if (insn[1] == 0) {
+            s_macro_input.lx = ns_macro_rd_u16(&insn[2]);
+            s_macro_input.ly = ns_macro_rd_u16(&insn[4]);
+        } else {
+            s_macro_input.rx = ns_macro_rd_u16(&insn[2]);
+            s_macro_input.ry = ns_macro_rd_u16(&insn[4]);
+        }
+        s_pc += 6;
+        break;
+    case NS_MACRO_OP_WAIT: {
+        int64_t late_us = now_us - s_next_at_us;
+
+        if (late_us > (int64_t)s_max_late_us) {
+            s_max_late_us = late_us > (int64_t)UINT32_MAX ? UINT32_MAX : (uint32_t)late_us;
+        }
+        /* Advance from the scheduled time, not from now, so lateness never accumulates. */
+        s_next_at_us += ns_macro_rd_u32(&insn[1]);
+        s_pc += 5;
+        break;
+    }
+    case NS_MACRO_OP_LOOP: {
+        uint16_t count = ns_macro_rd_u16(&insn[6]);
+        uint16_t *counter = &s_loop_counters[insn[5]];
+
+        if (count == 0 || ++(*counter) < count) {
+            s_pc = ns_macro_rd_u32(&insn[1]);
+        } else {
+            *counter = 0;
+            s_pc += 8;
+        }
+        break;
+    }
+    case NS_MACRO_OP_END:
+    default:
+        s_running = false;
+        return false;
+    }
+    return true;
+}
+
+bool ns_macro_sample(int64_t now_us, ns_input_state_t *out)
+{
+    uint8_t budget = NS_MACRO_TICK_BUDGET;
+
+    taskENTER_CRITICAL(&s_macro_lock);
+    if (!s_running) {
+        taskEXIT_CRITICAL(&s_macro_lock);
+        return false;
+    }
+    if (s_next_at_us == 0) {
+        s_started_us = now_us;
+        s_next_at_us = now_us;
+    }
+    while (now_us >= s_next_at_us && budget > 0) {
+        budget--;
+        if (!ns_macro_step(now_us)) {
+            break;
+        }
+    }
+    *out = s_macro_input;
+    s_elapsed_us = now_us - s_started_us;
+    taskEXIT_CRITICAL(&s_macro_lock);
+    return true;
+}
+
+void ns_macro_get_status(ns_macro_status_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_macro_lock);
+    out->loaded = s_code != NULL;
+    out->running = s_running || s_start_requested;
+    out->code_bytes = (uint32_t)s_code_len;
+    out->instructions = s_instructions;
+    out->pc = s_pc;
+    out->runs = s_runs;
+    out->elapsed_us = s_elapsed_us;
+    out->max_late_us = s_max_late_us;
+    taskEXIT_CRITICAL(&s_macro_lock);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ns_protocol.h"
+
+#define NS_MACRO_SOURCE_MAX     32768
+#define NS_MACRO_MAX_LABELS     32
+#define NS_MACRO_MAX_LOOPS      32
+#define NS_MACRO_LABEL_LEN      16
+
+typedef struct {
+    bool loaded;
+    bool running;
+    uint32_t code_bytes;
+    uint32_t instructions;
+    uint32_t pc;
+    uint32_t runs;
+    int64_t elapsed_us;
+    uint32_t max_late_us;
+} ns_macro_status_t;
+
+/*
+ * Macro source, one statement per line ('#' starts a comment):
+ *
+ *   label NAME
+ *   press BTN[+BTN...] [DURATION]   hold, wait (default 100ms), release
+ *   hold BTN[+BTN...]
+ *   release [BTN[+BTN...]]          no argument releases every button
+ *   stick L|R X Y                   axes 0..4095
+ *   wait DURATION                   e.g. 250, 250ms, 1500us, 2s
+ *   loop NAME [COUNT]               run from NAME COUNT times; 0/omitted = forever
+ *
+ * Compiled bytecode is kept in PSRAM when available. Waits are accumulated
+ * on an absolute timeline, so timing does not drift over long programs.
+ * The program only advances in ns_macro_sample(), once per standard report
+ * (NS_STD_PERIOD_MS), so each step lands up to one report period late.
+ */
+bool ns_macro_load(const char *src, size_t len, char *err, size_t err_len);
+/*
+ * Start and stop may be called from any task (httpd, UART, the TinyUSB
+ * callbacks via rules). A start is only posted here; ns_macro_periodic()
+ * starts the program and attaches the macro layer from the main loop.
+ * Returns false when no macro is loaded.
+ */
+bool ns_macro_request_start(void);
+void ns_macro_stop(void);
+/* Main loop only: applies a pending start, attaches or detaches the layer source. */
+void ns_macro_periodic(void);
+/* A posted start already counts as running. */
+void ns_macro_get_status(ns_macro_status_t *out);
+/* ns_input_source_t compatible, attached by ns_macro_periodic(). */
+bool ns_macro_sample(int64_t now_us, ns_input_state_t *out);
+
+/* Large buffers for macro upload; PSRAM first, internal RAM as fallback. */
+void *ns_macro_alloc(size_t size);
+void ns_macro_free(void *ptr);
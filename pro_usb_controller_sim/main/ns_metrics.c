@@ -0,0 +1,229 @@
+#include "ns_metrics.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+
+#include "ns_proto.h"
+
+#define NS_METRICS_REPORT_KINDS 5
+
+typedef struct {
+    uint32_t counters[NS_METRIC_COUNTER_COUNT];
+    uint32_t report_sent[NS_METRICS_REPORT_KINDS];
+    uint32_t report_failed[NS_METRICS_REPORT_KINDS];
+    uint32_t subcmd[256];
+    uint32_t http_requests[NS_METRICS_HTTP_ROUTES];
+    uint32_t http_time_us[NS_METRICS_HTTP_ROUTES];
+} ns_metrics_slot_t;
+
+static const struct {
+    uint8_t report_id;
+    const char *label;
+} s_report_kinds[NS_METRICS_REPORT_KINDS] = {
+    {NS_REPORT_ID_SUBCMD_REPLY, "0x21"},
+    {NS_REPORT_ID_STD, "0x30"},
+    {0x3F, "0x3F"},
+    {NS_REPORT_ID_USB_REPLY, "0x81"},
+    {0x00, "other"},
+};
+
+static const char *s_counter_names[NS_METRIC_COUNTER_COUNT] = {
+    [NS_METRIC_HID_BUSY] = "ns_usb_hid_busy_total",
+    [NS_METRIC_USB_MOUNT] = "ns_usb_mount_total",
+    [NS_METRIC_USB_UNMOUNT] = "ns_usb_unmount_total",
+    [NS_METRIC_WIFI_RECONNECT] = "ns_wifi_reconnect_total",
+    [NS_METRIC_HANDSHAKE_COUNT] = "ns_handshake_total",
+    [NS_METRIC_HANDSHAKE_US_SUM] = "ns_handshake_us_sum",
+    [NS_METRIC_LOOP_ITERATIONS] = "ns_loop_iterations_total",
+    [NS_METRIC_LOOP_JITTER_US_SUM] = "ns_loop_jitter_us_sum",
+    [NS_METRIC_HOLD_RELEASES] = "ns_hold_release_total",
+    [NS_METRIC_HOLD_RELEASE_ERROR_US_SUM] = "ns_hold_release_error_us_sum",
+    [NS_METRIC_HOLD_RELEASE_REPORTS] = "ns_hold_release_report_total",
+    [NS_METRIC_HOLD_RELEASE_REPORT_US_SUM] = "ns_hold_release_report_us_sum",
+    [NS_METRIC_WIFI_CONNECT_COUNT] = "ns_wifi_connect_total",
+    [NS_METRIC_WIFI_CONNECT_US_SUM] = "ns_wifi_connect_us_sum",
+    [NS_METRIC_WIFI_FAST_CONNECT] = "ns_wifi_fast_connect_total",
+    [NS_METRIC_UART_FRAMES] = "ns_uart_frames_total",
+    [NS_METRIC_UART_BAD_FRAMES] = "ns_uart_bad_frames_total",
+    [NS_METRIC_I2C_COMMITS] = "ns_i2c_commits_total",
+    [NS_METRIC_I2C_DROPPED] = "ns_i2c_dropped_total",
+    [NS_METRIC_USB_IN_COMPLETE_COUNT] = "ns_usb_in_complete_total",
+    [NS_METRIC_USB_IN_COMPLETE_US_SUM] = "ns_usb_in_complete_us_sum",
+    [NS_METRIC_GPIO_CHANGES] = "ns_gpio_changes_total",
+    [NS_METRIC_GPIO_BOUNCES] = "ns_gpio_bounces_total",
+    [NS_METRIC_GPIO_PUBLISHES] = "ns_gpio_publish_total",
+    [NS_METRIC_GPIO_PUBLISH_US_SUM] = "ns_gpio_publish_us_sum",
+};
+
+static const char *s_gauge_names[NS_METRIC_GAUGE_COUNT] = {
+    [NS_METRIC_GAUGE_HANDSHAKE_LAST_US] = "ns_handshake_last_us",
+    [NS_METRIC_GAUGE_LOOP_PERIOD_US] = "ns_loop_period_us",
+    [NS_METRIC_GAUGE_LOOP_JITTER_MAX_US] = "ns_loop_jitter_max_us",
+    [NS_METRIC_GAUGE_HOLD_RELEASE_ERROR_MAX_US] = "ns_hold_release_error_max_us",
+    [NS_METRIC_GAUGE_HOLD_RELEASE_REPORT_MAX_US] = "ns_hold_release_report_max_us",
+    [NS_METRIC_GAUGE_WIFI_CONNECT_LAST_US] = "ns_wifi_connect_last_us",
+    [NS_METRIC_GAUGE_WIFI_BACKOFF_MS] = "ns_wifi_backoff_ms",
+    [NS_METRIC_GAUGE_USB_IN_COMPLETE_MAX_US] = "ns_usb_in_complete_max_us",
+};
+
+static ns_metrics_slot_t s_slots[portNUM_PROCESSORS];
+static volatile int32_t s_gauges[NS_METRIC_GAUGE_COUNT];
+static const char *s_http_routes[NS_METRICS_HTTP_ROUTES];
+
+static inline void ns_metrics_bump(uint32_t *counter, uint32_t value)
+{
+    __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
+
+static inline ns_metrics_slot_t *ns_metrics_slot(void)
+{
+    return &s_slots[xPortGetCoreID()];
+}
+
+static uint32_t ns_metrics_sum(size_t offset)
+{
+    uint32_t total = 0;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        const uint32_t *counter = (const uint32_t *)((const uint8_t *)&s_slots[core] + offset);
+        total += __atomic_load_n(counter, __ATOMIC_RELAXED);
+    }
+    return total;
+}
+
+#define NS_METRICS_SUM(_field) ns_metrics_sum(offsetof(ns_metrics_slot_t, _field))
+
+void ns_metrics_inc(ns_metric_counter_t id)
+{
+    ns_metrics_add(id, 1);
+}
+
+void ns_metrics_add(ns_metric_counter_t id, uint32_t value)
+{
+    if (id >= NS_METRIC_COUNTER_COUNT) {
+        return;
+    }
+    ns_metrics_bump(&ns_metrics_slot()->counters[id], value);
+}
+
+void ns_metrics_report(uint8_t report_id, bool sent)
+{
+    uint8_t kind = NS_METRICS_REPORT_KINDS - 1;
+    ns_metrics_slot_t *slot = ns_metrics_slot();
+
+    for (uint8_t i = 0; i < NS_METRICS_REPORT_KINDS - 1; i++) {
+        if (s_report_kinds[i].report_id == report_id) {
+            kind = i;
+            break;
+        }
+    }
+
+    ns_metrics_bump(sent ? &slot->report_sent[kind] : &slot->report_failed[kind], 1);
+}
+
+void ns_metrics_subcmd(uint8_t subcmd_id)
+{
+    ns_metrics_bump(&ns_metrics_slot()->subcmd[subcmd_id], 1);
+}
+
+void ns_metrics_http_register(uint8_t route, const char *uri)
+{
+    if (route < NS_METRICS_HTTP_ROUTES) {
+        s_http_routes[route] = uri;
+    }
+}
+
+void ns_metrics_http(uint8_t route, uint32_t duration_us)
+{
+    ns_metrics_slot_t *slot;
+
+    if (route >= NS_METRICS_HTTP_ROUTES) {
+        return;
+    }
+    slot = ns_metrics_slot();
+    ns_metrics_bump(&slot->http_requests[route], 1);
+    ns_metrics_bump(&slot->http_time_us[route], duration_us);
+}
+
+void ns_metrics_set_gauge(ns_metric_gauge_t id, int32_t value)
+{
+    if (id < NS_METRIC_GAUGE_COUNT) {
+        s_gauges[id] = value;
+    }
+}
+
+void ns_metrics_max_gauge(ns_metric_gauge_t id, int32_t value)
+{
+    if (id < NS_METRIC_GAUGE_COUNT && value > s_gauges[id]) {
+        s_gauges[id] = value;
+    }
+}
+
+void ns_metrics_render(ns_metrics_write_t write, void *ctx)
+{
+    char line[128];
+
+    for (int id = 0; id < NS_METRIC_COUNTER_COUNT; id++) {
+        snprintf(line, sizeof(line), "# TYPE %s counter\n%s %u\n",
+                 s_counter_names[id], s_counter_names[id],
+                 (unsigned)NS_METRICS_SUM(counters[id]));
+        write(ctx, line);
+    }
+
+    for (int id = 0; id < NS_METRIC_GAUGE_COUNT; id++) {
+        snprintf(line, sizeof(line), "# TYPE %s gauge\n%s %d\n",
+                 s_gauge_names[id], s_gauge_names[id], (int)s_gauges[id]);
+        write(ctx, line);
+    }
+
+    write(ctx, "# TYPE ns_usb_reports_sent_total counter\n");
+    for (int kind = 0; kind < NS_METRICS_REPORT_KINDS; kind++) {
+        snprintf(line, sizeof(line), "ns_usb_reports_sent_total{report_id=\"%s\"} %u\n",
+                 s_report_kinds[kind].label, (unsigned)NS_METRICS_SUM(report_sent[kind]));
+        write(ctx, line);
+    }
+    write(ctx, "# TYPE ns_usb_reports_failed_total counter\n");
+    for (int kind = 0; kind < NS_METRICS_REPORT_KINDS; kind++) {
+        snprintf(line, sizeof(line), "ns_usb_reports_failed_total{report_id=\"%s\"} %u\n",
+                 s_report_kinds[kind].label, (unsigned)NS_METRICS_SUM(report_failed[kind]));
+        write(ctx, line);
+    }
+
+    write(ctx, "# TYPE ns_subcmd_total counter\n");
+    for (int id = 0; id < 256; id++) {
+        uint32_t count = NS_METRICS_SUM(subcmd[id]);
+        if (count == 0) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "ns_subcmd_total{id=\"0x%02X\"} %u\n", id, (unsigned)count);
+        write(ctx, line);
+    }
+
+    write(ctx, "# TYPE ns_http_requests_total counter\n");
+    for (int route = 0; route < NS_METRICS_HTTP_ROUTES; route++) {
+        if (s_http_routes[route] == NULL) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "ns_http_requests_total{path=\"%s\"} %u\n",
+                 s_http_routes[route], (unsigned)NS_METRICS_SUM(http_requests[route]));
+        write(ctx, line);
+    }
+    write(ctx, "# TYPE ns_http_handler_us_sum counter\n");
+    for (int route = 0; route < NS_METRICS_HTTP_ROUTES; route++) {
+        if (s_http_routes[route] == NULL) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "ns_http_handler_us_sum{path=\"%s\"} %u\n",
+                 s_http_routes[route], (unsigned)NS_METRICS_SUM(http_time_us[route]));
+        write(ctx, line);
+    }
+
+    snprintf(line, sizeof(line),
+             "# TYPE ns_heap_free_bytes gauge\nns_heap_free_bytes %u\n"
+             "# TYPE ns_heap_min_free_bytes gauge\nns_heap_min_free_bytes %u\n",
+             (unsigned)esp_get_free_heap_size(), (unsigned)esp_get_minimum_free_heap_size());
+    write(ctx, line);
+}
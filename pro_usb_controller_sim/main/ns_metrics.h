@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NS_METRICS_HTTP_ROUTES  32
+
+typedef enum {
+    NS_METRIC_HID_BUSY = 0,
+    NS_METRIC_USB_MOUNT,
+    NS_METRIC_USB_UNMOUNT,
+    NS_METRIC_WIFI_RECONNECT,
+    NS_METRIC_HANDSHAKE_COUNT,
+    NS_METRIC_HANDSHAKE_US_SUM,
+    NS_METRIC_LOOP_ITERATIONS,
+    NS_METRIC_LOOP_JITTER_US_SUM,
+    NS_METRIC_HOLD_RELEASES,
+    NS_METRIC_HOLD_RELEASE_ERROR_US_SUM,
+    NS_METRIC_HOLD_RELEASE_REPORTS,
+    NS_METRIC_HOLD_RELEASE_REPORT_US_SUM,
+    NS_METRIC_WIFI_CONNECT_COUNT,
+    NS_METRIC_WIFI_CONNECT_US_SUM,
+    NS_METRIC_WIFI_FAST_CONNECT,
+    NS_METRIC_UART_FRAMES,
+    NS_METRIC_UART_BAD_FRAMES,
+    NS_METRIC_I2C_COMMITS,
+    NS_METRIC_I2C_DROPPED,
+    NS_METRIC_USB_IN_COMPLETE_COUNT,
+    NS_METRIC_USB_IN_COMPLETE_US_SUM,
+    NS_METRIC_GPIO_CHANGES,
+    NS_METRIC_GPIO_BOUNCES,
+    NS_METRIC_GPIO_PUBLISHES,
+    NS_METRIC_GPIO_PUBLISH_US_SUM,
+    NS_METRIC_COUNTER_COUNT,
+} ns_metric_counter_t;
+
+/* Gauges have a single writer each and are stored as plain words. */
+typedef enum {
+    NS_METRIC_GAUGE_HANDSHAKE_LAST_US = 0,
+    NS_METRIC_GAUGE_LOOP_PERIOD_US,
+    NS_METRIC_GAUGE_LOOP_JITTER_MAX_US,
+    NS_METRIC_GAUGE_HOLD_RELEASE_ERROR_MAX_US,
+    NS_METRIC_GAUGE_HOLD_RELEASE_REPORT_MAX_US,
+    NS_METRIC_GAUGE_WIFI_CONNECT_LAST_US,
+    NS_METRIC_GAUGE_WIFI_BACKOFF_MS,
+    NS_METRIC_GAUGE_USB_IN_COMPLETE_MAX_US,
+    NS_METRIC_GAUGE_COUNT,
+} ns_metric_gauge_t;
+
+typedef void (*ns_metrics_write_t)(void *ctx, const char *text);
+
+/*
+ * Counters live in one slot per core and are bumped with relaxed atomics, so
+ * the USB path never takes a lock. Slots are only summed in ns_metrics_render().
+ */
+void ns_metrics_inc(ns_metric_counter_t id);
+void ns_metrics_add(ns_metric_counter_t id, uint32_t value);
+void ns_metrics_report(uint8_t report_id, bool sent);
+void ns_metrics_subcmd(uint8_t subcmd_id);
+void ns_metrics_http_register(uint8_t route, const char *uri);
+void ns_metrics_http(uint8_t route, uint32_t duration_us);
+void ns_metrics_set_gauge(ns_metric_gauge_t id, int32_t value);
+void ns_metrics_max_gauge(ns_metric_gauge_t id, int32_t value);
+void ns_metrics_render(ns_metrics_write_t write, void *ctx);
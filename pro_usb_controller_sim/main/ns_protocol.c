@@ -1,13 +1,19 @@
 #include "ns_protocol.h"
 
 #include <string.h>
+#include <strings.h>
 
-#include "driver/gpio.h"
 #include "esp_log.h"
 #include "esp_mac.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
+#include "ns_boot.h"
+#include "ns_events.h"
+#include "ns_gpio_buttons.h"
+#include "ns_input_layer.h"
+#include "ns_metrics.h"
 #include "ns_proto.h"
+#include "ns_rules.h"
 #include "tinyusb.h"
 
 static const char *TAG = "NS_SIM";
@@ -15,20 +21,46 @@ static const char *TAG = "NS_SIM";
 static ns_state_t s_state;
 static uint8_t s_last_subcmd_reply[64];
 static size_t s_last_subcmd_reply_len;
-static bool s_input_inited;
 static bool s_auto_key_inited;
 static bool s_auto_key_started;
 static bool s_auto_key_trigger_prev;
 static int64_t s_auto_key_last_switch_us;
 static uint8_t s_auto_key_index;
-static bool s_manual_button_override;
-static ns_button_id_t s_manual_button;
 static uint16_t s_imu_phase;
 static bool s_imu_log_pending;
 static bool s_auto_imu_enabled;
-static bool s_gpio_a_last;
-static bool s_effective_a_last;
-static bool s_a_log_inited;
+static bool s_trigger_last;
+static bool s_imu_override_active;
+static int16_t s_imu_override[6];
+/* Set by the first USB command of a handshake, cleared once input streams. */
+static int64_t s_handshake_start_us;
+typedef struct {
+    const char *name;
+    ns_button_id_t button;
+} ns_button_name_map_t;
+
+static const ns_button_name_map_t s_button_name_map[] = {
+    {"NONE", NS_BUTTON_NONE},
+    {"Y", NS_BUTTON_Y},
+    {"X", NS_BUTTON_X},
+    {"B", NS_BUTTON_B},
+    {"A", NS_BUTTON_A},
+    {"L", NS_BUTTON_L},
+    {"R", NS_BUTTON_R},
+    {"ZL", NS_BUTTON_ZL},
+    {"ZR", NS_BUTTON_ZR},
+    {"MINUS", NS_BUTTON_MINUS},
+    {"PLUS", NS_BUTTON_PLUS},
+    {"L_STICK", NS_BUTTON_L_STICK},
+    {"R_STICK", NS_BUTTON_R_STICK},
+    {"HOME", NS_BUTTON_HOME},
+    {"CAPTURE", NS_BUTTON_CAPTURE},
+    {"UP", NS_BUTTON_UP},
+    {"DOWN", NS_BUTTON_DOWN},
+    {"LEFT", NS_BUTTON_LEFT},
+    {"RIGHT", NS_BUTTON_RIGHT},
+};
+
 static const uint8_t s_spi_rom_60[] = {
     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
     0xff, 0xff, 0x03, 0xa0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02, 0xff, 0xff, 0xff, 0xff,
@@ -49,8 +81,6 @@ static const uint8_t s_spi_rom_80[] = {
     0x00, 0x40, 0x00, 0x40, 0xfe, 0xff, 0xfe, 0xff, 0x08, 0x00, 0xe7, 0x3b, 0xe7, 0x3b, 0xe7, 0x3b,
 };
 
-/* Most ESP32-S3 dev boards expose BOOT on GPIO0 (active low). */
-#define NS_BOOT_BUTTON_GPIO GPIO_NUM_0
 #define NS_AUTO_KEY_INTERVAL_US (2000000LL)
 #define NS_STICK_MIN 0x0000
 #define NS_STICK_MAX 0x0FFF
@@ -73,6 +103,10 @@ typedef struct ns_auto_key_pattern_s {
 } ns_auto_key_pattern_t;
 
 static ns_auto_key_pattern_t s_auto_key_pattern_current;
+/* Copy of the last merged pattern for 0x21 replies built on the TinyUSB task. */
+static portMUX_TYPE s_pattern_lock = portMUX_INITIALIZER_UNLOCKED;
+static ns_auto_key_pattern_t s_pattern_published;
+static bool s_pattern_published_valid;
 
 typedef struct {
     const char *name;
@@ -131,76 +165,72 @@ static void ns_pattern_apply_button(ns_auto_key_pattern_t *pattern, ns_button_id
 {
     switch (button) {
     case NS_BUTTON_Y:
-        pattern->std_btn_right = 0x01;
-        pattern->simple_btn_high = 0x01;
+        pattern->std_btn_right |= 0x01;
+        pattern->simple_btn_high |= 0x01;
         break;
     case NS_BUTTON_X:
-        pattern->std_btn_right = 0x02;
-        pattern->simple_btn_high = 0x02;
+        pattern->std_btn_right |= 0x02;
+        pattern->simple_btn_high |= 0x02;
         break;
     case NS_BUTTON_B:
-        pattern->std_btn_right = 0x04;
-        pattern->simple_btn_high = 0x04;
+        pattern->std_btn_right |= 0x04;
+        pattern->simple_btn_high |= 0x04;
         break;
     case NS_BUTTON_A:
-        pattern->std_btn_right = 0x08;
-        pattern->simple_btn_high = 0x08;
+        pattern->std_btn_right |= 0x08;
+        pattern->simple_btn_high |= 0x08;
         break;
     case NS_BUTTON_L:
-        pattern->std_btn_left = 0x40;
-        pattern->simple_btn_low = 0x40;
+        pattern->std_btn_left |= 0x40;
+        pattern->simple_btn_low |= 0x40;
         break;
     case NS_BUTTON_R:
-        pattern->std_btn_right = 0x40;
-        pattern->simple_btn_high = 0x40;
+        pattern->std_btn_right |= 0x40;
+        pattern->simple_btn_high |= 0x40;
         break;
     case NS_BUTTON_ZL:
-        pattern->std_btn_left = 0x80;
-        pattern->simple_btn_low = 0x80;
+        pattern->std_btn_left |= 0x80;
+        pattern->simple_btn_low |= 0x80;
         break;
     case NS_BUTTON_ZR:
-        pattern->std_btn_right = 0x80;
-        pattern->simple_btn_high = 0x80;
+        pattern->std_btn_right |= 0x80;
+        pattern->simple_btn_high |= 0x80;
         break;
     case NS_BUTTON_MINUS:
-        pattern->std_btn_shared = 0x01;
-        pattern->simple_btn_low = 0x01;
+        pattern->std_btn_shared |= 0x01;
+        pattern->simple_btn_low |= 0x01;
         break;
     case NS_BUTTON_PLUS:
-        pattern->std_btn_shared = 0x02;
-        pattern->simple_btn_low = 0x02;
+        pattern->std_btn_shared |= 0x02;
+        pattern->simple_btn_low |= 0x02;
         break;
     case NS_BUTTON_L_STICK:
-        pattern->std_btn_shared = 0x08;
-        pattern->simple_btn_low = 0x20;
+        pattern->std_btn_shared |= 0x08;
+        pattern->simple_btn_low |= 0x20;
         break;
     case NS_BUTTON_R_STICK:
-        pattern->std_btn_shared = 0x04;
-        pattern->simple_btn_high = 0x20;
+        pattern->std_btn_shared |= 0x04;
+        pattern->simple_btn_high |= 0x20;
         break;
     case NS_BUTTON_HOME:
-        pattern->std_btn_shared = 0x10;
-        pattern->simple_btn_low = 0x10;
+        pattern->std_btn_shared |= 0x10;
+        pattern->simple_btn_low |= 0x10;
         break;
     case NS_BUTTON_CAPTURE:
-        pattern->std_btn_shared = 0x20;
-        pattern->simple_btn_high = 0x10;
+        pattern->std_btn_shared |= 0x20;
+        pattern->simple_btn_high |= 0x10;
         break;
     case NS_BUTTON_UP:
-        pattern->std_btn_left = 0x02;
-        pattern->simple_hat = 0x00;
+        pattern->std_btn_left |= 0x02;
         break;
     case NS_BUTTON_DOWN:
-        pattern->std_btn_left = 0x01;
-        pattern->simple_hat = 0x04;
+        pattern->std_btn_left |= 0x01;
         break;
     case NS_BUTTON_LEFT:
-        pattern->std_btn_left = 0x08;
-        pattern->simple_hat = 0x06;
+        pattern->std_btn_left |= 0x08;
         break;
     case NS_BUTTON_RIGHT:
-        pattern->std_btn_left = 0x04;
-        pattern->simple_hat = 0x02;
+        pattern->std_btn_left |= 0x04;
         break;
     case NS_BUTTON_NONE:
     default:
@@ -208,74 +238,52 @@ static void ns_pattern_apply_button(ns_auto_key_pattern_t *pattern, ns_button_id
     }
 }
 
-static void ns_build_pattern_from_test_item(const ns_auto_test_item_t *item, ns_auto_key_pattern_t *pattern)
+static void ns_pattern_update_hat(ns_auto_key_pattern_t *pattern)
 {
-    ns_pattern_reset(pattern);
-    pattern->name = item->name;
-    pattern->std_lx = item->std_lx;
-    pattern->std_ly = item->std_ly;
-    pattern->std_rx = item->std_rx;
-    pattern->std_ry = item->std_ry;
-    ns_pattern_apply_button(pattern, item->button);
+    /* Index: up | right << 1 | down << 2 | left << 3, from std_btn_left. */
+    static const uint8_t s_hat_lut[16] = {
+        0x08, 0x00, 0x02, 0x01, 0x04, 0x08, 0x03, 0x02,
+        0x06, 0x07, 0x08, 0x00, 0x05, 0x06, 0x04, 0x08,
+    };
+    uint8_t dpad = pattern->std_btn_left;
+    uint8_t index = (uint8_t)(((dpad & 0x02) ? 0x01 : 0) |
+                              ((dpad & 0x04) ? 0x02 : 0) |
+                              ((dpad & 0x01) ? 0x04 : 0) |
+                              ((dpad & 0x08) ? 0x08 : 0));
+
+    pattern->simple_hat = s_hat_lut[index];
 }
 
-static void ns_input_init(void)
+static void ns_build_pattern_from_input(const ns_input_state_t *input, ns_auto_key_pattern_t *pattern)
 {
-    if (s_input_inited) {
-        return;
+    ns_pattern_reset(pattern);
+    pattern->name = "INPUT_STATE";
+    pattern->std_lx = input->lx & NS_STICK_MAX;
+    pattern->std_ly = input->ly & NS_STICK_MAX;
+    pattern->std_rx = input->rx & NS_STICK_MAX;
+    pattern->std_ry = input->ry & NS_STICK_MAX;
+    for (uint32_t button = NS_BUTTON_Y; button <= NS_BUTTON_RIGHT; button++) {
+        if (input->buttons & NS_BUTTON_MASK(button)) {
+            ns_pattern_apply_button(pattern, (ns_button_id_t)button);
+        }
     }
-
-    gpio_config_t io_conf = {
-        .pin_bit_mask = 1ULL << NS_BOOT_BUTTON_GPIO,
-        .mode = GPIO_MODE_INPUT,
-        .pull_up_en = GPIO_PULLUP_ENABLE,
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&io_conf);
-    s_input_inited = true;
 }
 
-static bool ns_button_a_pressed(void)
+/* Debounced BOOT key from ns_gpio_buttons.c; the report path does not read pins. */
+static bool ns_trigger_pressed(void)
 {
-    bool gpio_pressed = (gpio_get_level(NS_BOOT_BUTTON_GPIO) == 0);
-    bool effective_pressed = gpio_pressed;
-
-    if (!s_a_log_inited) {
-        s_gpio_a_last = gpio_pressed;
-        s_effective_a_last = effective_pressed;
-        s_a_log_inited = true;
-    }
+    bool pressed = ns_gpio_buttons_trigger_pressed();
 
-    if (gpio_pressed != s_gpio_a_last) {
-        ESP_LOGI(TAG, "GPIO0 A key: %s", gpio_pressed ? "pressed" : "released");
-        s_gpio_a_last = gpio_pressed;
+    if (pressed != s_trigger_last) {
+        ESP_LOGI(TAG, "BOOT key: %s", pressed ? "pressed" : "released");
+        s_trigger_last = pressed;
     }
-
-    if (effective_pressed != s_effective_a_last) {
-        ESP_LOGI(TAG, "A output: %s", effective_pressed ? "pressed" : "released");
-        s_effective_a_last = effective_pressed;
-    }
-
-    return effective_pressed;
+    return pressed;
 }
 
-static const ns_auto_key_pattern_t *ns_get_auto_key_pattern(void)
+static const ns_auto_test_item_t *ns_auto_test_step(int64_t now)
 {
-    static const ns_auto_test_item_t s_manual_item = {
-        "MANUAL_BUTTON", NS_BUTTON_NONE, NS_STICK_CENTER, NS_STICK_CENTER, NS_STICK_CENTER, NS_STICK_CENTER, false
-    };
-    const ns_auto_test_item_t *item = NULL;
-    bool trigger_pressed = ns_button_a_pressed();
-    int64_t now = esp_timer_get_time();
-
-    if (s_manual_button_override) {
-        ns_auto_test_item_t manual_item = s_manual_item;
-        manual_item.button = s_manual_button;
-        s_auto_imu_enabled = false;
-        ns_build_pattern_from_test_item(&manual_item, &s_auto_key_pattern_current);
-        return &s_auto_key_pattern_current;
-    }
+    bool trigger_pressed = ns_trigger_pressed();
 
     if (trigger_pressed && !s_auto_key_trigger_prev) {
         s_auto_key_index = 0;
@@ -299,15 +307,76 @@ static const ns_auto_key_pattern_t *ns_get_auto_key_pattern(void)
         ESP_LOGI(TAG, "auto key test switch -> %s", s_auto_test_items[s_auto_key_index].name);
     }
 
-    item = &s_auto_test_items[s_auto_key_index];
-    s_auto_imu_enabled = item->enable_imu_test;
-    ns_build_pattern_from_test_item(item, &s_auto_key_pattern_current);
-    return &s_auto_key_pattern_current;
+    return &s_auto_test_items[s_auto_key_index];
+}
+
+static void ns_publish_pattern(const ns_auto_key_pattern_t *pattern)
+{
+    taskENTER_CRITICAL(&s_pattern_lock);
+    s_pattern_published_valid = (pattern != NULL);
+    if (pattern != NULL) {
+        s_pattern_published = *pattern;
+    }
+    taskEXIT_CRITICAL(&s_pattern_lock);
 }
 
-static bool ns_hid_ready(void)
+static bool ns_get_published_pattern(ns_auto_key_pattern_t *out)
 {
-    return tud_mounted() && tud_hid_ready();
+    bool valid;
+
+    taskENTER_CRITICAL(&s_pattern_lock);
+    valid = s_pattern_published_valid;
+    *out = s_pattern_published;
+    taskEXIT_CRITICAL(&s_pattern_lock);
+    return valid;
+}
+
+/*
+ * Report loop only: steps the auto test and runs the one layer merge per
+ * report (sources such as the macro and jitter buffer advance on it), then
+ * publishes the result for replies sent from other tasks.
+ */
+static const ns_auto_key_pattern_t *ns_update_auto_key_pattern(void)
+{
+    int64_t now = esp_timer_get_time();
+    const ns_auto_test_item_t *item = ns_auto_test_step(now);
+    ns_input_state_t input;
+    uint32_t contributors = 0;
+
+    /* The auto test is the fallback layer; any other source masks it. */
+    if (item != NULL) {
+        ns_input_state_t test_input = {
+            .buttons = item->button != NS_BUTTON_NONE ? NS_BUTTON_MASK(item->button) : 0,
+            .lx = item->std_lx,
+            .ly = item->std_ly,
+            .rx = item->std_rx,
+            .ry = item->std_ry,
+        };
+        ns_input_layer_set(NS_INPUT_LAYER_AUTO_TEST, &test_input, 0);
+    } else {
+        ns_input_layer_clear(NS_INPUT_LAYER_AUTO_TEST);
+    }
+
+    s_imu_override_active = false;
+    s_auto_imu_enabled = false;
+    if (!ns_input_layer_merge(now, &input, &contributors)) {
+        ns_publish_pattern(NULL);
+        return NULL;
+    }
+
+    ns_build_pattern_from_input(&input, &s_auto_key_pattern_current);
+    ns_pattern_update_hat(&s_auto_key_pattern_current);
+    if (contributors == (1U << NS_INPUT_LAYER_AUTO_TEST)) {
+        s_auto_key_pattern_current.name = item->name;
+        s_auto_imu_enabled = item->enable_imu_test;
+    }
+    if (input.imu_override) {
+        memcpy(&s_imu_override[0], input.accel, sizeof(input.accel));
+        memcpy(&s_imu_override[3], input.gyro, sizeof(input.gyro));
+        s_imu_override_active = true;
+    }
+    ns_publish_pattern(&s_auto_key_pattern_current);
+    return &s_auto_key_pattern_current;
 }
 
 static void ns_pack_stick(uint8_t out3[3], uint16_t x, uint16_t y)
@@ -349,6 +418,17 @@ static void ns_fill_imu_payload(uint8_t *payload, size_t len)
         return;
     }
 
+    if (s_imu_override_active) {
+        /* Streamed IMU is a single sample; repeat it for all three slots. */
+        for (uint8_t sample = 0; sample < NS_STD_IMU_SAMPLE_COUNT; sample++) {
+            uint8_t *imu = &payload[NS_STD_IMU_OFFSET + sample * NS_STD_IMU_SAMPLE_BYTES];
+            for (uint8_t axis = 0; axis < 6; axis++) {
+                ns_pack_i16le(&imu[axis * 2U], s_imu_override[axis]);
+            }
+        }
+        return;
+    }
+
     int16_t log_accel_x = 0;
     int16_t log_accel_y = 0;
     int16_t log_accel_z = 0;
@@ -397,16 +477,26 @@ static void ns_fill_imu_payload(uint8_t *payload, size_t len)
 
 static void ns_send_report(uint8_t report_id, const uint8_t *payload, size_t len)
 {
-    if (!ns_hid_ready()) {
+    if (!tud_mounted()) {
+        ns_metrics_report(report_id, false);
         return;
     }
-    tud_hid_report(report_id, payload, len);
+    /* Input state only matters while fresh: a newer one replaces it if the endpoint is
+       still busy. Replies must all arrive, in order, so they queue ahead of it. */
+    if (report_id == NS_REPORT_ID_STD) {
+        ns_metrics_report(report_id, tud_hid_report_latest(report_id, payload, (uint16_t)len));
+        return;
+    }
+    if (!tud_hid_report_queued(report_id, payload, (uint16_t)len)) {
+        ns_metrics_inc(NS_METRIC_HID_BUSY);
+        ns_metrics_report(report_id, false);
+        return;
+    }
+    ns_metrics_report(report_id, true);
 }
 
-static void ns_fill_base_payload(uint8_t *payload, size_t len)
+static void ns_fill_base_payload(uint8_t *payload, size_t len, const ns_auto_key_pattern_t *pattern)
 {
-    const ns_auto_key_pattern_t *pattern = ns_get_auto_key_pattern();
-
     if (len < 12) {
         return;
     }
@@ -461,12 +551,15 @@ static void ns_send_subcmd_reply(uint8_t ack_type, uint8_t subcmd_id,
 {
     uint8_t payload[NS_USB_REPLY_PAYLOAD_LEN] = {0};
     size_t max_len = NS_USB_REPLY_PAYLOAD_LEN - 14;
+    ns_auto_key_pattern_t pattern;
+    bool has_pattern = ns_get_published_pattern(&pattern);
 
     if (data_len > max_len) {
         data_len = max_len;
     }
 
-    ns_fill_base_payload(payload, sizeof(payload));
+    /* Runs on the TinyUSB task: use what the report loop merged last, never merge here. */
+    ns_fill_base_payload(payload, sizeof(payload), has_pattern ? &pattern : NULL);
     payload[12] = ack_type;
     payload[13] = subcmd_id;
     if (data_len) {
@@ -481,18 +574,17 @@ static void ns_send_subcmd_reply(uint8_t ack_type, uint8_t subcmd_id,
     ns_send_report(NS_REPORT_ID_SUBCMD_REPLY, payload, sizeof(payload));
 }
 
-static void ns_send_std_report(void)
+static void ns_send_std_report(const ns_auto_key_pattern_t *pattern)
 {
     uint8_t payload[NS_STD_PAYLOAD_LEN] = {0};
-    ns_fill_base_payload(payload, sizeof(payload));
+    ns_fill_base_payload(payload, sizeof(payload), pattern);
     ns_fill_imu_payload(payload, sizeof(payload));
     ns_send_report(NS_REPORT_ID_STD, payload, sizeof(payload));
 }
 
-static void ns_send_simple_hid_report(void)
+static void ns_send_simple_hid_report(const ns_auto_key_pattern_t *pattern)
 {
     uint8_t payload[11] = {0};
-    const ns_auto_key_pattern_t *pattern = ns_get_auto_key_pattern();
     uint16_t lx16 = ns_stick_12_to_16(pattern ? pattern->std_lx : NS_STICK_CENTER);
     uint16_t ly16 = ns_stick_12_to_16(pattern ? pattern->std_ly : NS_STICK_CENTER);
     uint16_t rx16 = ns_stick_12_to_16(pattern ? pattern->std_rx : NS_STICK_CENTER);
@@ -538,6 +630,33 @@ static bool ns_spi_read_rom(uint32_t addr, uint8_t *out, uint8_t len)
     return true;
 }
 
+/*
+ * Output reports 0x01 and 0x10 carry 8 bytes of HD rumble after the packet
+ * counter, 4 per side: HF freq, HF freq MSB | HF amp << 1, LF freq | LF amp LSB << 7,
+ * 0x40 + LF amp >> 1. Returns the strongest encoded amplitude (0 = silent, ~100 max).
+ */
+static uint32_t ns_rumble_amplitude(const uint8_t *data, size_t len)
+{
+    uint32_t amp = 0;
+
+    if (len < 9) {
+        return 0;
+    }
+    for (uint8_t side = 0; side < 2; side++) {
+        const uint8_t *r = &data[1 + side * 4U];
+        uint32_t hf_amp = (uint32_t)(r[1] >> 1);
+        uint32_t lf_amp = r[3] >= 0x40 ? ((uint32_t)(r[3] - 0x40) << 1) | (uint32_t)(r[2] >> 7) : 0;
+
+        if (hf_amp > amp) {
+            amp = hf_amp;
+        }
+        if (lf_amp > amp) {
+            amp = lf_amp;
+        }
+    }
+    return amp;
+}
+
 static void ns_handle_subcmd(const uint8_t *data, size_t len)
 {
     if (len < 10) {
@@ -549,6 +668,8 @@ static void ns_handle_subcmd(const uint8_t *data, size_t len)
     uint8_t subcmd_id = data[9];
 
     ESP_LOGI(TAG, "subcmd 0x%02X len=%u", subcmd_id, (unsigned)subcmd_len);
+    ns_metrics_subcmd(subcmd_id);
+    ns_rules_eval(NS_RULE_ON_SUBCMD, subcmd_id);
 
     switch (subcmd_id) {
     case NS_SUBCMD_REQ_DEV_INFO: {
@@ -565,6 +686,8 @@ static void ns_handle_subcmd(const uint8_t *data, size_t len)
         if (subcmd_len >= 1) {
             s_state.report_mode = subcmd_data[0];
             ESP_LOGI(TAG, "set report mode 0x%02X", s_state.report_mode);
+            ns_events_publish_changed(NS_EVENT_REPORT_MODE, s_state.report_mode);
+            ns_rules_eval(NS_RULE_ON_REPORT_MODE, s_state.report_mode);
         }
         ns_send_subcmd_reply(0x80, subcmd_id, NULL, 0);
         break;
@@ -605,6 +728,8 @@ static void ns_handle_subcmd(const uint8_t *data, size_t len)
     case NS_SUBCMD_SET_PLAYER_LIGHTS:
         if (subcmd_len >= 1) {
             s_state.player_lights = subcmd_data[0];
+            ns_events_publish_changed(NS_EVENT_PLAYER_LIGHTS, s_state.player_lights);
+            ns_rules_eval(NS_RULE_ON_PLAYER_LIGHTS, s_state.player_lights);
         }
         ns_send_subcmd_reply(0x80, subcmd_id, NULL, 0);
         break;
@@ -614,12 +739,16 @@ static void ns_handle_subcmd(const uint8_t *data, size_t len)
             if (s_state.imu_enabled) {
                 s_imu_log_pending = true;
             }
+            ns_events_publish_changed(NS_EVENT_IMU_ENABLE, s_state.imu_enabled);
+            ns_rules_eval(NS_RULE_ON_IMU, s_state.imu_enabled);
         }
         ns_send_subcmd_reply(0x80, subcmd_id, NULL, 0);
         break;
     case NS_SUBCMD_ENABLE_VIBRATION:
         if (subcmd_len >= 1) {
             s_state.vibration_enabled = (subcmd_data[0] != 0);
+            ns_events_publish_changed(NS_EVENT_VIBRATION_ENABLE, s_state.vibration_enabled);
+            ns_rules_eval(NS_RULE_ON_VIBRATION, s_state.vibration_enabled);
         }
         ns_send_subcmd_reply(0x80, subcmd_id, NULL, 0);
         break;
@@ -639,6 +768,9 @@ static void ns_handle_usb_cmd(const uint8_t *data, size_t len)
     uint8_t cmd = data[0];
 
     ESP_LOGI(TAG, "usb cmd 0x%02X", cmd);
+    if (s_handshake_start_us == 0 && cmd != NS_USB_CMD_NO_TIMEOUT) {
+        s_handshake_start_us = esp_timer_get_time();
+    }
 
     switch (cmd) {
     case NS_USB_CMD_CONN_STATUS: {
@@ -658,11 +790,23 @@ static void ns_handle_usb_cmd(const uint8_t *data, size_t len)
         s_state.usb_no_timeout = true;
         s_state.input_streaming = true;
         /* nscon starts input stream after this command. */
+        ns_events_publish_changed(NS_EVENT_HANDSHAKE, 1);
+        ns_boot_mark(NS_BOOT_USB_HANDSHAKE);
+        ns_rules_eval(NS_RULE_ON_HANDSHAKE, 1);
+        if (s_handshake_start_us != 0) {
+            uint32_t handshake_us = (uint32_t)(esp_timer_get_time() - s_handshake_start_us);
+
+            ns_metrics_set_gauge(NS_METRIC_GAUGE_HANDSHAKE_LAST_US, (int32_t)handshake_us);
+            ns_metrics_inc(NS_METRIC_HANDSHAKE_COUNT);
+            ns_metrics_add(NS_METRIC_HANDSHAKE_US_SUM, handshake_us);
+            s_handshake_start_us = 0;
+        }
         break;
     case NS_USB_CMD_ENABLE_TIMEOUT:
         s_state.usb_no_timeout = false;
         s_state.input_streaming = false;
         /* nscon stops input stream after this command. */
+        ns_events_publish_changed(NS_EVENT_HANDSHAKE, 0);
         break;
     case NS_USB_CMD_RESET:
         ns_protocol_init();
@@ -676,8 +820,6 @@ static void ns_handle_usb_cmd(const uint8_t *data, size_t len)
 
 void ns_protocol_init(void)
 {
-    ns_input_init();
-
     s_state.timer = 0;
     s_state.report_mode = NS_REPORT_ID_STD;
     s_state.input_streaming = false;
@@ -692,41 +834,66 @@ void ns_protocol_init(void)
     s_auto_key_trigger_prev = false;
     s_auto_key_last_switch_us = 0;
     s_auto_key_index = 0;
-    s_manual_button_override = false;
-    s_manual_button = NS_BUTTON_NONE;
     s_imu_phase = 0;
     s_imu_log_pending = false;
     s_auto_imu_enabled = false;
-    s_a_log_inited = false;
+    s_imu_override_active = false;
 
     memset(s_last_subcmd_reply, 0, sizeof(s_last_subcmd_reply));
     s_last_subcmd_reply_len = 0;
+
+    /* A reset drops the session, so clients see it fall back to defaults. */
+    ns_events_publish_changed(NS_EVENT_HANDSHAKE, 0);
+    ns_events_publish_changed(NS_EVENT_REPORT_MODE, s_state.report_mode);
+    ns_events_publish_changed(NS_EVENT_PLAYER_LIGHTS, s_state.player_lights);
+    ns_events_publish_changed(NS_EVENT_IMU_ENABLE, 0);
+    ns_events_publish_changed(NS_EVENT_VIBRATION_ENABLE, 0);
 }
 
 void ns_protocol_periodic(void)
 {
+    const ns_auto_key_pattern_t *pattern;
+
     if (!tud_mounted()) {
         return;
     }
     if (!s_state.input_streaming) {
+        /* Replies outside streaming carry neutral input, not the state from before it stopped. */
+        ns_publish_pattern(NULL);
         return;
     }
 
+    pattern = ns_update_auto_key_pattern();
     if (s_state.report_mode == NS_REPORT_ID_STD) {
-        ns_send_std_report();
+        ns_send_std_report(pattern);
     } else if (s_state.report_mode == 0x3F) {
-        ns_send_simple_hid_report();
+        ns_send_simple_hid_report(pattern);
     }
 }
 
-void ns_protocol_set_test_button(ns_button_id_t button)
+const char *ns_protocol_button_name(ns_button_id_t button)
 {
-    if (button > NS_BUTTON_RIGHT) {
-        return;
+    for (size_t i = 0; i < sizeof(s_button_name_map) / sizeof(s_button_name_map[0]); i++) {
+        if (s_button_name_map[i].button == button) {
+            return s_button_name_map[i].name;
+        }
     }
+    return "UNKNOWN";
+}
 
-    s_manual_button = button;
-    s_manual_button_override = (button != NS_BUTTON_NONE);
+bool ns_protocol_button_from_name(const char *name, ns_button_id_t *out_button)
+{
+    if (name == NULL || out_button == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i < sizeof(s_button_name_map) / sizeof(s_button_name_map[0]); i++) {
+        if (strcasecmp(name, s_button_name_map[i].name) == 0) {
+            *out_button = s_button_name_map[i].button;
+            return true;
+        }
+    }
+    return false;
 }
 
 uint16_t ns_protocol_get_report(uint8_t instance,
@@ -779,10 +946,11 @@ void ns_protocol_set_report(uint8_t instance,
     }
 
     if (rid == NS_REPORT_ID_OUTPUT_SUBCMD) {
+        ns_rules_eval(NS_RULE_ON_RUMBLE, ns_rumble_amplitude(p, len));
         ns_handle_subcmd(p, len);
     } else if (rid == NS_REPORT_ID_OUTPUT_USB_CMD) {
         ns_handle_usb_cmd(p, len);
     } else if (rid == NS_REPORT_ID_OUTPUT_RUMBLE_ONLY) {
-        /* Accepted but no-op in the framework baseline. */
+        ns_rules_eval(NS_RULE_ON_RUMBLE, ns_rumble_amplitude(p, len));
     }
 }
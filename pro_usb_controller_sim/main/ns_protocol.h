@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -27,9 +28,34 @@ typedef enum {
     NS_BUTTON_RIGHT,
 } ns_button_id_t;
 
+/* Bit position in ns_input_state_t.buttons equals the ns_button_id_t value. */
+#define NS_BUTTON_MASK(_button) ((uint32_t)1U << (uint32_t)(_button))
+#define NS_BUTTON_MASK_ALL      (((uint32_t)1U << (NS_BUTTON_RIGHT + 1)) - 2U)
+
+/* Full controller state pushed by streaming access layers. */
+typedef struct {
+    uint32_t buttons;
+    uint16_t lx;
+    uint16_t ly;
+    uint16_t rx;
+    uint16_t ry;
+    bool imu_override;
+    int16_t accel[3];
+    int16_t gyro[3];
+} ns_input_state_t;
+
+/*
+ * Optional per-report input provider (e.g. a playout buffer), attached to an
+ * input layer. Called from the report path with the current esp_timer time;
+ * returning false falls back to the state stored in the layer.
+ */
+typedef bool (*ns_input_source_t)(int64_t now_us, ns_input_state_t *out);
+
 void ns_protocol_init(void);
 void ns_protocol_periodic(void);
-void ns_protocol_set_test_button(ns_button_id_t button);
+/* Button names as used by the HTTP API ("A", "ZR", "HOME", ...), case-insensitive. */
+const char *ns_protocol_button_name(ns_button_id_t button);
+bool ns_protocol_button_from_name(const char *name, ns_button_id_t *out_button);
 
 uint16_t ns_protocol_get_report(uint8_t instance,
                                 uint8_t report_id,
@@ -0,0 +1,170 @@
+#include "ns_rules.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+#include "ns_input_layer.h"
+#include "ns_input_sched.h"
+#include "ns_macro.h"
+
+static const char *TAG = "NS_RULES";
+
+/* Rules fired by one event at most; bounds the stack used in the USB task. */
+#define NS_RULES_FIRE_MAX 4
+
+typedef struct {
+    ns_rule_t rule;
+    bool level_high;
+    bool spent;
+    int64_t last_fire_us;
+} ns_rule_slot_t;
+
+static portMUX_TYPE s_rules_lock = portMUX_INITIALIZER_UNLOCKED;
+static ns_rule_slot_t s_rules[NS_RULES_MAX];
+static uint8_t s_rule_count;
+static uint32_t s_evaluated;
+static uint32_t s_fired[NS_RULES_MAX];
+
+static const char *s_trigger_names[NS_RULE_TRIGGER_COUNT] = {
+    [NS_RULE_ON_SUBCMD] = "subcmd",
+    [NS_RULE_ON_RUMBLE] = "rumble",
+    [NS_RULE_ON_REPORT_MODE] = "report_mode",
+    [NS_RULE_ON_PLAYER_LIGHTS] = "player_lights",
+    [NS_RULE_ON_IMU] = "imu",
+    [NS_RULE_ON_VIBRATION] = "vibration",
+    [NS_RULE_ON_HANDSHAKE] = "handshake",
+};
+
+const char *ns_rules_trigger_name(ns_rule_trigger_t trigger)
+{
+    return trigger < NS_RULE_TRIGGER_COUNT ? s_trigger_names[trigger] : "unknown";
+}
+
+bool ns_rules_trigger_from_name(const char *name, size_t len, ns_rule_trigger_t *out)
+{
+    for (uint8_t i = 0; i < NS_RULE_TRIGGER_COUNT; i++) {
+        if (strlen(s_trigger_names[i]) == len && strncmp(s_trigger_names[i], name, len) == 0) {
+            *out = (ns_rule_trigger_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ns_rules_set(const ns_rule_t *rules, uint8_t count)
+{
+    if (count > NS_RULES_MAX || (count > 0 && rules == NULL)) {
+        return false;
+    }
+
+    taskENTER_CRITICAL(&s_rules_lock);
+    memset(s_rules, 0, sizeof(s_rules));
+    memset(s_fired, 0, sizeof(s_fired));
+    for (uint8_t i = 0; i < count; i++) {
+        s_rules[i].rule = rules[i];
+    }
+    s_rule_count = count;
+    s_evaluated = 0;
+    taskEXIT_CRITICAL(&s_rules_lock);
+
+    ESP_LOGI(TAG, "%u rules loaded", (unsigned)count);
+    return true;
+}
+
+static bool ns_rule_matches(const ns_rule_t *rule, uint32_t value)
+{
+    switch (rule->match) {
+    case NS_RULE_MATCH_EQ:
+        return value == rule->value;
+    case NS_RULE_MATCH_GE:
+        return value >= rule->value;
+    case NS_RULE_MATCH_ANY:
+    default:
+        return true;
+    }
+}
+
+static void ns_rule_fire(const ns_rule_t *rule, int64_t now)
+{
+    int64_t apply_at = now + (int64_t)rule->delay_ms * 1000LL;
+
+    if (rule->action == NS_RULE_ACTION_MACRO) {
+        /* Runs in the TinyUSB task; the main loop starts it. */
+        ns_macro_request_start();
+        return;
+    }
+
+    /* Undelayed actions bypass the scheduler so the very next report carries them. */
+    if (rule->delay_ms == 0) {
+        ns_input_layer_set(NS_INPUT_LAYER_RULES, &rule->state, 0);
+    } else {
+        ns_input_sched_push(NS_INPUT_LAYER_RULES, apply_at, &rule->state);
+    }
+    if (rule->hold_ms > 0) {
+        ns_input_sched_push(NS_INPUT_LAYER_RULES, apply_at + (int64_t)rule->hold_ms * 1000LL, NULL);
+    }
+}
+
+void ns_rules_eval(ns_rule_trigger_t trigger, uint32_t value)
+{
+    ns_rule_t fire[NS_RULES_FIRE_MAX];
+    uint8_t fire_count = 0;
+    int64_t now;
+
+    if (s_rule_count == 0) {
+        return;
+    }
+
+    now = esp_timer_get_time();
+    taskENTER_CRITICAL(&s_rules_lock);
+    s_evaluated++;
+    for (uint8_t i = 0; i < s_rule_count && fire_count < NS_RULES_FIRE_MAX; i++) {
+        ns_rule_slot_t *slot = &s_rules[i];
+        bool matched;
+
+        if (slot->rule.trigger != trigger || slot->spent) {
+            continue;
+        }
+
+        matched = ns_rule_matches(&slot->rule, value);
+        if (trigger == NS_RULE_ON_RUMBLE) {
+            bool rising = matched && !slot->level_high;
+
+            slot->level_high = matched;
+            matched = rising;
+        }
+        if (!matched) {
+            continue;
+        }
+        if (slot->last_fire_us != 0 &&
+            (now - slot->last_fire_us) < (int64_t)slot->rule.cooldown_ms * 1000LL) {
+            continue;
+        }
+
+        slot->last_fire_us = now;
+        slot->spent = slot->rule.once;
+        s_fired[i]++;
+        fire[fire_count++] = slot->rule;
+    }
+    taskEXIT_CRITICAL(&s_rules_lock);
+
+    for (uint8_t i = 0; i < fire_count; i++) {
+        ns_rule_fire(&fire[i], now);
+    }
+}
+
+void ns_rules_get_status(ns_rules_status_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_rules_lock);
+    out->count = s_rule_count;
+    out->evaluated = s_evaluated;
+    memcpy(out->fired, s_fired, sizeof(out->fired));
+    taskEXIT_CRITICAL(&s_rules_lock);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ns_protocol.h"
+
+#define NS_RULES_MAX 16
+
+typedef enum {
+    NS_RULE_ON_SUBCMD = 0,
+    /* Value is the strongest encoded rumble amplitude, 0 (silent) .. 100. */
+    NS_RULE_ON_RUMBLE,
+    NS_RULE_ON_REPORT_MODE,
+    NS_RULE_ON_PLAYER_LIGHTS,
+    NS_RULE_ON_IMU,
+    NS_RULE_ON_VIBRATION,
+    NS_RULE_ON_HANDSHAKE,
+    NS_RULE_TRIGGER_COUNT,
+} ns_rule_trigger_t;
+
+typedef enum {
+    NS_RULE_MATCH_ANY = 0,
+    NS_RULE_MATCH_EQ,
+    NS_RULE_MATCH_GE,
+} ns_rule_match_t;
+
+typedef enum {
+    NS_RULE_ACTION_STATE = 0,
+    NS_RULE_ACTION_MACRO,
+} ns_rule_action_t;
+
+typedef struct {
+    ns_rule_trigger_t trigger;
+    ns_rule_match_t match;
+    uint32_t value;
+    ns_rule_action_t action;
+    ns_input_state_t state;
+    uint32_t hold_ms;
+    uint32_t delay_ms;
+    uint32_t cooldown_ms;
+    bool once;
+} ns_rule_t;
+
+typedef struct {
+    uint8_t count;
+    uint32_t evaluated;
+    uint32_t fired[NS_RULES_MAX];
+} ns_rules_status_t;
+
+/*
+ * Rules are matched in the protocol layer as host output arrives and their
+ * action is applied before the next input report is built. Rumble rules fire
+ * on the rising edge of their predicate; all other triggers fire per event.
+ */
+bool ns_rules_set(const ns_rule_t *rules, uint8_t count);
+void ns_rules_eval(ns_rule_trigger_t trigger, uint32_t value);
+void ns_rules_get_status(ns_rules_status_t *out);
+const char *ns_rules_trigger_name(ns_rule_trigger_t trigger);
+bool ns_rules_trigger_from_name(const char *name, size_t len, ns_rule_trigger_t *out);
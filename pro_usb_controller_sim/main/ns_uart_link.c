@@ -0,0 +1,527 @@
+#include "ns_uart_link.h"
+
+#include <string.h>
+
+#include "driver/uart.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "ns_input_layer.h"
+#include "ns_input_sched.h"
+#include "ns_macro.h"
+#include "ns_metrics.h"
+#include "ns_proto.h"
+
+static const char *TAG = "NS_UART_LINK";
+
+#define NS_UART_LINK_PORT UART_NUM_1
+#define NS_UART_LINK_TX_GPIO 17
+#define NS_UART_LINK_RX_GPIO 18
+#define NS_UART_LINK_RX_BUF 4096
+#define NS_UART_LINK_TX_BUF 1024
+#define NS_UART_LINK_EVENT_QUEUE 16
+/* Idle time, in symbols, after which the driver hands over a partial FIFO. */
+#define NS_UART_LINK_RX_TIMEOUT_SYMBOLS 2
+#define NS_UART_LINK_RX_FULL_THRESHOLD 64
+#define NS_UART_LINK_TASK_STACK 4096
+#define NS_UART_LINK_TASK_PRIO 6
+/* Same contract as the UDP stream: a silent host releases its input. */
+#define NS_UART_LINK_LEASE_MS 500
+#define NS_UART_LINK_CHUNK 256
+
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static ns_uart_link_stats_t s_stats;
+static int64_t s_last_frame_us;
+static bool s_task_started;
+
+static QueueHandle_t s_event_queue;
+/* Raw COBS bytes of the frame being received; +2 for COBS overhead. */
+static uint8_t s_rx_frame[NS_UART_LINK_MAX_FRAME + 2];
+static size_t s_rx_len;
+static bool s_rx_discard;
+/* Baseline for DELTA frames. */
+static ns_input_state_t s_state;
+static char *s_macro_src;
+static uint32_t s_macro_len;
+
+#define NS_UART_STAT_ADD(_field, _value)        \
+    do {                                        \
+        taskENTER_CRITICAL(&s_stats_lock);      \
+        s_stats._field += (_value);             \
+        taskEXIT_CRITICAL(&s_stats_lock);       \
+    } while (0)
+
+static uint16_t ns_rd_u16le(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t ns_rd_u32le(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t ns_rd_u64le(const uint8_t *p)
+{
+    return (uint64_t)ns_rd_u32le(p) | ((uint64_t)ns_rd_u32le(&p[4]) << 32);
+}
+
+static void ns_wr_u64le(uint8_t *p, uint64_t value)
+{
+    for (uint8_t i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(value >> (i * 8U));
+    }
+}
+
+/* CRC-16/CCITT-FALSE, four bits per step. */
+static uint16_t ns_uart_crc16(const uint8_t *data, size_t len)
+{
+    static const uint16_t nibble[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < len; i++) {
+        crc = (uint16_t)((crc << 4) ^ nibble[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ nibble[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+/* In-place COBS decode (output never outgrows input); returns 0 on a malformed frame. */
+static size_t ns_cobs_decode(uint8_t *buf, size_t len)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < len) {
+        uint8_t code = buf[in++];
+
+        if (code == 0 || in + code - 1U > len) {
+            return 0;
+        }
+        for (uint8_t i = 1; i < code; i++) {
+            buf[out++] = buf[in++];
+        }
+        if (code != 0xFF && in < len) {
+            buf[out++] = 0;
+        }
+    }
+    return out;
+}
+
+static size_t ns_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t code_at = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] != 0) {
+            dst[out++] = src[i];
+            code++;
+        }
+        if (src[i] == 0 || code == 0xFF) {
+            dst[code_at] = code;
+            code_at = out++;
+            code = 1;
+        }
+    }
+    dst[code_at] = code;
+    dst[out++] = 0;
+    return out;
+}
+
+static void ns_uart_link_send(uint8_t type, uint8_t seq, const uint8_t *payload, size_t len)
+{
+    uint8_t frame[NS_UART_LINK_MAX_FRAME];
+    uint8_t encoded[NS_UART_LINK_MAX_FRAME + NS_UART_LINK_MAX_FRAME / 254 + 2];
+    uint16_t crc;
+
+    if (len > sizeof(frame) - 4) {
+        len = sizeof(frame) - 4;
+    }
+    frame[0] = type;
+    frame[1] = seq;
+    memcpy(&frame[2], payload, len);
+    crc = ns_uart_crc16(frame, len + 2);
+    frame[len + 2] = (uint8_t)crc;
+    frame[len + 3] = (uint8_t)(crc >> 8);
+    uart_write_bytes(NS_UART_LINK_PORT, encoded, ns_cobs_encode(frame, len + 4, encoded));
+}
+
+static void ns_uart_link_reply_status(uint8_t type, uint8_t seq, uint8_t status, const char *text)
+{
+    uint8_t payload[1 + 96];
+    size_t len = 1;
+
+    payload[0] = status;
+    if (text != NULL) {
+        size_t text_len = strnlen(text, sizeof(payload) - 1);
+        memcpy(&payload[1], text, text_len);
+        len += text_len;
+    }
+    ns_uart_link_send(type | NS_UART_REPLY, seq, payload, len);
+}
+
+static void ns_uart_link_apply(const ns_input_state_t *input)
+{
+    s_state = *input;
+    ns_input_layer_set(NS_INPUT_LAYER_UART, input, NS_UART_LINK_LEASE_MS);
+}
+
+static bool ns_uart_link_state(const uint8_t *p, size_t len)
+{
+    ns_input_state_t input = {0};
+    uint8_t flags;
+    size_t need = 13;
+
+    if (len < need) {
+        return false;
+    }
+    flags = p[12];
+    need += (flags & NS_UART_STATE_FLAG_IMU) ? 12U : 0U;
+    need += (flags & NS_UART_STATE_FLAG_AT) ? 8U : 0U;
+    if (len != need) {
+        return false;
+    }
+
+    input.buttons = ns_rd_u32le(p) & NS_BUTTON_MASK_ALL;
+    input.lx = ns_rd_u16le(&p[4]);
+    input.ly = ns_rd_u16le(&p[6]);
+    input.rx = ns_rd_u16le(&p[8]);
+    input.ry = ns_rd_u16le(&p[10]);
+    p += 13;
+    if (flags & NS_UART_STATE_FLAG_IMU) {
+        input.imu_override = true;
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            input.accel[axis] = (int16_t)ns_rd_u16le(&p[axis * 2U]);
+            input.gyro[axis] = (int16_t)ns_rd_u16le(&p[6 + axis * 2U]);
+        }
+        p += 12;
+    }
+    if (flags & NS_UART_STATE_FLAG_AT) {
+        s_state = input;
+        ns_input_sched_push(NS_INPUT_LAYER_UART, (int64_t)ns_rd_u64le(p), &input);
+        return true;
+    }
+    ns_uart_link_apply(&input);
+    return true;
+}
+
+static bool ns_uart_link_delta(const uint8_t *p, size_t len)
+{
+    ns_input_state_t input = s_state;
+    uint16_t *axes[4] = {&input.lx, &input.ly, &input.rx, &input.ry};
+    uint8_t mask;
+    size_t need = 1;
+
+    if (len < 1) {
+        return false;
+    }
+    mask = p[0];
+    need += (mask & NS_UART_DELTA_PRESS) ? 4U : 0U;
+    need += (mask & NS_UART_DELTA_RELEASE) ? 4U : 0U;
+    for (uint8_t axis = 0; axis < 4; axis++) {
+        need += (mask & (NS_UART_DELTA_LX << axis)) ? 2U : 0U;
+    }
+    if (len != need) {
+        return false;
+    }
+
+    p++;
+    if (mask & NS_UART_DELTA_PRESS) {
+        input.buttons |= ns_rd_u32le(p) & NS_BUTTON_MASK_ALL;
+        p += 4;
+    }
+    if (mask & NS_UART_DELTA_RELEASE) {
+        input.buttons &= ~ns_rd_u32le(p);
+        p += 4;
+    }
+    for (uint8_t axis = 0; axis < 4; axis++) {
+        if (mask & (NS_UART_DELTA_LX << axis)) {
+            *axes[axis] = ns_rd_u16le(p);
+            p += 2;
+        }
+    }
+    /* An empty delta is a keepalive: it renews the lease with the current state. */
+    ns_uart_link_apply(&input);
+    return true;
+}
+
+static void ns_uart_link_reset_state(void)
+{
+    memset(&s_state, 0, sizeof(s_state));
+    s_state.lx = NS_STICK_CENTER;
+    s_state.ly = NS_STICK_CENTER;
+    s_state.rx = NS_STICK_CENTER;
+    s_state.ry = NS_STICK_CENTER;
+}
+
+static void ns_uart_link_release(void)
+{
+    ns_uart_link_reset_state();
+    ns_input_sched_clear_layer(NS_INPUT_LAYER_UART);
+    ns_input_layer_clear(NS_INPUT_LAYER_UART);
+}
+
+static bool ns_uart_link_time(uint8_t seq, const uint8_t *p, size_t len, int64_t received_us)
+{
+    uint8_t reply[24];
+
+    if (len != 8) {
+        return false;
+    }
+    memcpy(reply, p, 8);
+    ns_wr_u64le(&reply[8], (uint64_t)received_us);
+    ns_wr_u64le(&reply[16], (uint64_t)esp_timer_get_time());
+    ns_uart_link_send(NS_UART_CMD_TIME | NS_UART_REPLY, seq, reply, sizeof(reply));
+    NS_UART_STAT_ADD(time_syncs, 1);
+    return true;
+}
+
+static void ns_uart_link_macro(uint8_t type, uint8_t seq, const uint8_t *p, size_t len)
+{
+    char err[96] = {0};
+
+    if (type == NS_UART_CMD_MACRO_BEGIN) {
+        uint32_t total = len == 4 ? ns_rd_u32le(p) : 0;
+
+        ns_macro_free(s_macro_src);
+        s_macro_src = NULL;
+        s_macro_len = 0;
+        if (total == 0 || total > NS_MACRO_SOURCE_MAX) {
+            ns_uart_link_reply_status(type, seq, NS_UART_STATUS_BAD_ARGS, NULL);
+            return;
+        }
+        s_macro_src = ns_macro_alloc(total + 1U);
+        if (s_macro_src == NULL) {
+            ns_uart_link_reply_status(type, seq, NS_UART_STATUS_NO_MEMORY, NULL);
+            return;
+        }
+        s_macro_len = total;
+        ns_uart_link_reply_status(type, seq, NS_UART_STATUS_OK, NULL);
+        return;
+    }
+
+    if (type == NS_UART_CMD_MACRO_DATA) {
+        uint32_t offset = len >= 4 ? ns_rd_u32le(p) : UINT32_MAX;
+
+        if (s_macro_src == NULL || len < 4 || offset > s_macro_len || len - 4 > s_macro_len - offset) {
+            ns_uart_link_reply_status(type, seq, NS_UART_STATUS_BAD_ARGS, NULL);
+            return;
+        }
+        memcpy(&s_macro_src[offset], &p[4], len - 4);
+        ns_uart_link_reply_status(type, seq, NS_UART_STATUS_OK, NULL);
+        return;
+    }
+
+    if (s_macro_src == NULL || len != 1) {
+        ns_uart_link_reply_status(type, seq, NS_UART_STATUS_BAD_ARGS, NULL);
+        return;
+    }
+    s_macro_src[s_macro_len] = '\0';
+    if (!ns_macro_load(s_macro_src, s_macro_len, err, sizeof(err))) {
+        ns_uart_link_reply_status(type, seq, NS_UART_STATUS_COMPILE_ERROR, err);
+    } else {
+        if (p[0] & 0x01) {
+            ns_macro_request_start();
+        }
+        ns_uart_link_reply_status(type, seq, NS_UART_STATUS_OK, NULL);
+    }
+    ns_macro_free(s_macro_src);
+    s_macro_src = NULL;
+    s_macro_len = 0;
+}
+
+static void ns_uart_link_frame(uint8_t *frame, size_t len, int64_t received_us)
+{
+    const uint8_t *payload;
+    size_t payload_len;
+    bool ok = true;
+
+    len = ns_cobs_decode(frame, len);
+    if (len < 4) {
+        NS_UART_STAT_ADD(bad_cobs, 1);
+        ns_metrics_inc(NS_METRIC_UART_BAD_FRAMES);
+        return;
+    }
+    if (ns_uart_crc16(frame, len - 2) != ns_rd_u16le(&frame[len - 2])) {
+        NS_UART_STAT_ADD(bad_crc, 1);
+        ns_metrics_inc(NS_METRIC_UART_BAD_FRAMES);
+        return;
+    }
+
+    payload = &frame[2];
+    payload_len = len - 4;
+    switch (frame[0]) {
+    case NS_UART_CMD_STATE:
+        ok = ns_uart_link_state(payload, payload_len);
+        break;
+    case NS_UART_CMD_DELTA:
+        ok = ns_uart_link_delta(payload, payload_len);
+        break;
+    case NS_UART_CMD_RELEASE:
+        ns_uart_link_release();
+        break;
+    case NS_UART_CMD_TIME:
+        ok = ns_uart_link_time(frame[1], payload, payload_len, received_us);
+        break;
+    case NS_UART_CMD_MACRO_BEGIN:
+    case NS_UART_CMD_MACRO_DATA:
+    case NS_UART_CMD_MACRO_END:
+        ns_uart_link_macro(frame[0], frame[1], payload, payload_len);
+        break;
+    default:
+        ok = false;
+        break;
+    }
+
+    if (!ok) {
+        NS_UART_STAT_ADD(unknown, 1);
+        ns_metrics_inc(NS_METRIC_UART_BAD_FRAMES);
+        return;
+    }
+    ns_metrics_inc(NS_METRIC_UART_FRAMES);
+    taskENTER_CRITICAL(&s_stats_lock);
+    s_stats.frames++;
+    if (frame[0] == NS_UART_CMD_STATE || frame[0] == NS_UART_CMD_DELTA) {
+        uint32_t apply_us = (uint32_t)(esp_timer_get_time() - received_us);
+
+        s_stats.states++;
+        if (apply_us > s_stats.apply_max_us) {
+            s_stats.apply_max_us = apply_us;
+        }
+    }
+    s_last_frame_us = received_us;
+    taskEXIT_CRITICAL(&s_stats_lock);
+}
+
+static void ns_uart_link_feed(const uint8_t *data, size_t len, int64_t received_us)
+{
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == 0) {
+            if (!s_rx_discard && s_rx_len > 0) {
+                ns_uart_link_frame(s_rx_frame, s_rx_len, received_us);
+            }
+            s_rx_len = 0;
+            s_rx_discard = false;
+            continue;
+        }
+        if (s_rx_discard) {
+            continue;
+        }
+        if (s_rx_len == sizeof(s_rx_frame)) {
+            /* Resynchronise on the next delimiter. */
+            s_rx_discard = true;
+            NS_UART_STAT_ADD(too_long, 1);
+            ns_metrics_inc(NS_METRIC_UART_BAD_FRAMES);
+            continue;
+        }
+        s_rx_frame[s_rx_len++] = data[i];
+    }
+}
+
+static void ns_uart_link_task(void *arg)
+{
+    uint8_t chunk[NS_UART_LINK_CHUNK];
+    uart_event_t event;
+
+    (void)arg;
+
+    while (1) {
+        if (xQueueReceive(s_event_queue, &event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        switch (event.type) {
+        case UART_DATA: {
+            size_t left = event.size;
+
+            while (left > 0) {
+                int len = uart_read_bytes(NS_UART_LINK_PORT, chunk,
+                                          left < sizeof(chunk) ? left : sizeof(chunk), 0);
+                if (len <= 0) {
+                    break;
+                }
+                NS_UART_STAT_ADD(rx_bytes, (uint32_t)len);
+                ns_uart_link_feed(chunk, (size_t)len, esp_timer_get_time());
+                left -= (size_t)len;
+            }
+            break;
+        }
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+            /* Bytes are gone; drop everything up to the next delimiter. */
+            uart_flush_input(NS_UART_LINK_PORT);
+            xQueueReset(s_event_queue);
+            s_rx_len = 0;
+            s_rx_discard = true;
+            NS_UART_STAT_ADD(overflows, 1);
+            ESP_LOGW(TAG, "rx overflow, buffered input flushed");
+            break;
+        case UART_FRAME_ERR:
+        case UART_PARITY_ERR:
+            s_rx_discard = true;
+            NS_UART_STAT_ADD(line_errors, 1);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void ns_uart_link_start(void)
+{
+    const uart_config_t config = {
+        .baud_rate = NS_UART_LINK_BAUD,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+    uint32_t baud = 0;
+
+    if (s_task_started) {
+        return;
+    }
+
+    ns_uart_link_reset_state();
+    ESP_ERROR_CHECK(uart_driver_install(NS_UART_LINK_PORT, NS_UART_LINK_RX_BUF, NS_UART_LINK_TX_BUF,
+                                        NS_UART_LINK_EVENT_QUEUE, &s_event_queue, 0));
+    ESP_ERROR_CHECK(uart_param_config(NS_UART_LINK_PORT, &config));
+    ESP_ERROR_CHECK(uart_set_pin(NS_UART_LINK_PORT, NS_UART_LINK_TX_GPIO, NS_UART_LINK_RX_GPIO,
+                                 UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
+    /* Short frames end long before the FIFO fills; hand them over after ~2 idle symbols. */
+    ESP_ERROR_CHECK(uart_set_rx_timeout(NS_UART_LINK_PORT, NS_UART_LINK_RX_TIMEOUT_SYMBOLS));
+    ESP_ERROR_CHECK(uart_set_rx_full_threshold(NS_UART_LINK_PORT, NS_UART_LINK_RX_FULL_THRESHOLD));
+    uart_get_baudrate(NS_UART_LINK_PORT, &baud);
+    s_stats.baud = baud;
+
+    if (xTaskCreate(ns_uart_link_task, "ns_uart_link", NS_UART_LINK_TASK_STACK, NULL,
+                    NS_UART_LINK_TASK_PRIO, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "uart link task create failed");
+        return;
+    }
+    s_task_started = true;
+    ESP_LOGI(TAG, "UART link ready: UART%d tx=%d rx=%d %u baud", NS_UART_LINK_PORT,
+             NS_UART_LINK_TX_GPIO, NS_UART_LINK_RX_GPIO, (unsigned)baud);
+}
+
+void ns_uart_link_get_stats(ns_uart_link_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    *out = s_stats;
+    out->active = s_last_frame_us != 0 &&
+                  esp_timer_get_time() - s_last_frame_us < NS_UART_LINK_LEASE_MS * 1000LL;
+    taskEXIT_CRITICAL(&s_stats_lock);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NS_UART_LINK_BAUD               3000000
+#define NS_UART_LINK_MAX_FRAME          256
+
+/*
+ * Wired control channel. Every frame is COBS-encoded and terminated by 0x00;
+ * decoded it reads, little-endian:
+ *   0  u8   type (NS_UART_CMD_*; replies set NS_UART_REPLY)
+ *   1  u8   sequence, echoed in the reply
+ *   2  ...  payload
+ *   n  u16  CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over type..payload
+ *
+ * STATE     u32 buttons, u16 lx ly rx ry, u8 flags (NS_UART_STATE_*),
+ *           then i16 accel[3] gyro[3] with FLAG_IMU, then u64 apply time with FLAG_AT
+ * DELTA     u8 mask (NS_UART_DELTA_*), then the fields present in mask order:
+ *           u32 press, u32 release, u16 lx, ly, rx, ry
+ * RELEASE   none; drops held and scheduled input
+ * TIME      u64 t1 (host clock); the reply appends u64 t2 (receive) and t3 (send)
+ * MACRO_BEGIN u32 source length; MACRO_DATA u32 offset + bytes;
+ * MACRO_END u8 flags (0x01 = start after compiling)
+ *
+ * STATE/DELTA/RELEASE are not answered. TIME and MACRO_* are answered with
+ * the same type | NS_UART_REPLY; MACRO_* replies carry u8 status
+ * (NS_UART_STATUS_*) and, on compile errors, the message text.
+ */
+#define NS_UART_CMD_STATE               0x01
+#define NS_UART_CMD_DELTA               0x02
+#define NS_UART_CMD_RELEASE             0x03
+#define NS_UART_CMD_TIME                0x04
+#define NS_UART_CMD_MACRO_BEGIN         0x05
+#define NS_UART_CMD_MACRO_DATA          0x06
+#define NS_UART_CMD_MACRO_END           0x07
+#define NS_UART_REPLY                   0x80
+
+#define NS_UART_STATE_FLAG_IMU          0x01
+#define NS_UART_STATE_FLAG_AT           0x02
+
+#define NS_UART_DELTA_PRESS             0x01
+#define NS_UART_DELTA_RELEASE           0x02
+#define NS_UART_DELTA_LX                0x04
+#define NS_UART_DELTA_LY                0x08
+#define NS_UART_DELTA_RX                0x10
+#define NS_UART_DELTA_RY                0x20
+
+#define NS_UART_STATUS_OK               0
+#define NS_UART_STATUS_BAD_ARGS         1
+#define NS_UART_STATUS_NO_MEMORY        2
+#define NS_UART_STATUS_COMPILE_ERROR    3
+
+typedef struct {
+    uint32_t baud;
+    uint32_t rx_bytes;
+    uint32_t frames;
+    uint32_t states;
+    uint32_t bad_crc;
+    uint32_t bad_cobs;
+    uint32_t too_long;
+    uint32_t unknown;
+    uint32_t overflows;
+    uint32_t line_errors;
+    uint32_t time_syncs;
+    /* Frame delimiter received to input applied, worst case since boot. */
+    uint32_t apply_max_us;
+    bool active;
+} ns_uart_link_stats_t;
+
+void ns_uart_link_start(void);
+void ns_uart_link_get_stats(ns_uart_link_stats_t *out);
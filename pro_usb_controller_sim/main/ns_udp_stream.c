@@ -0,0 +1,447 @@
+#include "ns_udp_stream.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
+
+#include "ns_input_layer.h"
+#include "ns_input_sched.h"
+#include "ns_jitter_buffer.h"
+#include "ns_protocol.h"
+
+static const char *TAG = "NS_UDP_STREAM";
+
+#define NS_UDP_STREAM_TASK_STACK 4096
+#define NS_UDP_STREAM_TASK_PRIO 5
+#define NS_UDP_STREAM_RECV_TIMEOUT_MS 100
+/* Release all inputs when the client goes silent for this long. */
+#define NS_UDP_STREAM_IDLE_TIMEOUT_US (500000LL)
+#define NS_UDP_STREAM_LEASE_MS ((uint32_t)(NS_UDP_STREAM_IDLE_TIMEOUT_US / 1000LL))
+
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static ns_udp_stream_stats_t s_stats;
+static bool s_task_started;
+static bool s_session_active;
+static uint32_t s_last_seq;
+static int64_t s_last_arrival_us;
+/* Last packet that carried a client send time; 0 arrival = none yet this session. */
+static int64_t s_last_client_arrival_us;
+static uint64_t s_last_client_ts_us;
+static uint32_t s_jitter_q4;
+static bool s_buffer_attached;
+
+typedef struct {
+    uint32_t samples;
+    uint64_t sum_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t buckets[NS_UDP_PROBE_BUCKETS];
+} ns_udp_probe_hist_t;
+
+/* Written by the stream task, read by httpd; both under s_probe_lock. */
+static portMUX_TYPE s_probe_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_probes;
+static uint32_t s_probe_clock_ahead;
+static uint32_t s_probe_device_max_us;
+static ns_udp_probe_hist_t s_probe_rtt;
+static ns_udp_probe_hist_t s_probe_one_way;
+
+static uint16_t ns_rd_u16le(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t ns_rd_u32le(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t ns_rd_u64le(const uint8_t *p)
+{
+    return (uint64_t)ns_rd_u32le(p) | ((uint64_t)ns_rd_u32le(&p[4]) << 32);
+}
+
+static void ns_wr_u64le(uint8_t *p, uint64_t value)
+{
+    for (uint8_t i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(value >> (i * 8U));
+    }
+}
+
+static void ns_udp_stream_decode(const uint8_t *pkt, ns_input_state_t *input)
+{
+    memset(input, 0, sizeof(*input));
+    input->buttons = ns_rd_u32le(&pkt[16]) & NS_BUTTON_MASK_ALL;
+    input->lx = ns_rd_u16le(&pkt[20]);
+    input->ly = ns_rd_u16le(&pkt[22]);
+    input->rx = ns_rd_u16le(&pkt[24]);
+    input->ry = ns_rd_u16le(&pkt[26]);
+    input->imu_override = (pkt[3] & NS_UDP_STREAM_FLAG_IMU) != 0;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        input->accel[axis] = (int16_t)ns_rd_u16le(&pkt[28 + axis * 2U]);
+        input->gyro[axis] = (int16_t)ns_rd_u16le(&pkt[34 + axis * 2U]);
+    }
+}
+
+/* RFC 3550 interarrival jitter, kept in 1/16 us to avoid rounding drift. */
+static void ns_udp_stream_update_jitter(int64_t arrival_us, uint64_t client_ts_us)
+{
+    int64_t transit_delta = (arrival_us - s_last_client_arrival_us) -
+                            (int64_t)(client_ts_us - s_last_client_ts_us);
+    if (transit_delta < 0) {
+        transit_delta = -transit_delta;
+    }
+    if (transit_delta > 0x0FFFFFFFLL) {
+        transit_delta = 0x0FFFFFFFLL;
+    }
+    s_jitter_q4 += (uint32_t)transit_delta - ((s_jitter_q4 + 8U) >> 4);
+}
+
+static void ns_udp_stream_detach_buffer(void)
+{
+    if (!s_buffer_attached) {
+        return;
+    }
+    ns_input_layer_set_source(NS_INPUT_LAYER_UDP, NULL);
+    ns_jitter_buffer_reset();
+    s_buffer_attached = false;
+}
+
+static void ns_udp_stream_apply(const uint8_t *pkt, uint64_t client_ts_us, int64_t now,
+                                const ns_input_state_t *input)
+{
+    if (pkt[3] & NS_UDP_STREAM_FLAG_AT) {
+        ns_udp_stream_detach_buffer();
+        ns_input_sched_push(NS_INPUT_LAYER_UDP, (int64_t)client_ts_us, input);
+        return;
+    }
+
+    if (pkt[3] & NS_UDP_STREAM_FLAG_BUFFERED) {
+        if (!s_buffer_attached) {
+            ns_jitter_buffer_reset();
+            ns_input_layer_set_source(NS_INPUT_LAYER_UDP, ns_jitter_buffer_sample);
+            s_buffer_attached = true;
+        }
+        ns_jitter_buffer_push(client_ts_us, now, input);
+        /* Keep the last state as fallback should the buffer ever run dry. */
+        ns_input_layer_set(NS_INPUT_LAYER_UDP, input, NS_UDP_STREAM_LEASE_MS);
+        return;
+    }
+
+    ns_udp_stream_detach_buffer();
+    ns_input_layer_set(NS_INPUT_LAYER_UDP, input, NS_UDP_STREAM_LEASE_MS);
+}
+
+static void ns_udp_sync_reply(int sock, const struct sockaddr_in *src, const uint8_t *pkt, int64_t now)
+{
+    uint8_t reply[NS_UDP_SYNC_REPLY_LEN];
+
+    memcpy(reply, pkt, NS_UDP_SYNC_REQ_LEN);
+    ns_wr_u64le(&reply[16], (uint64_t)now);
+    ns_wr_u64le(&reply[24], (uint64_t)esp_timer_get_time());
+    sendto(sock, reply, sizeof(reply), 0, (const struct sockaddr *)src, sizeof(*src));
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    s_stats.sync_requests++;
+    taskEXIT_CRITICAL(&s_stats_lock);
+}
+
+static void ns_udp_probe_record(ns_udp_probe_hist_t *hist, uint32_t value_us)
+{
+    uint32_t bucket = value_us / NS_UDP_PROBE_BUCKET_US;
+
+    if (hist->samples == 0 || value_us < hist->min_us) {
+        hist->min_us = value_us;
+    }
+    if (value_us > hist->max_us) {
+        hist->max_us = value_us;
+    }
+    hist->samples++;
+    hist->sum_us += value_us;
+    /* The last bucket collects everything out of range. */
+    hist->buckets[bucket < NS_UDP_PROBE_BUCKETS ? bucket : NS_UDP_PROBE_BUCKETS - 1]++;
+}
+
+static uint32_t ns_udp_probe_percentile(const ns_udp_probe_hist_t *hist, uint32_t pct)
+{
+    uint32_t rank = (hist->samples * pct + 99U) / 100U;
+    uint32_t seen = 0;
+
+    for (uint32_t bucket = 0; bucket < NS_UDP_PROBE_BUCKETS - 1; bucket++) {
+        seen += hist->buckets[bucket];
+        if (seen >= rank) {
+            uint32_t upper = (bucket + 1U) * NS_UDP_PROBE_BUCKET_US;
+            return upper < hist->max_us ? upper : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+static void ns_udp_probe_summarize(const ns_udp_probe_hist_t *hist, ns_udp_probe_dist_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    if (hist->samples == 0) {
+        return;
+    }
+    out->samples = hist->samples;
+    out->min_us = hist->min_us;
+    out->avg_us = (uint32_t)(hist->sum_us / hist->samples);
+    out->p50_us = ns_udp_probe_percentile(hist, 50);
+    out->p95_us = ns_udp_probe_percentile(hist, 95);
+    out->p99_us = ns_udp_probe_percentile(hist, 99);
+    out->max_us = hist->max_us;
+}
+
+static void ns_udp_probe_reply(int sock, const struct sockaddr_in *src, const uint8_t *pkt, int64_t now)
+{
+    uint8_t reply[NS_UDP_PROBE_REPLY_LEN];
+    uint64_t t1 = ns_rd_u64le(&pkt[8]);
+    uint32_t client_rtt_us = ns_rd_u32le(&pkt[16]);
+    int64_t sent;
+
+    memcpy(reply, pkt, NS_UDP_PROBE_REQ_LEN);
+    ns_wr_u64le(&reply[24], (uint64_t)now);
+    sent = esp_timer_get_time();
+    ns_wr_u64le(&reply[32], (uint64_t)sent);
+    sendto(sock, reply, sizeof(reply), 0, (const struct sockaddr *)src, sizeof(*src));
+
+    /* Stats after the reply so bookkeeping never sits between t3 and the send. */
+    taskENTER_CRITICAL(&s_probe_lock);
+    s_probes++;
+    if ((uint32_t)(sent - now) > s_probe_device_max_us) {
+        s_probe_device_max_us = (uint32_t)(sent - now);
+    }
+    if (client_rtt_us != 0) {
+        ns_udp_probe_record(&s_probe_rtt, client_rtt_us);
+    }
+    if (pkt[3] & NS_UDP_PROBE_FLAG_DEVICE_CLOCK) {
+        if ((int64_t)t1 > now) {
+            s_probe_clock_ahead++;
+        } else {
+            ns_udp_probe_record(&s_probe_one_way, (uint32_t)(now - (int64_t)t1));
+        }
+    }
+    taskEXIT_CRITICAL(&s_probe_lock);
+}
+
+static void ns_udp_stream_handle_packet(const uint8_t *pkt, int len, int64_t now)
+{
+    ns_input_state_t input;
+    uint32_t seq;
+    uint64_t client_ts_us;
+    bool fresh_session;
+    int32_t seq_delta = 0;
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    s_stats.received++;
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    if (len != NS_UDP_STREAM_PACKET_LEN || pkt[0] != 'N' || pkt[1] != 'S' ||
+        pkt[2] != NS_UDP_STREAM_VERSION) {
+        taskENTER_CRITICAL(&s_stats_lock);
+        s_stats.malformed++;
+        taskEXIT_CRITICAL(&s_stats_lock);
+        return;
+    }
+
+    seq = ns_rd_u32le(&pkt[4]);
+    client_ts_us = ns_rd_u64le(&pkt[8]);
+    fresh_session = !s_session_active || (pkt[3] & NS_UDP_STREAM_FLAG_RESET) != 0;
+
+    if (!fresh_session) {
+        /* Serial-number arithmetic so the counter may wrap. */
+        seq_delta = (int32_t)(seq - s_last_seq);
+        if (seq_delta <= 0) {
+            taskENTER_CRITICAL(&s_stats_lock);
+            if (seq_delta == 0) {
+                s_stats.duplicate++;
+            } else {
+                s_stats.reordered++;
+            }
+            taskEXIT_CRITICAL(&s_stats_lock);
+            if (seq_delta < 0 && s_buffer_attached && (pkt[3] & NS_UDP_STREAM_FLAG_BUFFERED)) {
+                /* The playout buffer can still use it if its slot is not past. */
+                ns_udp_stream_decode(pkt, &input);
+                ns_jitter_buffer_push(client_ts_us, now, &input);
+            }
+            return;
+        }
+    } else {
+        s_jitter_q4 = 0;
+        s_last_client_arrival_us = 0;
+        ns_udp_stream_detach_buffer();
+        ESP_LOGI(TAG, "stream session start seq=%u", (unsigned)seq);
+    }
+    /* With FLAG_AT the timestamp is a device apply time, not a send time: no transit to measure. */
+    if ((pkt[3] & NS_UDP_STREAM_FLAG_AT) == 0) {
+        if (s_last_client_arrival_us != 0) {
+            ns_udp_stream_update_jitter(now, client_ts_us);
+        }
+        s_last_client_arrival_us = now;
+        s_last_client_ts_us = client_ts_us;
+    }
+
+    ns_udp_stream_decode(pkt, &input);
+    ns_udp_stream_apply(pkt, client_ts_us, now, &input);
+
+    s_session_active = true;
+    s_last_seq = seq;
+    s_last_arrival_us = now;
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    s_stats.applied++;
+    if (seq_delta > 1) {
+        s_stats.lost += (uint32_t)(seq_delta - 1);
+    }
+    s_stats.last_seq = seq;
+    s_stats.jitter_us = s_jitter_q4 >> 4;
+    s_stats.active = true;
+    taskEXIT_CRITICAL(&s_stats_lock);
+}
+
+static void ns_udp_stream_check_idle(int64_t now)
+{
+    if (!s_session_active || (now - s_last_arrival_us) < NS_UDP_STREAM_IDLE_TIMEOUT_US) {
+        return;
+    }
+
+    s_session_active = false;
+    ns_udp_stream_detach_buffer();
+    ns_input_sched_clear_layer(NS_INPUT_LAYER_UDP);
+    ns_input_layer_clear(NS_INPUT_LAYER_UDP);
+    taskENTER_CRITICAL(&s_stats_lock);
+    s_stats.timeouts++;
+    s_stats.active = false;
+    taskEXIT_CRITICAL(&s_stats_lock);
+    ESP_LOGW(TAG, "stream idle timeout, inputs released");
+}
+
+static void ns_udp_stream_task(void *arg)
+{
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(NS_UDP_STREAM_PORT),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    struct timeval tv = {
+        .tv_sec = 0,
+        .tv_usec = NS_UDP_STREAM_RECV_TIMEOUT_MS * 1000,
+    };
+    uint8_t pkt[NS_UDP_STREAM_PACKET_LEN + 1];
+    struct sockaddr_in src;
+    socklen_t src_len;
+    int sock;
+
+    (void)arg;
+
+    sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        ESP_LOGE(TAG, "socket failed: errno=%d", errno);
+        vTaskDelete(NULL);
+        return;
+    }
+
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        ESP_LOGE(TAG, "bind port %d failed: errno=%d", NS_UDP_STREAM_PORT, errno);
+        closesocket(sock);
+        vTaskDelete(NULL);
+        return;
+    }
+
+    ESP_LOGI(TAG, "UDP state stream ready on port %d", NS_UDP_STREAM_PORT);
+
+    while (1) {
+        int len;
+        int64_t now;
+
+        src_len = sizeof(src);
+        len = recvfrom(sock, pkt, sizeof(pkt), 0, (struct sockaddr *)&src, &src_len);
+        now = esp_timer_get_time();
+
+        if (len == NS_UDP_SYNC_REQ_LEN && pkt[0] == 'N' && pkt[1] == 'T' &&
+            pkt[2] == NS_UDP_STREAM_VERSION) {
+            ns_udp_sync_reply(sock, &src, pkt, now);
+        } else if (len == NS_UDP_PROBE_REQ_LEN && pkt[0] == 'N' && pkt[1] == 'P' &&
+                   pkt[2] == NS_UDP_STREAM_VERSION) {
+            ns_udp_probe_reply(sock, &src, pkt, now);
+        } else if (len > 0) {
+            ns_udp_stream_handle_packet(pkt, len, now);
+        }
+        ns_udp_stream_check_idle(now);
+    }
+}
+
+void ns_udp_stream_start(void)
+{
+    if (s_task_started) {
+        return;
+    }
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_session_active = false;
+    s_jitter_q4 = 0;
+
+    if (xTaskCreate(ns_udp_stream_task, "ns_udp_stream", NS_UDP_STREAM_TASK_STACK,
+                    NULL, NS_UDP_STREAM_TASK_PRIO, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "create stream task failed");
+        return;
+    }
+    s_task_started = true;
+}
+
+void ns_udp_stream_get_stats(ns_udp_stream_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    *out = s_stats;
+    taskEXIT_CRITICAL(&s_stats_lock);
+}
+
+void ns_udp_stream_get_probe_stats(ns_udp_probe_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    /* Percentiles walk 256 buckets; acceptable inside the lock at HTTP rates. */
+    taskENTER_CRITICAL(&s_probe_lock);
+    out->probes = s_probes;
+    out->clock_ahead = s_probe_clock_ahead;
+    out->device_max_us = s_probe_device_max_us;
+    ns_udp_probe_summarize(&s_probe_rtt, &out->rtt);
+    ns_udp_probe_summarize(&s_probe_one_way, &out->one_way);
+    taskEXIT_CRITICAL(&s_probe_lock);
+}
+
+void ns_udp_stream_reset_probe_stats(void)
+{
+    taskENTER_CRITICAL(&s_probe_lock);
+    s_probes = 0;
+    s_probe_clock_ahead = 0;
+    s_probe_device_max_us = 0;
+    memset(&s_probe_rtt, 0, sizeof(s_probe_rtt));
+    memset(&s_probe_one_way, 0, sizeof(s_probe_one_way));
+    taskEXIT_CRITICAL(&s_probe_lock);
+}
+
+bool ns_udp_stream_parse_state(const uint8_t *pkt, size_t len, ns_input_state_t *input,
+                               uint64_t *timestamp_us)
+{
+    if (len != NS_UDP_STREAM_PACKET_LEN || pkt[0] != 'N' || pkt[1] != 'S' ||
+        pkt[2] != NS_UDP_STREAM_VERSION) {
+        return false;
+    }
+    ns_udp_stream_decode(pkt, input);
+    if (timestamp_us != NULL) {
+        *timestamp_us = ns_rd_u64le(&pkt[8]);
+    }
+    return true;
+}
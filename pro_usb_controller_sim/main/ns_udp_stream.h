@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ns_protocol.h"
+
+#define NS_UDP_STREAM_PORT                  5005
+#define NS_UDP_STREAM_VERSION               1
+
+/*
+ * Full-state datagram, little-endian, NS_UDP_STREAM_PACKET_LEN bytes:
+ *   0  u8[2] magic "NS"
+ *   2  u8    version (NS_UDP_STREAM_VERSION)
+ *   3  u8    flags (NS_UDP_STREAM_FLAG_*)
+ *   4  u32   sequence number
+ *   8  u64   client timestamp (us, client clock), or device apply time with FLAG_AT
+ *  16  u32   buttons (NS_BUTTON_MASK bits)
+ *  20  u16   lx, ly, rx, ry (12-bit, 0x800 = center)
+ *  28  i16   accel x/y/z, gyro pitch/roll/yaw (used with FLAG_IMU)
+ */
+#define NS_UDP_STREAM_PACKET_LEN            40
+#define NS_UDP_STREAM_FLAG_IMU              0x01
+#define NS_UDP_STREAM_FLAG_RESET            0x02
+#define NS_UDP_STREAM_FLAG_AT               0x04
+/* Route this client through the adaptive playout buffer (ns_jitter_buffer). */
+#define NS_UDP_STREAM_FLAG_BUFFERED         0x08
+
+/*
+ * Clock sync request (NS_UDP_SYNC_REQ_LEN bytes) on the same port:
+ *   0  u8[2] magic "NT", 2 u8 version, 3 u8 reserved
+ *   4  u32   request id
+ *   8  u64   t1, client send time
+ * The reply (NS_UDP_SYNC_REPLY_LEN bytes) echoes the request and appends
+ *  16  u64   t2, device receive time (esp_timer_get_time)
+ *  24  u64   t3, device send time
+ * With client receive time t4: offset = ((t2 - t1) + (t3 - t4)) / 2 and
+ * delay = (t4 - t1) - (t3 - t2). Device time = client time + offset.
+ */
+#define NS_UDP_SYNC_REQ_LEN                 16
+#define NS_UDP_SYNC_REPLY_LEN               32
+
+/*
+ * Latency probe (NS_UDP_PROBE_REQ_LEN bytes) on the same port:
+ *   0  u8[2] magic "NP", 2 u8 version, 3 u8 flags (NS_UDP_PROBE_FLAG_*)
+ *   4  u32   probe id
+ *   8  u64   t1, client send time; device clock with FLAG_DEVICE_CLOCK
+ *  16  u32   round trip the client measured for the previous probe (us, 0 = none)
+ *  20  u32   reserved
+ * The reply (NS_UDP_PROBE_REPLY_LEN bytes) echoes the request and appends
+ *  24  u64   t2, device receive time
+ *  32  u64   t3, device send time
+ * The device aggregates the reported round trips and, for device-clock
+ * probes, the one-way delay t2 - t1; see GET /probe.
+ */
+#define NS_UDP_PROBE_REQ_LEN                24
+#define NS_UDP_PROBE_REPLY_LEN              40
+/* t1 was converted to device time with the clock sync above. */
+#define NS_UDP_PROBE_FLAG_DEVICE_CLOCK      0x01
+
+typedef struct {
+    uint32_t received;
+    uint32_t applied;
+    uint32_t lost;
+    uint32_t reordered;
+    uint32_t duplicate;
+    uint32_t malformed;
+    uint32_t timeouts;
+    uint32_t last_seq;
+    uint32_t jitter_us;
+    uint32_t sync_requests;
+    bool active;
+} ns_udp_stream_stats_t;
+
+typedef struct {
+    uint32_t samples;
+    uint32_t min_us;
+    uint32_t avg_us;
+    /* Percentiles resolve to NS_UDP_PROBE_BUCKET_US; beyond the range they report max_us. */
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} ns_udp_probe_dist_t;
+
+typedef struct {
+    uint32_t probes;
+    /* One-way probes whose t1 was ahead of the device clock (stale sync). */
+    uint32_t clock_ahead;
+    uint32_t device_max_us;
+    ns_udp_probe_dist_t rtt;
+    ns_udp_probe_dist_t one_way;
+} ns_udp_probe_stats_t;
+
+#define NS_UDP_PROBE_BUCKET_US              200
+#define NS_UDP_PROBE_BUCKETS                256
+
+void ns_udp_stream_start(void);
+void ns_udp_stream_get_stats(ns_udp_stream_stats_t *out);
+void ns_udp_stream_get_probe_stats(ns_udp_probe_stats_t *out);
+void ns_udp_stream_reset_probe_stats(void);
+/* Validates and decodes one state packet for other transports (the /ws socket). */
+bool ns_udp_stream_parse_state(const uint8_t *pkt, size_t len, ns_input_state_t *input,
+                               uint64_t *timestamp_us);
@@ -0,0 +1,45 @@
+#include "ns_web_ui.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+extern const uint8_t ns_web_index_gz_start[] asm("_binary_index_html_gz_start");
+extern const uint8_t ns_web_index_gz_end[] asm("_binary_index_html_gz_end");
+
+/* Quoted FNV-1a of the compressed page; filled on first request. */
+static char s_etag[12];
+
+static const char *ns_web_ui_etag(void)
+{
+    if (s_etag[0] == '\0') {
+        uint32_t hash = 2166136261U;
+
+        for (const uint8_t *p = ns_web_index_gz_start; p < ns_web_index_gz_end; p++) {
+            hash = (hash ^ *p) * 16777619U;
+        }
+        snprintf(s_etag, sizeof(s_etag), "\"%08x\"", (unsigned)hash);
+    }
+    return s_etag;
+}
+
+esp_err_t ns_web_ui_send(httpd_req_t *req)
+{
+    const char *etag = ns_web_ui_etag();
+    char if_none_match[sizeof(s_etag)] = {0};
+
+    /* The URL is not versioned: let browsers cache it but check back on every load. */
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "ETag", etag);
+    if (httpd_req_get_hdr_value_str(req, "If-None-Match", if_none_match, sizeof(if_none_match)) == ESP_OK &&
+        strcmp(if_none_match, etag) == 0) {
+        httpd_resp_set_status(req, "304 Not Modified");
+        return httpd_resp_send(req, NULL, 0);
+    }
+
+    httpd_resp_set_type(req, "text/html; charset=utf-8");
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    /* Straight from the memory-mapped flash image, no RAM copy. */
+    return httpd_resp_send(req, (const char *)ns_web_index_gz_start,
+                           (ssize_t)(ns_web_index_gz_end - ns_web_index_gz_start));
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+/*
+ * GET /ui: the browser controller (main/web/index.html), embedded gzip-compressed
+ * at build time and sent from flash as-is with Content-Encoding: gzip.
+ * Revalidated by ETag, so a reload costs a 304 instead of the page.
+ */
+esp_err_t ns_web_ui_send(httpd_req_t *req);
@@ -0,0 +1,137 @@
+#include "ns_wifi_cache.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "nvs.h"
+
+static const char *TAG = "NS_WIFI_CACHE";
+
+#define NS_WIFI_CACHE_NAMESPACE "wifi_cfg"
+#define NS_WIFI_CACHE_KEY_LINK "link"
+#define NS_WIFI_CACHE_KEY_STATIC "static_ip"
+#define NS_WIFI_CACHE_VERSION 1
+
+typedef struct {
+    uint8_t version;
+    char ssid[33];
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;
+    uint32_t netmask;
+    uint32_t gw;
+    uint32_t dns;
+} ns_wifi_cache_blob_t;
+
+static bool ns_wifi_cache_read(ns_wifi_cache_blob_t *blob)
+{
+    nvs_handle_t handle;
+    size_t len = sizeof(*blob);
+    esp_err_t err;
+
+    if (nvs_open(NS_WIFI_CACHE_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+    err = nvs_get_blob(handle, NS_WIFI_CACHE_KEY_LINK, blob, &len);
+    nvs_close(handle);
+    return err == ESP_OK && len == sizeof(*blob) && blob->version == NS_WIFI_CACHE_VERSION;
+}
+
+bool ns_wifi_cache_load(const char *ssid, ns_wifi_cache_t *out)
+{
+    ns_wifi_cache_blob_t blob;
+
+    memset(out, 0, sizeof(*out));
+    if (!ns_wifi_cache_read(&blob) || strncmp(blob.ssid, ssid, sizeof(blob.ssid)) != 0 ||
+        blob.channel == 0) {
+        return false;
+    }
+
+    memcpy(out->bssid, blob.bssid, sizeof(out->bssid));
+    out->channel = blob.channel;
+    out->ip = blob.ip;
+    out->netmask = blob.netmask;
+    out->gw = blob.gw;
+    out->dns = blob.dns;
+    out->valid = true;
+    return true;
+}
+
+bool ns_wifi_cache_save(const char *ssid, const ns_wifi_cache_t *cache)
+{
+    ns_wifi_cache_blob_t blob = {0};
+    ns_wifi_cache_blob_t stored;
+    nvs_handle_t handle;
+    esp_err_t err;
+
+    blob.version = NS_WIFI_CACHE_VERSION;
+    strncpy(blob.ssid, ssid, sizeof(blob.ssid) - 1);
+    memcpy(blob.bssid, cache->bssid, sizeof(blob.bssid));
+    blob.channel = cache->channel;
+    blob.ip = cache->ip;
+    blob.netmask = cache->netmask;
+    blob.gw = cache->gw;
+    blob.dns = cache->dns;
+
+    if (ns_wifi_cache_read(&stored) && memcmp(&stored, &blob, sizeof(blob)) == 0) {
+        return true;
+    }
+
+    err = nvs_open(NS_WIFI_CACHE_NAMESPACE, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        return false;
+    }
+    err = nvs_set_blob(handle, NS_WIFI_CACHE_KEY_LINK, &blob, sizeof(blob));
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "save link cache failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    ESP_LOGI(TAG, "link cached: channel=%u", (unsigned)cache->channel);
+    return true;
+}
+
+void ns_wifi_cache_forget(void)
+{
+    nvs_handle_t handle;
+
+    if (nvs_open(NS_WIFI_CACHE_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+    if (nvs_erase_key(handle, NS_WIFI_CACHE_KEY_LINK) == ESP_OK) {
+        nvs_commit(handle);
+    }
+    nvs_close(handle);
+}
+
+bool ns_wifi_cache_static_ip_enabled(void)
+{
+    nvs_handle_t handle;
+    uint8_t enabled = 0;
+
+    if (nvs_open(NS_WIFI_CACHE_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+    nvs_get_u8(handle, NS_WIFI_CACHE_KEY_STATIC, &enabled);
+    nvs_close(handle);
+    return enabled != 0;
+}
+
+bool ns_wifi_cache_set_static_ip(bool enabled)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(NS_WIFI_CACHE_NAMESPACE, NVS_READWRITE, &handle);
+
+    if (err != ESP_OK) {
+        return false;
+    }
+    err = nvs_set_u8(handle, NS_WIFI_CACHE_KEY_STATIC, enabled ? 1 : 0);
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return err == ESP_OK;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Last good link, used to skip the scan (and optionally DHCP) on the next connect. */
+typedef struct {
+    bool valid;
+    uint8_t bssid[6];
+    uint8_t channel;
+    /* IPv4 addresses as in esp_ip4_addr_t.addr (network byte order). */
+    uint32_t ip;
+    uint32_t netmask;
+    uint32_t gw;
+    uint32_t dns;
+} ns_wifi_cache_t;
+
+/* Loads the cached link; invalid when it was recorded for another SSID. */
+bool ns_wifi_cache_load(const char *ssid, ns_wifi_cache_t *out);
+/* Writes only when the link changed, to spare flash on every reconnect. */
+bool ns_wifi_cache_save(const char *ssid, const ns_wifi_cache_t *cache);
+void ns_wifi_cache_forget(void);
+
+/* Static-IP fast path: reuse the cached address instead of waiting for DHCP. */
+bool ns_wifi_cache_static_ip_enabled(void);
+bool ns_wifi_cache_set_static_ip(bool enabled);
@@ -1,21 +1,40 @@
 #include "ns_wifi_control.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <strings.h>
 
 #include "driver/gpio.h"
 #include "esp_event.h"
 #include "esp_http_server.h"
 #include "esp_log.h"
+#include "esp_random.h"
 #include "esp_timer.h"
 #include "esp_wifi.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
 #include "nvs.h"
 #include "nvs_flash.h"
 
+#include "ns_boot.h"
+#include "ns_event_stream.h"
+#include "ns_input_layer.h"
+#include "ns_input_sched.h"
+#include "ns_jitter_buffer.h"
+#include "ns_json.h"
+#include "ns_macro.h"
+#include "ns_metrics.h"
+#include "ns_proto.h"
 #include "ns_protocol.h"
+#include "ns_rules.h"
+#include "ns_uart_link.h"
+#include "ns_udp_stream.h"
+#include "ns_web_ui.h"
+#include "ns_wifi_cache.h"
+#include "ns_wifi_profile.h"
 
 static const char *TAG = "NS_WIFI_CTRL";
 
@@ -32,35 +51,41 @@ static const char *TAG = "NS_WIFI_CTRL";
 #define NS_PRESS_DEFAULT_MS 100
 #define NS_HOLD_MIN_MS 20
 #define NS_HOLD_MAX_MS 60000
-
-typedef struct {
-    const char *name;
-    ns_button_id_t button;
-} ns_button_name_map_t;
-
-static const ns_button_name_map_t s_button_name_map[] = {
-    {"NONE", NS_BUTTON_NONE},
-    {"Y", NS_BUTTON_Y},
-    {"X", NS_BUTTON_X},
-    {"B", NS_BUTTON_B},
-    {"A", NS_BUTTON_A},
-    {"L", NS_BUTTON_L},
-    {"R", NS_BUTTON_R},
-    {"ZL", NS_BUTTON_ZL},
-    {"ZR", NS_BUTTON_ZR},
-    {"MINUS", NS_BUTTON_MINUS},
-    {"PLUS", NS_BUTTON_PLUS},
-    {"L_STICK", NS_BUTTON_L_STICK},
-    {"R_STICK", NS_BUTTON_R_STICK},
-    {"HOME", NS_BUTTON_HOME},
-    {"CAPTURE", NS_BUTTON_CAPTURE},
-    {"UP", NS_BUTTON_UP},
-    {"DOWN", NS_BUTTON_DOWN},
-    {"LEFT", NS_BUTTON_LEFT},
-    {"RIGHT", NS_BUTTON_RIGHT},
-};
+/* Default lease for HTTP-held input; every request from the client renews it. */
+#define NS_INPUT_HTTP_LEASE_MS 30000
+#define NS_LEASE_MAX_MS 3600000
+/* /ws clients resend at least every 100 ms; a closed tab drops its input this fast. */
+#define NS_WS_LEASE_MS 500
+/* Lets one client keep its layer across connections; without it each session has its own. */
+#define NS_HTTP_CLIENT_ID_HEADER "X-Client-Id"
+#define NS_HTTP_CLIENT_ID_MAX 32
+/* Owner keys: explicit client ids are hashed into the low half, sessions numbered in the high. */
+#define NS_HTTP_OWNER_SESSION 0x80000000UL
+#define NS_HTTP_MAX_URI_HANDLERS NS_METRICS_HTTP_ROUTES
+#define NS_STATE_BODY_MAX 512
+#define NS_STATE_MAX_TOKENS 64
+#define NS_STICK_AXIS_MAX 0x0FFF
+#define NS_RULES_BODY_MAX 4096
+#define NS_RULES_MAX_TOKENS 384
+/* Consecutive recv timeouts (httpd recv_wait_timeout each) before a stalled body gets 408. */
+#define NS_HTTP_RECV_TIMEOUT_RETRIES 3
+/*
+ * NVS, Wi-Fi and httpd bring-up. Below both the TinyUSB task and the app_main
+ * report loop (priority 1), so neither enumeration nor a report waits for it.
+ */
+#define NS_WIFI_BOOT_TASK_STACK 6144
+#define NS_WIFI_BOOT_TASK_PRIO tskIDLE_PRIORITY
+/* Reconnect: pinned to the cached BSSID/channel first, then a full scan with jittered backoff. */
+#define NS_WIFI_FAST_ATTEMPTS 2
+/* s_wifi_task notification bits. */
+#define NS_WIFI_NOTIFY_LINK_CACHE 0x01U
+#define NS_WIFI_NOTIFY_RECONNECT 0x02U
+#define NS_WIFI_BACKOFF_BASE_MS 250
+#define NS_WIFI_BACKOFF_MAX_MS 30000
 
 static bool s_http_server_started;
+/* Set once the boot task is done; the main loop skips Wi-Fi work until then. */
+static volatile bool s_wifi_control_ready;
 static bool s_sta_connected;
 static bool s_wifi_inited;
 static bool s_wifi_creds_loaded;
@@ -70,12 +95,41 @@ static char s_sta_pass[65];
 static char s_sta_ip[16];
 static esp_event_handler_instance_t s_wifi_event_instance;
 static esp_event_handler_instance_t s_ip_event_instance;
+static esp_netif_t *s_sta_netif;
+
+/* Link cache and the pending copy: set by the Wi-Fi event task, saved by s_wifi_task. */
+static portMUX_TYPE s_link_cache_lock = portMUX_INITIALIZER_UNLOCKED;
+static ns_wifi_cache_t s_link_cache;
+static ns_wifi_cache_t s_link_cache_pending;
+static bool s_link_cache_dirty;
+/* Boot task, kept afterwards to write the link cache and run delayed reconnects; NULL after an inline bring-up. */
+static TaskHandle_t s_wifi_task;
+static bool s_static_ip;
+static esp_timer_handle_t s_reconnect_timer;
+/* Reconnect state below: written by the event loop, s_wifi_task and httpd. */
+static portMUX_TYPE s_connect_lock = portMUX_INITIALIZER_UNLOCKED;
+/* Failed attempts since the last good link; selects fast vs. scan and the backoff. */
+static uint32_t s_connect_attempts;
+static uint32_t s_backoff_ms;
+/* Start of the current connect or reconnect; 0 while connected. */
+static int64_t s_connect_start_us;
+static bool s_fast_attempt;
+static uint8_t s_connected_bssid[6];
+static uint8_t s_connected_channel;
 
 static bool s_provision_btn_pressed;
 static bool s_provision_btn_triggered;
 static int64_t s_provision_btn_press_start_us;
-static bool s_button_auto_release_pending;
-static int64_t s_button_auto_release_deadline_us;
+/*
+ * Per HTTP client layer, written by httpd and read by the esp_timer task:
+ * auto release deadline (0 = none) and the lease renewed by each request.
+ */
+static portMUX_TYPE s_http_slot_lock = portMUX_INITIALIZER_UNLOCKED;
+static int64_t s_button_auto_release_deadline_us[NS_INPUT_HTTP_CLIENTS];
+static uint32_t s_client_lease_ms[NS_INPUT_HTTP_CLIENTS];
+static esp_timer_handle_t s_button_release_timers[NS_INPUT_HTTP_CLIENTS];
+/* Only touched from the httpd task. */
+static uint32_t s_http_session_seq;
 
 static const char *s_setup_html =
     "<!doctype html><html><head><meta charset=\"utf-8\">"
@@ -88,60 +142,231 @@ static const char *s_setup_html =
     "<button type=\"submit\">Connect</button>"
     "</form>"
     "<p>状态可访问: <a href=\"/health\">/health</a></p>"
+    "<p>网页手柄: <a href=\"/ui\">/ui</a></p>"
     "</body></html>";
 
-static const char *ns_button_name(ns_button_id_t button)
+static void ns_http_send_json(httpd_req_t *req, const char *json)
+{
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_sendstr(req, json);
+}
+
+static void ns_button_release_layer(uint8_t layer);
+
+/* httpd free_ctx hook: a session without a client id takes its input with it. */
+static void ns_http_session_closed(void *ctx)
+{
+    ns_button_release_layer(ns_input_layer_for_client((uint32_t)(uintptr_t)ctx, false));
+}
+
+/*
+ * Owner key of the requesting client: its X-Client-Id (FNV-1a), else a number
+ * kept in the httpd session context. Two tools on one host no longer share a
+ * layer, while one tool spreading requests over several connections can.
+ */
+static uint32_t ns_http_client_owner(httpd_req_t *req)
 {
-    for (size_t i = 0; i < sizeof(s_button_name_map) / sizeof(s_button_name_map[0]); i++) {
-        if (s_button_name_map[i].button == button) {
-            return s_button_name_map[i].name;
+    char id[NS_HTTP_CLIENT_ID_MAX + 1];
+
+    if (httpd_req_get_hdr_value_str(req, NS_HTTP_CLIENT_ID_HEADER, id, sizeof(id)) == ESP_OK &&
+        id[0] != '\0') {
+        uint32_t hash = 2166136261UL;
+
+        for (const char *c = id; *c != '\0'; c++) {
+            hash = (hash ^ (uint8_t)*c) * 16777619UL;
         }
+        return hash & ~NS_HTTP_OWNER_SESSION;
+    }
+    if (req->sess_ctx == NULL) {
+        s_http_session_seq = (s_http_session_seq + 1U) & ~NS_HTTP_OWNER_SESSION;
+        req->sess_ctx = (void *)(uintptr_t)(NS_HTTP_OWNER_SESSION | s_http_session_seq);
+        req->free_ctx = ns_http_session_closed;
     }
-    return "UNKNOWN";
+    return (uint32_t)(uintptr_t)req->sess_ctx;
 }
 
-static bool ns_button_from_name(const char *name, ns_button_id_t *out_button)
+/* Input layer of the requesting client; NS_INPUT_LAYER_NONE if every slot is held by others. */
+static uint8_t ns_http_client_layer(httpd_req_t *req, bool create)
 {
-    if (name == NULL || out_button == NULL) {
-        return false;
-    }
+    return ns_input_layer_for_client(ns_http_client_owner(req), create);
+}
 
-    for (size_t i = 0; i < sizeof(s_button_name_map) / sizeof(s_button_name_map[0]); i++) {
-        if (strcasecmp(name, s_button_name_map[i].name) == 0) {
-            *out_button = s_button_name_map[i].button;
-            return true;
+static void ns_http_set_lease(uint8_t layer, uint32_t lease_ms)
+{
+    taskENTER_CRITICAL(&s_http_slot_lock);
+    s_client_lease_ms[layer - NS_INPUT_LAYER_HTTP0] = lease_ms;
+    taskEXIT_CRITICAL(&s_http_slot_lock);
+}
+
+static uint32_t ns_http_get_lease(uint8_t layer)
+{
+    uint32_t lease_ms;
+
+    taskENTER_CRITICAL(&s_http_slot_lock);
+    lease_ms = s_client_lease_ms[layer - NS_INPUT_LAYER_HTTP0];
+    taskEXIT_CRITICAL(&s_http_slot_lock);
+    return lease_ms;
+}
+
+/*
+ * Reads exactly len body bytes. On failure the handler must return ESP_FAIL so
+ * the session is closed; a client that stalls mid-body has already had a 408.
+ */
+static esp_err_t ns_http_recv_body(httpd_req_t *req, char *buf, size_t len)
+{
+    size_t received = 0;
+    int timeouts = 0;
+
+    while (received < len) {
+        int ret = httpd_req_recv(req, &buf[received], len - received);
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+            if (++timeouts < NS_HTTP_RECV_TIMEOUT_RETRIES) {
+                continue;
+            }
+            httpd_resp_set_status(req, "408 Request Timeout");
+            ns_http_send_json(req, "{\"ok\":false,\"error\":\"request body timed out\"}");
+            return ESP_ERR_TIMEOUT;
+        }
+        if (ret <= 0) {
+            return ESP_FAIL;
         }
+        timeouts = 0;
+        received += (size_t)ret;
+    }
+    return ESP_OK;
+}
+
+static bool ns_http_require_layer(httpd_req_t *req, uint8_t layer)
+{
+    if (layer != NS_INPUT_LAYER_NONE) {
+        return true;
     }
+    httpd_resp_set_status(req, "503 Service Unavailable");
+    ns_http_send_json(req, "{\"ok\":false,\"error\":\"all input layers in use\"}");
     return false;
 }
 
-static void ns_http_send_json(httpd_req_t *req, const char *json)
+/* ?lease_ms=N overrides the default lease; 0 holds until released. */
+static uint32_t ns_parse_lease_ms(httpd_req_t *req)
 {
-    httpd_resp_set_type(req, "application/json");
-    httpd_resp_sendstr(req, json);
+    char query[128] = {0};
+    char lease_buf[16] = {0};
+
+    if (httpd_req_get_url_query_len(req) > 0 &&
+        httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "lease_ms", lease_buf, sizeof(lease_buf)) == ESP_OK) {
+        char *end = NULL;
+        long parsed = strtol(lease_buf, &end, 10);
+        if (end != lease_buf && *end == '\0' && parsed >= 0) {
+            return parsed > NS_LEASE_MAX_MS ? NS_LEASE_MAX_MS : (uint32_t)parsed;
+        }
+    }
+    return NS_INPUT_HTTP_LEASE_MS;
 }
 
-static void ns_button_release_now(void)
+static void ns_button_set_deadline(uint8_t slot, int64_t deadline_us)
 {
-    ns_protocol_set_test_button(NS_BUTTON_NONE);
-    s_button_auto_release_pending = false;
-    s_button_auto_release_deadline_us = 0;
+    taskENTER_CRITICAL(&s_http_slot_lock);
+    s_button_auto_release_deadline_us[slot] = deadline_us;
+    taskEXIT_CRITICAL(&s_http_slot_lock);
 }
 
-static void ns_button_press_for_ms(ns_button_id_t button, uint32_t hold_ms)
+static void ns_button_release_layer(uint8_t layer)
 {
-    if (button < NS_BUTTON_NONE || button > NS_BUTTON_RIGHT) {
+    uint8_t slot;
+
+    if (layer == NS_INPUT_LAYER_NONE) {
+        return;
+    }
+    slot = layer - NS_INPUT_LAYER_HTTP0;
+    ns_button_set_deadline(slot, 0);
+    if (s_button_release_timers[slot] != NULL) {
+        esp_timer_stop(s_button_release_timers[slot]);
+    }
+    ns_input_sched_clear_layer(layer);
+    ns_input_layer_clear(layer);
+}
+
+/*
+ * Fires on the esp_timer task, so the release lands in the first report after the deadline.
+ * The deadline is checked and the layer cleared in one section; a press arms its new deadline
+ * before it sets the layer, so a press landing around this shot is never released by it.
+ */
+static void ns_button_release_timer_cb(void *arg)
+{
+    uint8_t slot = (uint8_t)(uintptr_t)arg;
+    int64_t now = esp_timer_get_time();
+    int64_t deadline;
+
+    taskENTER_CRITICAL(&s_http_slot_lock);
+    deadline = s_button_auto_release_deadline_us[slot];
+    if (deadline != 0 && now >= deadline) {
+        s_button_auto_release_deadline_us[slot] = 0;
+        ns_input_layer_release(NS_INPUT_LAYER_HTTP0 + slot, deadline);
+    }
+    taskEXIT_CRITICAL(&s_http_slot_lock);
+
+    /* Re-armed by a newer press after this expiry was dispatched: its own shot follows. */
+    if (deadline == 0 || now < deadline) {
         return;
     }
 
-    ns_protocol_set_test_button(button);
+    ns_metrics_inc(NS_METRIC_HOLD_RELEASES);
+    ns_metrics_add(NS_METRIC_HOLD_RELEASE_ERROR_US_SUM, (uint32_t)(now - deadline));
+    ns_metrics_max_gauge(NS_METRIC_GAUGE_HOLD_RELEASE_ERROR_MAX_US, (int32_t)(now - deadline));
+}
+
+static void ns_button_release_timers_init(void)
+{
+    for (uint8_t slot = 0; slot < NS_INPUT_HTTP_CLIENTS; slot++) {
+        const esp_timer_create_args_t args = {
+            .callback = ns_button_release_timer_cb,
+            .arg = (void *)(uintptr_t)slot,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "ns_btn_release",
+        };
+
+        if (s_button_release_timers[slot] == NULL) {
+            ESP_ERROR_CHECK(esp_timer_create(&args, &s_button_release_timers[slot]));
+        }
+    }
+}
+
+static void ns_button_arm_release(uint8_t layer, uint32_t hold_ms)
+{
+    uint8_t slot = layer - NS_INPUT_LAYER_HTTP0;
+    esp_timer_handle_t timer = s_button_release_timers[slot];
+
+    esp_timer_stop(timer);
     if (hold_ms == 0) {
-        s_button_auto_release_pending = false;
-        s_button_auto_release_deadline_us = 0;
-    } else {
-        s_button_auto_release_pending = true;
-        s_button_auto_release_deadline_us = esp_timer_get_time() + (int64_t)hold_ms * 1000LL;
+        ns_button_set_deadline(slot, 0);
+        return;
+    }
+    ns_button_set_deadline(slot, esp_timer_get_time() + (int64_t)hold_ms * 1000LL);
+    esp_timer_start_once(timer, (uint64_t)hold_ms * 1000ULL);
+}
+
+static void ns_button_press_for_ms(uint8_t layer, ns_button_id_t button, uint32_t hold_ms,
+                                   uint32_t lease_ms)
+{
+    if (button < NS_BUTTON_NONE || button > NS_BUTTON_RIGHT) {
+        return;
+    }
+
+    ns_http_set_lease(layer, lease_ms);
+    ns_button_arm_release(layer, hold_ms);
+    ns_input_layer_set_buttons(layer, button == NS_BUTTON_NONE ? 0 : NS_BUTTON_MASK(button), lease_ms);
+}
+
+static uint32_t ns_clamp_hold_ms(long ms)
+{
+    if (ms < NS_HOLD_MIN_MS) {
+        return NS_HOLD_MIN_MS;
+    }
+    if (ms > NS_HOLD_MAX_MS) {
+        return NS_HOLD_MAX_MS;
     }
+    return (uint32_t)ms;
 }
 
 static bool ns_parse_button_from_query(httpd_req_t *req, ns_button_id_t *out_button)
@@ -160,7 +385,7 @@ static bool ns_parse_button_from_query(httpd_req_t *req, ns_button_id_t *out_but
     }
 
     if (httpd_query_key_value(query, "name", name, sizeof(name)) == ESP_OK) {
-        return ns_button_from_name(name, out_button);
+        return ns_protocol_button_from_name(name, out_button);
     }
 
     if (httpd_query_key_value(query, "id", id, sizeof(id)) == ESP_OK) {
@@ -194,6 +419,37 @@ static bool ns_wifi_save_credentials(const char *ssid, const char *pass)
     return err == ESP_OK;
 }
 
+static void ns_wifi_link_cache_get(ns_wifi_cache_t *out)
+{
+    taskENTER_CRITICAL(&s_link_cache_lock);
+    *out = s_link_cache;
+    taskEXIT_CRITICAL(&s_link_cache_lock);
+}
+
+static void ns_wifi_link_cache_set(const ns_wifi_cache_t *cache)
+{
+    taskENTER_CRITICAL(&s_link_cache_lock);
+    s_link_cache = *cache;
+    taskEXIT_CRITICAL(&s_link_cache_lock);
+}
+
+/* Flash writes stay out of the event task (small stack) and the report loop. */
+static void ns_wifi_link_cache_flush(void)
+{
+    ns_wifi_cache_t cache;
+    bool dirty;
+
+    taskENTER_CRITICAL(&s_link_cache_lock);
+    dirty = s_link_cache_dirty;
+    cache = s_link_cache_pending;
+    s_link_cache_dirty = false;
+    taskEXIT_CRITICAL(&s_link_cache_lock);
+
+    if (dirty && ns_wifi_cache_save(s_sta_ssid, &cache)) {
+        ns_wifi_link_cache_set(&cache);
+    }
+}
+
 static void ns_wifi_load_credentials(void)
 {
     nvs_handle_t handle;
@@ -215,18 +471,215 @@ static void ns_wifi_load_credentials(void)
     }
 
     nvs_close(handle);
+
+    if (s_wifi_creds_loaded) {
+        ns_wifi_cache_t cache;
+
+        ns_wifi_cache_load(s_sta_ssid, &cache);
+        ns_wifi_link_cache_set(&cache);
+        s_static_ip = ns_wifi_cache_static_ip_enabled();
+    }
 }
 
 static esp_err_t ns_wifi_set_sta_cfg(const char *ssid, const char *pass)
 {
     wifi_config_t sta_cfg = {0};
+    ns_wifi_cache_t cache;
+    bool fast;
 
     strncpy((char *)sta_cfg.sta.ssid, ssid, sizeof(sta_cfg.sta.ssid) - 1);
     strncpy((char *)sta_cfg.sta.password, pass, sizeof(sta_cfg.sta.password) - 1);
     sta_cfg.sta.threshold.authmode = WIFI_AUTH_OPEN;
+    /* Pinning BSSID and channel skips the all-channel scan. */
+    ns_wifi_link_cache_get(&cache);
+    taskENTER_CRITICAL(&s_connect_lock);
+    s_fast_attempt = cache.valid && s_connect_attempts < NS_WIFI_FAST_ATTEMPTS;
+    fast = s_fast_attempt;
+    taskEXIT_CRITICAL(&s_connect_lock);
+    if (fast) {
+        sta_cfg.sta.bssid_set = true;
+        memcpy(sta_cfg.sta.bssid, cache.bssid, sizeof(sta_cfg.sta.bssid));
+        sta_cfg.sta.channel = cache.channel;
+    }
     return esp_wifi_set_config(WIFI_IF_STA, &sta_cfg);
 }
 
+/* Static-IP fast path only on pinned attempts; a full scan may land on another network. */
+static void ns_wifi_apply_ip_mode(void)
+{
+    ns_wifi_cache_t cache;
+    esp_err_t err;
+    bool fast;
+
+    if (s_sta_netif == NULL) {
+        return;
+    }
+
+    ns_wifi_link_cache_get(&cache);
+    taskENTER_CRITICAL(&s_connect_lock);
+    fast = s_fast_attempt;
+    taskEXIT_CRITICAL(&s_connect_lock);
+    if (s_static_ip && fast && cache.ip != 0) {
+        esp_netif_ip_info_t ip_info = {
+            .ip = {.addr = cache.ip},
+            .netmask = {.addr = cache.netmask},
+            .gw = {.addr = cache.gw},
+        };
+
+        err = esp_netif_dhcpc_stop(s_sta_netif);
+        if (err != ESP_OK && err != ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED) {
+            ESP_LOGW(TAG, "dhcpc stop failed: %s", esp_err_to_name(err));
+            return;
+        }
+        esp_netif_set_ip_info(s_sta_netif, &ip_info);
+        if (cache.dns != 0) {
+            esp_netif_dns_info_t dns = {0};
+
+            dns.ip.type = ESP_IPADDR_TYPE_V4;
+            dns.ip.u_addr.ip4.addr = cache.dns;
+            esp_netif_set_dns_info(s_sta_netif, ESP_NETIF_DNS_MAIN, &dns);
+        }
+        return;
+    }
+
+    err = esp_netif_dhcpc_start(s_sta_netif);
+    if (err != ESP_OK && err != ESP_ERR_ESP_NETIF_DHCP_ALREADY_STARTED) {
+        ESP_LOGW(TAG, "dhcpc start failed: %s", esp_err_to_name(err));
+    }
+}
+
+static void ns_wifi_mark_connect_start(void)
+{
+    int64_t now = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&s_connect_lock);
+    if (s_connect_start_us == 0) {
+        s_connect_start_us = now;
+    }
+    taskEXIT_CRITICAL(&s_connect_lock);
+}
+
+static void ns_wifi_sta_connect(void)
+{
+    esp_err_t err;
+
+    if (!s_wifi_creds_loaded) {
+        return;
+    }
+    ns_wifi_mark_connect_start();
+
+    err = ns_wifi_set_sta_cfg(s_sta_ssid, s_sta_pass);
+    if (err == ESP_OK) {
+        ns_wifi_apply_ip_mode();
+        err = esp_wifi_connect();
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "STA connect failed: %s", esp_err_to_name(err));
+    }
+}
+
+/* Runs on the shared esp_timer task, next to the hold-release and schedule timers: hand the connect to s_wifi_task. */
+static void ns_wifi_reconnect_timer_cb(void *arg)
+{
+    (void)arg;
+    if (s_wifi_task != NULL) {
+        xTaskNotify(s_wifi_task, NS_WIFI_NOTIFY_RECONNECT, eSetBits);
+        return;
+    }
+    ns_wifi_sta_connect();
+}
+
+/*
+ * Equal-jitter exponential backoff: uniform in [delay/2, delay], delay doubling
+ * up to the cap. Keeping half the delay fixed stops a flapping AP being retried early.
+ */
+static uint32_t ns_wifi_backoff_ms(uint32_t attempt)
+{
+    uint32_t shift = attempt > 8 ? 8 : attempt;
+    uint32_t delay = NS_WIFI_BACKOFF_BASE_MS << shift;
+
+    if (delay > NS_WIFI_BACKOFF_MAX_MS) {
+        delay = NS_WIFI_BACKOFF_MAX_MS;
+    }
+    return delay / 2U + esp_random() % (delay / 2U + 1U);
+}
+
+static void ns_wifi_schedule_reconnect(void)
+{
+    uint32_t attempt;
+    uint32_t backoff_ms;
+
+    taskENTER_CRITICAL(&s_connect_lock);
+    attempt = s_connect_attempts++;
+    taskEXIT_CRITICAL(&s_connect_lock);
+
+    /* The first retry after a drop goes out at once, against the cached link. */
+    backoff_ms = (attempt == 0 || s_reconnect_timer == NULL) ? 0 : ns_wifi_backoff_ms(attempt - 1U);
+    taskENTER_CRITICAL(&s_connect_lock);
+    s_backoff_ms = backoff_ms;
+    taskEXIT_CRITICAL(&s_connect_lock);
+    ns_metrics_set_gauge(NS_METRIC_GAUGE_WIFI_BACKOFF_MS, (int32_t)backoff_ms);
+    if (backoff_ms == 0) {
+        ns_wifi_sta_connect();
+        return;
+    }
+
+    esp_timer_stop(s_reconnect_timer);
+    esp_timer_start_once(s_reconnect_timer, (uint64_t)backoff_ms * 1000ULL);
+    ESP_LOGW(TAG, "Wi-Fi retry %u in %u ms", (unsigned)attempt, (unsigned)backoff_ms);
+}
+
+static void ns_wifi_link_up(const ip_event_got_ip_t *event)
+{
+    int64_t now = esp_timer_get_time();
+    esp_netif_dns_info_t dns = {0};
+    ns_wifi_cache_t cache = {
+        .valid = true,
+        .channel = s_connected_channel,
+        .ip = event->ip_info.ip.addr,
+        .netmask = event->ip_info.netmask.addr,
+        .gw = event->ip_info.gw.addr,
+    };
+    int64_t start_us;
+    bool fast;
+
+    taskENTER_CRITICAL(&s_connect_lock);
+    start_us = s_connect_start_us;
+    fast = s_fast_attempt;
+    s_connect_start_us = 0;
+    s_connect_attempts = 0;
+    s_backoff_ms = 0;
+    taskEXIT_CRITICAL(&s_connect_lock);
+
+    if (start_us != 0) {
+        uint32_t connect_us = (uint32_t)(now - start_us);
+
+        ns_metrics_set_gauge(NS_METRIC_GAUGE_WIFI_CONNECT_LAST_US, (int32_t)connect_us);
+        ns_metrics_inc(NS_METRIC_WIFI_CONNECT_COUNT);
+        ns_metrics_add(NS_METRIC_WIFI_CONNECT_US_SUM, connect_us);
+        if (fast) {
+            ns_metrics_inc(NS_METRIC_WIFI_FAST_CONNECT);
+        }
+        ESP_LOGI(TAG, "Wi-Fi link up in %u ms (%s)", (unsigned)(connect_us / 1000U),
+                 fast ? "cached" : "scan");
+    }
+    ns_metrics_set_gauge(NS_METRIC_GAUGE_WIFI_BACKOFF_MS, 0);
+
+    memcpy(cache.bssid, s_connected_bssid, sizeof(cache.bssid));
+    if (s_sta_netif != NULL && esp_netif_get_dns_info(s_sta_netif, ESP_NETIF_DNS_MAIN, &dns) == ESP_OK) {
+        cache.dns = dns.ip.u_addr.ip4.addr;
+    }
+    if (cache.channel != 0) {
+        taskENTER_CRITICAL(&s_link_cache_lock);
+        s_link_cache_pending = cache;
+        s_link_cache_dirty = true;
+        taskEXIT_CRITICAL(&s_link_cache_lock);
+        if (s_wifi_task != NULL) {
+            xTaskNotify(s_wifi_task, NS_WIFI_NOTIFY_LINK_CACHE, eSetBits);
+        }
+    }
+}
+
 static void ns_wifi_try_connect_sta(void)
 {
     esp_err_t err;
@@ -260,6 +713,8 @@ static void ns_wifi_try_connect_sta(void)
         return;
     }
 
+    ns_wifi_mark_connect_start();
+    ns_wifi_apply_ip_mode();
     err = esp_wifi_connect();
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "esp_wifi_connect failed: %s", esp_err_to_name(err));
@@ -338,6 +793,208 @@ static esp_err_t ns_health_get_handler(httpd_req_t *req)
     return ESP_OK;
 }
 
+static esp_err_t ns_wifi_get_handler(httpd_req_t *req)
+{
+    char query[48] = {0};
+    char value[8] = {0};
+    char response[320] = {0};
+    esp_ip4_addr_t cached_ip;
+    ns_wifi_cache_t cache;
+    uint32_t attempts;
+    uint32_t backoff_ms;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (httpd_query_key_value(query, "static_ip", value, sizeof(value)) == ESP_OK) {
+            bool enabled = strcmp(value, "1") == 0;
+
+            if (!ns_wifi_cache_set_static_ip(enabled)) {
+                httpd_resp_set_status(req, "500 Internal Server Error");
+                ns_http_send_json(req, "{\"ok\":false,\"error\":\"save failed\"}");
+                return ESP_OK;
+            }
+            s_static_ip = enabled;
+        }
+        if (httpd_query_key_value(query, "forget", value, sizeof(value)) == ESP_OK &&
+            strcmp(value, "1") == 0) {
+            memset(&cache, 0, sizeof(cache));
+            ns_wifi_cache_forget();
+            ns_wifi_link_cache_set(&cache);
+        }
+    }
+
+    ns_wifi_link_cache_get(&cache);
+    cached_ip.addr = cache.ip;
+    taskENTER_CRITICAL(&s_connect_lock);
+    attempts = s_connect_attempts;
+    backoff_ms = s_backoff_ms;
+    taskEXIT_CRITICAL(&s_connect_lock);
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"connected\":%s,\"static_ip\":%s,\"attempts\":%u,"
+             "\"backoff_ms\":%u,\"cache\":{\"valid\":%s,"
+             "\"bssid\":\"%02x:%02x:%02x:%02x:%02x:%02x\",\"channel\":%u,\"ip\":\"" IPSTR "\"}}",
+             s_sta_connected ? "true" : "false", s_static_ip ? "true" : "false",
+             (unsigned)attempts, (unsigned)backoff_ms,
+             cache.valid ? "true" : "false",
+             cache.bssid[0], cache.bssid[1], cache.bssid[2],
+             cache.bssid[3], cache.bssid[4], cache.bssid[5],
+             (unsigned)cache.channel,
+             IP2STR(&cached_ip));
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_latency_get_handler(httpd_req_t *req)
+{
+    char query[48] = {0};
+    char name[16] = {0};
+    char response[224] = {0};
+    ns_wifi_profile_status_t status;
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "profile", name, sizeof(name)) == ESP_OK) {
+        ns_wifi_profile_t profile;
+
+        if (!ns_wifi_profile_from_name(name, &profile)) {
+            httpd_resp_set_status(req, "400 Bad Request");
+            ns_http_send_json(req, "{\"ok\":false,\"error\":\"profile must be balanced, low_latency or power_save\"}");
+            return ESP_OK;
+        }
+        if (!s_wifi_inited || ns_wifi_profile_apply(profile) != ESP_OK) {
+            httpd_resp_set_status(req, "503 Service Unavailable");
+            ns_http_send_json(req, "{\"ok\":false,\"error\":\"apply profile failed\"}");
+            return ESP_OK;
+        }
+        ns_wifi_profile_save(profile);
+    }
+
+    ns_wifi_profile_get_status(&status);
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"profile\":\"%s\",\"power_save\":\"%s\",\"max_tx_power_dbm\":%.2f,"
+             "\"protocol\":\"%s%s%s\",\"ht40\":%s}",
+             ns_wifi_profile_name(status.profile), status.power_save,
+             status.max_tx_power_qdbm / 4.0,
+             (status.protocol_bitmap & WIFI_PROTOCOL_11B) ? "b" : "",
+             (status.protocol_bitmap & WIFI_PROTOCOL_11G) ? "g" : "",
+             (status.protocol_bitmap & WIFI_PROTOCOL_11N) ? "n" : "",
+             status.ht40 ? "true" : "false");
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static int ns_probe_dist_json(char *buf, size_t len, const char *name, const ns_udp_probe_dist_t *dist)
+{
+    return snprintf(buf, len,
+                    "\"%s\":{\"samples\":%u,\"min_us\":%u,\"avg_us\":%u,\"p50_us\":%u,"
+                    "\"p95_us\":%u,\"p99_us\":%u,\"max_us\":%u}",
+                    name, (unsigned)dist->samples, (unsigned)dist->min_us, (unsigned)dist->avg_us,
+                    (unsigned)dist->p50_us, (unsigned)dist->p95_us, (unsigned)dist->p99_us,
+                    (unsigned)dist->max_us);
+}
+
+static esp_err_t ns_probe_get_handler(httpd_req_t *req)
+{
+    char query[32] = {0};
+    char reset[4] = {0};
+    char response[448] = {0};
+    ns_udp_probe_stats_t stats;
+    int len;
+
+    ns_udp_stream_get_probe_stats(&stats);
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "reset", reset, sizeof(reset)) == ESP_OK && strcmp(reset, "1") == 0) {
+        ns_udp_stream_reset_probe_stats();
+    }
+
+    len = snprintf(response, sizeof(response),
+                   "{\"ok\":true,\"port\":%d,\"probes\":%u,\"clock_ahead\":%u,\"device_max_us\":%u,",
+                   NS_UDP_STREAM_PORT, (unsigned)stats.probes, (unsigned)stats.clock_ahead,
+                   (unsigned)stats.device_max_us);
+    len += ns_probe_dist_json(&response[len], sizeof(response) - (size_t)len, "rtt", &stats.rtt);
+    len += snprintf(&response[len], sizeof(response) - (size_t)len, ",");
+    len += ns_probe_dist_json(&response[len], sizeof(response) - (size_t)len, "one_way", &stats.one_way);
+    snprintf(&response[len], sizeof(response) - (size_t)len, "}");
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_uart_get_handler(httpd_req_t *req)
+{
+    ns_uart_link_stats_t stats;
+    char response[384] = {0};
+
+    ns_uart_link_get_stats(&stats);
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"active\":%s,\"baud\":%u,\"rx_bytes\":%u,\"frames\":%u,"
+             "\"states\":%u,\"time_syncs\":%u,\"bad_crc\":%u,\"bad_cobs\":%u,\"too_long\":%u,"
+             "\"unknown\":%u,\"overflows\":%u,\"line_errors\":%u,\"apply_max_us\":%u}",
+             stats.active ? "true" : "false", (unsigned)stats.baud, (unsigned)stats.rx_bytes,
+             (unsigned)stats.frames, (unsigned)stats.states, (unsigned)stats.time_syncs,
+             (unsigned)stats.bad_crc, (unsigned)stats.bad_cobs, (unsigned)stats.too_long,
+             (unsigned)stats.unknown, (unsigned)stats.overflows, (unsigned)stats.line_errors,
+             (unsigned)stats.apply_max_us);
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_time_get_handler(httpd_req_t *req)
+{
+    ns_input_sched_stats_t sched;
+    char response[288] = {0};
+    int64_t now = esp_timer_get_time();
+
+    ns_input_sched_get_stats(&sched);
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"device_us\":%lld,\"sync_port\":%d,\"sched\":{\"depth\":%u,"
+             "\"queued\":%u,\"applied\":%u,\"late\":%u,\"dropped_full\":%u,"
+             "\"max_late_us\":%u,\"max_fire_error_us\":%u}}",
+             (long long)now, NS_UDP_STREAM_PORT,
+             (unsigned)sched.depth, (unsigned)sched.queued, (unsigned)sched.applied,
+             (unsigned)sched.late, (unsigned)sched.dropped_full,
+             (unsigned)sched.max_late_us, (unsigned)sched.max_fire_error_us);
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_stream_get_handler(httpd_req_t *req)
+{
+    ns_udp_stream_stats_t stats;
+    char response[320] = {0};
+
+    ns_udp_stream_get_stats(&stats);
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"port\":%d,\"active\":%s,\"received\":%u,\"applied\":%u,"
+             "\"lost\":%u,\"reordered\":%u,\"duplicate\":%u,\"malformed\":%u,"
+             "\"timeouts\":%u,\"last_seq\":%u,\"jitter_us\":%u,\"sync_requests\":%u}",
+             NS_UDP_STREAM_PORT,
+             stats.active ? "true" : "false",
+             (unsigned)stats.received, (unsigned)stats.applied,
+             (unsigned)stats.lost, (unsigned)stats.reordered,
+             (unsigned)stats.duplicate, (unsigned)stats.malformed,
+             (unsigned)stats.timeouts, (unsigned)stats.last_seq,
+             (unsigned)stats.jitter_us, (unsigned)stats.sync_requests);
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_jitter_get_handler(httpd_req_t *req)
+{
+    ns_jitter_buffer_stats_t stats;
+    char response[288] = {0};
+
+    ns_jitter_buffer_get_stats(&stats);
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"active\":%s,\"depth\":%u,\"target_us\":%u,"
+             "\"jitter_p95_us\":%u,\"added_latency_us\":%u,\"pushed\":%u,"
+             "\"late\":%u,\"overflows\":%u,\"underruns\":%u}",
+             stats.active ? "true" : "false",
+             (unsigned)stats.depth, (unsigned)stats.target_us,
+             (unsigned)stats.jitter_p95_us, (unsigned)stats.added_latency_us,
+             (unsigned)stats.pushed, (unsigned)stats.late,
+             (unsigned)stats.overflows, (unsigned)stats.underruns);
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
 static esp_err_t ns_root_get_handler(httpd_req_t *req)
 {
     httpd_resp_set_type(req, "text/html; charset=utf-8");
@@ -345,9 +1002,65 @@ static esp_err_t ns_root_get_handler(httpd_req_t *req)
     return ESP_OK;
 }
 
+static esp_err_t ns_ui_get_handler(httpd_req_t *req)
+{
+    return ns_web_ui_send(req);
+}
+
+/*
+ * Persistent input socket for /ui: each binary message is one UDP stream
+ * state packet (ns_udp_stream.h), applied to the client's layer. Ordering is
+ * guaranteed by TCP, so sequence numbers are not checked here.
+ */
+static esp_err_t ns_ws_handler(httpd_req_t *req)
+{
+    uint8_t pkt[NS_UDP_STREAM_PACKET_LEN];
+    httpd_ws_frame_t frame = {0};
+    ns_input_state_t input;
+    uint64_t timestamp_us = 0;
+    uint8_t layer;
+
+    if (req->method == HTTP_GET) {
+        int nodelay = 1;
+
+        /* Handshake only; the client drives everything after this. */
+        setsockopt(httpd_req_to_sockfd(req), IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+        return ESP_OK;
+    }
+
+    if (httpd_ws_recv_frame(req, &frame, 0) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    if (frame.len > sizeof(pkt)) {
+        /* The payload cannot be skipped without reading it; drop the session instead. */
+        ESP_LOGW(TAG, "ws frame too long: %u", (unsigned)frame.len);
+        return ESP_FAIL;
+    }
+    frame.payload = pkt;
+    if (frame.len > 0 && httpd_ws_recv_frame(req, &frame, sizeof(pkt)) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    if (frame.type != HTTPD_WS_TYPE_BINARY ||
+        !ns_udp_stream_parse_state(pkt, frame.len, &input, &timestamp_us)) {
+        return ESP_OK;
+    }
+
+    layer = ns_http_client_layer(req, true);
+    if (layer == NS_INPUT_LAYER_NONE) {
+        return ESP_OK;
+    }
+    ns_http_set_lease(layer, NS_WS_LEASE_MS);
+    if (pkt[3] & NS_UDP_STREAM_FLAG_AT) {
+        ns_input_sched_push(layer, (int64_t)timestamp_us, &input);
+    } else {
+        ns_input_layer_set(layer, &input, NS_WS_LEASE_MS);
+    }
+    return ESP_OK;
+}
+
 static esp_err_t ns_auto_get_handler(httpd_req_t *req)
 {
-    ns_button_release_now();
+    ns_button_release_layer(ns_http_client_layer(req, false));
     ns_http_send_json(req, "{\"ok\":true,\"mode\":\"auto\"}");
     return ESP_OK;
 }
@@ -355,19 +1068,27 @@ static esp_err_t ns_auto_get_handler(httpd_req_t *req)
 static esp_err_t ns_button_get_handler(httpd_req_t *req)
 {
     ns_button_id_t button = NS_BUTTON_NONE;
+    uint32_t lease_ms = ns_parse_lease_ms(req);
+    uint8_t layer;
 
     if (!ns_parse_button_from_query(req, &button)) {
         httpd_resp_set_status(req, "400 Bad Request");
         ns_http_send_json(req, "{\"ok\":false,\"error\":\"use name=<A|B|X|Y...> or id=<0..18>\"}");
         return ESP_OK;
     }
+    layer = ns_http_client_layer(req, true);
+    if (!ns_http_require_layer(req, layer)) {
+        return ESP_OK;
+    }
 
-    ns_button_press_for_ms(button, 0);
+    ns_button_press_for_ms(layer, button, 0, lease_ms);
 
-    char response[96] = {0};
+    char response[128] = {0};
     snprintf(response, sizeof(response),
-             "{\"ok\":true,\"mode\":\"manual\",\"button\":\"%s\",\"id\":%d}",
-             ns_button_name(button), (int)button);
+             "{\"ok\":true,\"mode\":\"manual\",\"button\":\"%s\",\"id\":%d,"
+             "\"layer\":\"%s\",\"lease_ms\":%u}",
+             ns_protocol_button_name(button), (int)button, ns_input_layer_name(layer),
+             (unsigned)lease_ms);
     ns_http_send_json(req, response);
     return ESP_OK;
 }
@@ -375,18 +1096,24 @@ static esp_err_t ns_button_get_handler(httpd_req_t *req)
 static esp_err_t ns_press_get_handler(httpd_req_t *req)
 {
     ns_button_id_t button = NS_BUTTON_NONE;
+    uint8_t layer;
 
     if (!ns_parse_button_from_query(req, &button)) {
         httpd_resp_set_status(req, "400 Bad Request");
         ns_http_send_json(req, "{\"ok\":false,\"error\":\"use name=<A|B|X|Y...> or id=<0..18>\"}");
         return ESP_OK;
     }
+    layer = ns_http_client_layer(req, true);
+    if (!ns_http_require_layer(req, layer)) {
+        return ESP_OK;
+    }
 
-    ns_button_press_for_ms(button, NS_PRESS_DEFAULT_MS);
+    /* Timed presses release themselves; no lease needed. */
+    ns_button_press_for_ms(layer, button, NS_PRESS_DEFAULT_MS, 0);
     char response[128] = {0};
     snprintf(response, sizeof(response),
              "{\"ok\":true,\"mode\":\"press\",\"button\":\"%s\",\"id\":%d,\"ms\":%d}",
-             ns_button_name(button), (int)button, NS_PRESS_DEFAULT_MS);
+             ns_protocol_button_name(button), (int)button, NS_PRESS_DEFAULT_MS);
     ns_http_send_json(req, response);
     return ESP_OK;
 }
@@ -397,6 +1124,7 @@ static esp_err_t ns_hold_get_handler(httpd_req_t *req)
     char ms_buf[16] = {0};
     ns_button_id_t button = NS_BUTTON_NONE;
     uint32_t hold_ms = NS_PRESS_DEFAULT_MS;
+    uint8_t layer;
 
     if (!ns_parse_button_from_query(req, &button)) {
         httpd_resp_set_status(req, "400 Bad Request");
@@ -410,29 +1138,569 @@ static esp_err_t ns_hold_get_handler(httpd_req_t *req)
         char *end = NULL;
         long parsed_ms = strtol(ms_buf, &end, 10);
         if (end != ms_buf && *end == '\0') {
-            if (parsed_ms < NS_HOLD_MIN_MS) {
-                parsed_ms = NS_HOLD_MIN_MS;
-            } else if (parsed_ms > NS_HOLD_MAX_MS) {
-                parsed_ms = NS_HOLD_MAX_MS;
-            }
-            hold_ms = (uint32_t)parsed_ms;
+            hold_ms = ns_clamp_hold_ms(parsed_ms);
         }
     }
 
-    ns_button_press_for_ms(button, hold_ms);
+    layer = ns_http_client_layer(req, true);
+    if (!ns_http_require_layer(req, layer)) {
+        return ESP_OK;
+    }
+
+    ns_button_press_for_ms(layer, button, hold_ms, 0);
     char response[128] = {0};
     snprintf(response, sizeof(response),
              "{\"ok\":true,\"mode\":\"hold\",\"button\":\"%s\",\"id\":%d,\"ms\":%u}",
-             ns_button_name(button), (int)button, (unsigned)hold_ms);
+             ns_protocol_button_name(button), (int)button, (unsigned)hold_ms);
     ns_http_send_json(req, response);
     return ESP_OK;
 }
 
-static esp_err_t ns_release_get_handler(httpd_req_t *req)
+static bool ns_state_parse_axis(const char *js, const ns_json_tok_t *tok, uint16_t *out)
 {
-    ns_button_release_now();
-    ns_http_send_json(req, "{\"ok\":true,\"mode\":\"release\"}");
-    return ESP_OK;
+    long value;
+
+    if (!ns_json_tok_int(js, tok, &value) || value < 0 || value > NS_STICK_AXIS_MAX) {
+        return false;
+    }
+    *out = (uint16_t)value;
+    return true;
+}
+
+static bool ns_state_parse_buttons(const char *js, const ns_json_tok_t *toks, int count,
+                                   int index, uint32_t *out_mask)
+{
+    long mask;
+    int child;
+    int end;
+
+    if (toks[index].type == NS_JSON_PRIMITIVE) {
+        if (!ns_json_tok_int(js, &toks[index], &mask) || mask < 0 ||
+            ((uint32_t)mask & ~NS_BUTTON_MASK_ALL) != 0) {
+            return false;
+        }
+        *out_mask = (uint32_t)mask;
+        return true;
+    }
+
+    if (toks[index].type != NS_JSON_ARRAY) {
+        return false;
+    }
+
+    *out_mask = 0;
+    end = ns_json_next(toks, count, index);
+    for (child = index + 1; child < end; child++) {
+        char name[16] = {0};
+        size_t name_len = (size_t)(toks[child].end - toks[child].start);
+        ns_button_id_t button;
+
+        if (toks[child].type != NS_JSON_STRING || name_len >= sizeof(name)) {
+            return false;
+        }
+        memcpy(name, &js[toks[child].start], name_len);
+        if (!ns_protocol_button_from_name(name, &button)) {
+            return false;
+        }
+        if (button != NS_BUTTON_NONE) {
+            *out_mask |= NS_BUTTON_MASK(button);
+        }
+    }
+    return true;
+}
+
+static bool ns_state_parse_vec3(const char *js, const ns_json_tok_t *toks, int index, int16_t out[3])
+{
+    if (toks[index].type != NS_JSON_ARRAY || toks[index].size != 3) {
+        return false;
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        long value;
+        if (!ns_json_tok_int(js, &toks[index + 1 + axis], &value) ||
+            value < INT16_MIN || value > INT16_MAX) {
+            return false;
+        }
+        out[axis] = (int16_t)value;
+    }
+    return true;
+}
+
+static bool ns_state_parse_imu(const char *js, const ns_json_tok_t *toks, int count,
+                               int index, ns_input_state_t *input)
+{
+    int end;
+    int key;
+
+    if (toks[index].type != NS_JSON_OBJECT) {
+        return false;
+    }
+
+    end = ns_json_next(toks, count, index);
+    for (key = index + 1; key + 1 < end; key = ns_json_next(toks, count, key + 1)) {
+        if (ns_json_tok_eq(js, &toks[key], "accel")) {
+            if (!ns_state_parse_vec3(js, toks, key + 1, input->accel)) {
+                return false;
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "gyro")) {
+            if (!ns_state_parse_vec3(js, toks, key + 1, input->gyro)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    input->imu_override = true;
+    return true;
+}
+
+/*
+ * Parses {"buttons":[..]|mask,"lx".."ry":0..4095,"imu":{"accel":[3],"gyro":[3]},
+ * "hold_ms":N,"at_us":T}. at_us is device time (see /time and the UDP sync);
+ * pass at_us as NULL where scheduling is not allowed.
+ */
+static const char *ns_state_parse_object(const char *js, const ns_json_tok_t *toks, int count,
+                                         int index, ns_input_state_t *input,
+                                         long *hold_ms, int64_t *at_us)
+{
+    int end;
+    int key;
+
+    if (toks[index].type != NS_JSON_OBJECT) {
+        return "state must be a JSON object";
+    }
+    end = ns_json_next(toks, count, index);
+
+    memset(input, 0, sizeof(*input));
+    input->lx = NS_STICK_CENTER;
+    input->ly = NS_STICK_CENTER;
+    input->rx = NS_STICK_CENTER;
+    input->ry = NS_STICK_CENTER;
+    *hold_ms = 0;
+    if (at_us != NULL) {
+        *at_us = 0;
+    }
+
+    for (key = index + 1; key + 1 < end; key = ns_json_next(toks, count, key + 1)) {
+        const ns_json_tok_t *val = &toks[key + 1];
+
+        if (ns_json_tok_eq(js, &toks[key], "buttons")) {
+            if (!ns_state_parse_buttons(js, toks, count, key + 1, &input->buttons)) {
+                return "invalid buttons";
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "lx")) {
+            if (!ns_state_parse_axis(js, val, &input->lx)) {
+                return "lx must be 0..4095";
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "ly")) {
+            if (!ns_state_parse_axis(js, val, &input->ly)) {
+                return "ly must be 0..4095";
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "rx")) {
+            if (!ns_state_parse_axis(js, val, &input->rx)) {
+                return "rx must be 0..4095";
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "ry")) {
+            if (!ns_state_parse_axis(js, val, &input->ry)) {
+                return "ry must be 0..4095";
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "imu")) {
+            if (!ns_state_parse_imu(js, toks, count, key + 1, input)) {
+                return "imu must be {accel:[x,y,z],gyro:[p,r,y]}";
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "hold_ms")) {
+            if (!ns_json_tok_int(js, val, hold_ms) || *hold_ms < 0) {
+                return "invalid hold_ms";
+            }
+        } else if (at_us != NULL && ns_json_tok_eq(js, &toks[key], "at_us")) {
+            char num[24] = {0};
+            size_t num_len = (size_t)(val->end - val->start);
+            char *num_end = NULL;
+
+            if (val->type != NS_JSON_PRIMITIVE || num_len == 0 || num_len >= sizeof(num)) {
+                return "invalid at_us";
+            }
+            memcpy(num, &js[val->start], num_len);
+            *at_us = (int64_t)strtoll(num, &num_end, 10);
+            if (*num_end != '\0' || *at_us <= 0) {
+                return "invalid at_us";
+            }
+        } else {
+            return "unknown key";
+        }
+    }
+    return NULL;
+}
+
+static const char *ns_state_parse(const char *js, size_t len, ns_input_state_t *input,
+                                  long *hold_ms, int64_t *at_us)
+{
+    ns_json_tok_t toks[NS_STATE_MAX_TOKENS];
+    int count = ns_json_parse(js, len, toks, NS_STATE_MAX_TOKENS);
+
+    if (count < 1 || toks[0].type != NS_JSON_OBJECT) {
+        return "body must be a JSON object";
+    }
+    return ns_state_parse_object(js, toks, count, 0, input, hold_ms, at_us);
+}
+
+static esp_err_t ns_state_post_handler(httpd_req_t *req)
+{
+    char body[NS_STATE_BODY_MAX];
+    ns_input_state_t input;
+    const char *error;
+    long hold_ms = 0;
+    int64_t at_us = 0;
+    uint32_t applied_hold_ms = 0;
+    uint32_t lease_ms = ns_parse_lease_ms(req);
+    bool scheduled = true;
+    uint8_t layer;
+
+    if (req->content_len == 0 || req->content_len >= sizeof(body)) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        ns_http_send_json(req, "{\"ok\":false,\"error\":\"body required (max 511 bytes)\"}");
+        return ESP_OK;
+    }
+
+    if (ns_http_recv_body(req, body, req->content_len) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    body[req->content_len] = '\0';
+
+    error = ns_state_parse(body, req->content_len, &input, &hold_ms, &at_us);
+    if (error != NULL) {
+        char response[128] = {0};
+        snprintf(response, sizeof(response), "{\"ok\":false,\"error\":\"%s\"}", error);
+        httpd_resp_set_status(req, "400 Bad Request");
+        ns_http_send_json(req, response);
+        return ESP_OK;
+    }
+
+    layer = ns_http_client_layer(req, true);
+    if (!ns_http_require_layer(req, layer)) {
+        return ESP_OK;
+    }
+
+    if (hold_ms > 0) {
+        applied_hold_ms = ns_clamp_hold_ms(hold_ms);
+        lease_ms = 0;
+    }
+    ns_http_set_lease(layer, lease_ms);
+    if (at_us > 0) {
+        scheduled = ns_input_sched_push(layer, at_us, &input);
+        if (scheduled && applied_hold_ms > 0) {
+            scheduled = ns_input_sched_push(layer, at_us + (int64_t)applied_hold_ms * 1000LL, NULL);
+        }
+    } else {
+        ns_button_arm_release(layer, applied_hold_ms);
+        ns_input_layer_set(layer, &input, lease_ms);
+    }
+
+    if (!scheduled) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        ns_http_send_json(req, "{\"ok\":false,\"error\":\"schedule queue full\"}");
+        return ESP_OK;
+    }
+
+    char response[256] = {0};
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"mode\":\"state\",\"buttons\":%u,\"lx\":%u,\"ly\":%u,"
+             "\"rx\":%u,\"ry\":%u,\"imu\":%s,\"hold_ms\":%u,\"at_us\":%lld,"
+             "\"layer\":\"%s\",\"lease_ms\":%u}",
+             (unsigned)input.buttons, input.lx, input.ly, input.rx, input.ry,
+             input.imu_override ? "true" : "false", (unsigned)applied_hold_ms,
+             (long long)at_us, ns_input_layer_name(layer), (unsigned)lease_ms);
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_macro_post_handler(httpd_req_t *req)
+{
+    char query[32] = {0};
+    char run[4] = {0};
+    char error[96] = {0};
+    char response[192] = {0};
+    ns_macro_status_t status;
+    char *src;
+    bool loaded;
+
+    if (req->content_len == 0 || req->content_len > NS_MACRO_SOURCE_MAX) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        ns_http_send_json(req, "{\"ok\":false,\"error\":\"body required (max 32768 bytes)\"}");
+        return ESP_OK;
+    }
+
+    src = ns_macro_alloc(req->content_len);
+    if (src == NULL) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        ns_http_send_json(req, "{\"ok\":false,\"error\":\"out of memory\"}");
+        return ESP_OK;
+    }
+
+    if (ns_http_recv_body(req, src, req->content_len) != ESP_OK) {
+        ns_macro_free(src);
+        return ESP_FAIL;
+    }
+
+    loaded = ns_macro_load(src, req->content_len, error, sizeof(error));
+    ns_macro_free(src);
+    if (!loaded) {
+        snprintf(response, sizeof(response), "{\"ok\":false,\"error\":\"%s\"}", error);
+        httpd_resp_set_status(req, "400 Bad Request");
+        ns_http_send_json(req, response);
+        return ESP_OK;
+    }
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "run", run, sizeof(run)) == ESP_OK && strcmp(run, "1") == 0) {
+        ns_button_release_layer(ns_http_client_layer(req, false));
+        ns_macro_request_start();
+    }
+
+    ns_macro_get_status(&status);
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"mode\":\"macro\",\"instructions\":%u,\"bytes\":%u,\"running\":%s}",
+             (unsigned)status.instructions, (unsigned)status.code_bytes,
+             status.running ? "true" : "false");
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_macro_get_handler(httpd_req_t *req)
+{
+    ns_macro_status_t status;
+    char response[256] = {0};
+
+    ns_macro_get_status(&status);
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"loaded\":%s,\"running\":%s,\"instructions\":%u,\"bytes\":%u,"
+             "\"pc\":%u,\"runs\":%u,\"elapsed_us\":%lld,\"max_late_us\":%u}",
+             status.loaded ? "true" : "false", status.running ? "true" : "false",
+             (unsigned)status.instructions, (unsigned)status.code_bytes,
+             (unsigned)status.pc, (unsigned)status.runs,
+             (long long)status.elapsed_us, (unsigned)status.max_late_us);
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_macro_start_get_handler(httpd_req_t *req)
+{
+    ns_button_release_layer(ns_http_client_layer(req, false));
+    if (!ns_macro_request_start()) {
+        httpd_resp_set_status(req, "409 Conflict");
+        ns_http_send_json(req, "{\"ok\":false,\"error\":\"no macro loaded\"}");
+        return ESP_OK;
+    }
+    ns_http_send_json(req, "{\"ok\":true,\"mode\":\"macro\",\"running\":true}");
+    return ESP_OK;
+}
+
+static esp_err_t ns_macro_stop_get_handler(httpd_req_t *req)
+{
+    ns_macro_stop();
+    ns_http_send_json(req, "{\"ok\":true,\"mode\":\"macro\",\"running\":false}");
+    return ESP_OK;
+}
+
+static bool ns_rule_parse_ms(const char *js, const ns_json_tok_t *tok, uint32_t *out)
+{
+    long value;
+
+    if (!ns_json_tok_int(js, tok, &value) || value < 0 || value > NS_HOLD_MAX_MS) {
+        return false;
+    }
+    *out = (uint32_t)value;
+    return true;
+}
+
+/*
+ * Parses {"on":"rumble","ge":40,"state":{...},"delay_ms":N,"cooldown_ms":N,"once":false}
+ * or the same with "macro":true instead of "state".
+ */
+static const char *ns_rule_parse(const char *js, const ns_json_tok_t *toks, int count,
+                                 int index, ns_rule_t *rule)
+{
+    bool has_trigger = false;
+    bool has_action = false;
+    int end;
+    int key;
+
+    if (toks[index].type != NS_JSON_OBJECT) {
+        return "rule must be a JSON object";
+    }
+    memset(rule, 0, sizeof(*rule));
+    end = ns_json_next(toks, count, index);
+
+    for (key = index + 1; key + 1 < end; key = ns_json_next(toks, count, key + 1)) {
+        const ns_json_tok_t *val = &toks[key + 1];
+        long value;
+
+        if (ns_json_tok_eq(js, &toks[key], "on")) {
+            if (val->type != NS_JSON_STRING ||
+                !ns_rules_trigger_from_name(&js[val->start], (size_t)(val->end - val->start),
+                                            &rule->trigger)) {
+                return "unknown trigger";
+            }
+            has_trigger = true;
+        } else if (ns_json_tok_eq(js, &toks[key], "eq") || ns_json_tok_eq(js, &toks[key], "ge")) {
+            if (!ns_json_tok_int(js, val, &value) || value < 0) {
+                return "invalid match value";
+            }
+            rule->match = ns_json_tok_eq(js, &toks[key], "eq") ? NS_RULE_MATCH_EQ : NS_RULE_MATCH_GE;
+            rule->value = (uint32_t)value;
+        } else if (ns_json_tok_eq(js, &toks[key], "state")) {
+            long hold_ms = 0;
+            const char *error = ns_state_parse_object(js, toks, count, key + 1, &rule->state,
+                                                      &hold_ms, NULL);
+
+            if (error != NULL) {
+                return error;
+            }
+            rule->action = NS_RULE_ACTION_STATE;
+            rule->hold_ms = hold_ms > 0 ? ns_clamp_hold_ms(hold_ms) : 0;
+            has_action = true;
+        } else if (ns_json_tok_eq(js, &toks[key], "macro")) {
+            bool macro;
+
+            if (!ns_json_tok_bool(js, val, &macro) || !macro) {
+                return "macro must be true";
+            }
+            rule->action = NS_RULE_ACTION_MACRO;
+            has_action = true;
+        } else if (ns_json_tok_eq(js, &toks[key], "delay_ms")) {
+            if (!ns_rule_parse_ms(js, val, &rule->delay_ms)) {
+                return "invalid delay_ms";
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "cooldown_ms")) {
+            if (!ns_rule_parse_ms(js, val, &rule->cooldown_ms)) {
+                return "invalid cooldown_ms";
+            }
+        } else if (ns_json_tok_eq(js, &toks[key], "once")) {
+            if (!ns_json_tok_bool(js, val, &rule->once)) {
+                return "invalid once";
+            }
+        } else {
+            return "unknown rule key";
+        }
+    }
+
+    if (!has_trigger) {
+        return "rule needs \"on\"";
+    }
+    if (!has_action) {
+        return "rule needs \"state\" or \"macro\"";
+    }
+    return NULL;
+}
+
+/* Parsed rules before they replace the table; only the HTTP server task uses it. */
+static ns_rule_t s_rules_upload[NS_RULES_MAX];
+
+static esp_err_t ns_rules_post_handler(httpd_req_t *req)
+{
+    ns_rule_t *rules = s_rules_upload;
+    ns_json_tok_t *toks = NULL;
+    char response[128] = {0};
+    const char *error = NULL;
+    uint8_t rule_count = 0;
+    char *body;
+    int count;
+
+    if (req->content_len == 0 || req->content_len >= NS_RULES_BODY_MAX) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        ns_http_send_json(req, "{\"ok\":false,\"error\":\"body required (max 4095 bytes)\"}");
+        return ESP_OK;
+    }
+
+    body = malloc(req->content_len + 1);
+    toks = malloc(sizeof(ns_json_tok_t) * NS_RULES_MAX_TOKENS);
+    if (body == NULL || toks == NULL) {
+        free(body);
+        free(toks);
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        ns_http_send_json(req, "{\"ok\":false,\"error\":\"out of memory\"}");
+        return ESP_OK;
+    }
+
+    if (ns_http_recv_body(req, body, req->content_len) != ESP_OK) {
+        free(body);
+        free(toks);
+        return ESP_FAIL;
+    }
+    body[req->content_len] = '\0';
+
+    count = ns_json_parse(body, req->content_len, toks, NS_RULES_MAX_TOKENS);
+    if (count < 1 || toks[0].type != NS_JSON_OBJECT) {
+        error = "body must be a JSON object";
+    } else {
+        int end = ns_json_next(toks, count, 0);
+
+        for (int key = 1; key + 1 < end && error == NULL; key = ns_json_next(toks, count, key + 1)) {
+            int arr = key + 1;
+            int arr_end;
+
+            if (!ns_json_tok_eq(body, &toks[key], "rules") || toks[arr].type != NS_JSON_ARRAY) {
+                error = "expected {\"rules\":[...]}";
+                break;
+            }
+            if (toks[arr].size > NS_RULES_MAX) {
+                error = "too many rules (max 16)";
+                break;
+            }
+            arr_end = ns_json_next(toks, count, arr);
+            for (int item = arr + 1; item < arr_end && error == NULL;
+                 item = ns_json_next(toks, count, item)) {
+                error = ns_rule_parse(body, toks, count, item, &rules[rule_count]);
+                if (error == NULL) {
+                    rule_count++;
+                }
+            }
+        }
+    }
+
+    if (error != NULL) {
+        snprintf(response, sizeof(response), "{\"ok\":false,\"error\":\"rule %u: %s\"}",
+                 (unsigned)rule_count, error);
+        free(body);
+        free(toks);
+        httpd_resp_set_status(req, "400 Bad Request");
+        ns_http_send_json(req, response);
+        return ESP_OK;
+    }
+
+    free(body);
+    free(toks);
+    ns_rules_set(rules, rule_count);
+    snprintf(response, sizeof(response), "{\"ok\":true,\"mode\":\"rules\",\"count\":%u}",
+             (unsigned)rule_count);
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_rules_get_handler(httpd_req_t *req)
+{
+    ns_rules_status_t status;
+    char response[64 + NS_RULES_MAX * 12] = {0};
+    int len;
+
+    ns_rules_get_status(&status);
+    len = snprintf(response, sizeof(response), "{\"ok\":true,\"count\":%u,\"evaluated\":%u,\"fired\":[",
+                   (unsigned)status.count, (unsigned)status.evaluated);
+    for (uint8_t i = 0; i < status.count && len < (int)sizeof(response); i++) {
+        len += snprintf(&response[len], sizeof(response) - (size_t)len, "%s%u",
+                        i == 0 ? "" : ",", (unsigned)status.fired[i]);
+    }
+    if (len < (int)sizeof(response)) {
+        snprintf(&response[len], sizeof(response) - (size_t)len, "]}");
+    }
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_release_get_handler(httpd_req_t *req)
+{
+    ns_button_release_layer(ns_http_client_layer(req, false));
+    ns_http_send_json(req, "{\"ok\":true,\"mode\":\"release\"}");
+    return ESP_OK;
 }
 
 static esp_err_t ns_provision_get_handler(httpd_req_t *req)
@@ -440,6 +1708,7 @@ static esp_err_t ns_provision_get_handler(httpd_req_t *req)
     char query[192] = {0};
     char ssid[33] = {0};
     char pass[65] = {0};
+    ns_wifi_cache_t cache;
     int query_len = httpd_req_get_url_query_len(req);
 
     if (query_len <= 0 || query_len >= (int)sizeof(query)) {
@@ -473,6 +1742,15 @@ static esp_err_t ns_provision_get_handler(httpd_req_t *req)
     s_wifi_creds_loaded = true;
     s_sta_connected = false;
     s_sta_ip[0] = '\0';
+    ns_wifi_cache_load(s_sta_ssid, &cache);
+    ns_wifi_link_cache_set(&cache);
+    taskENTER_CRITICAL(&s_connect_lock);
+    s_connect_attempts = 0;
+    s_connect_start_us = 0;
+    taskEXIT_CRITICAL(&s_connect_lock);
+    if (s_reconnect_timer != NULL) {
+        esp_timer_stop(s_reconnect_timer);
+    }
     ESP_LOGI(TAG, "Provision received: ssid=%s pass_len=%u",
              s_sta_ssid, (unsigned)strlen(s_sta_pass));
 
@@ -484,74 +1762,187 @@ static esp_err_t ns_provision_get_handler(httpd_req_t *req)
     return ESP_OK;
 }
 
+static void ns_metrics_write_chunk(void *ctx, const char *text)
+{
+    httpd_resp_send_chunk((httpd_req_t *)ctx, text, HTTPD_RESP_USE_STRLEN);
+}
+
+static esp_err_t ns_metrics_get_handler(httpd_req_t *req)
+{
+    wifi_ap_record_t ap_info;
+    char line[160];
+    int rssi = 0;
+
+    if (s_sta_connected && esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK) {
+        rssi = ap_info.rssi;
+    }
+
+    httpd_resp_set_type(req, "text/plain; version=0.0.4");
+    ns_metrics_render(ns_metrics_write_chunk, req);
+    snprintf(line, sizeof(line),
+             "# TYPE ns_wifi_connected gauge\nns_wifi_connected %d\n"
+             "# TYPE ns_wifi_rssi_dbm gauge\nns_wifi_rssi_dbm %d\n",
+             s_sta_connected ? 1 : 0, rssi);
+    httpd_resp_send_chunk(req, line, HTTPD_RESP_USE_STRLEN);
+    httpd_resp_send_chunk(req, NULL, 0);
+    return ESP_OK;
+}
+
+static esp_err_t ns_boot_get_handler(httpd_req_t *req)
+{
+    char response[320] = {0};
+    int len = snprintf(response, sizeof(response), "{\"ok\":true,\"phases_us\":{");
+
+    for (int phase = 0; phase < NS_BOOT_PHASE_COUNT && len < (int)sizeof(response); phase++) {
+        len += snprintf(&response[len], sizeof(response) - (size_t)len, "%s\"%s\":%lld",
+                        phase == 0 ? "" : ",", ns_boot_phase_name((ns_boot_phase_t)phase),
+                        (long long)ns_boot_phase_us((ns_boot_phase_t)phase));
+    }
+    if (len < (int)sizeof(response)) {
+        snprintf(&response[len], sizeof(response) - (size_t)len, "}}");
+    }
+    ns_http_send_json(req, response);
+    return ESP_OK;
+}
+
+static esp_err_t ns_layers_get_handler(httpd_req_t *req)
+{
+    char query[48] = {0};
+    char policy[16] = {0};
+    char line[288];
+    int64_t now = esp_timer_get_time();
+
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "policy", policy, sizeof(policy)) == ESP_OK) {
+        if (strcmp(policy, "priority") == 0) {
+            ns_input_layer_set_policy(NS_INPUT_STICKS_PRIORITY);
+        } else if (strcmp(policy, "latest") == 0) {
+            ns_input_layer_set_policy(NS_INPUT_STICKS_LATEST);
+        } else {
+            httpd_resp_set_status(req, "400 Bad Request");
+            ns_http_send_json(req, "{\"ok\":false,\"error\":\"policy must be priority or latest\"}");
+            return ESP_OK;
+        }
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    snprintf(line, sizeof(line), "{\"ok\":true,\"policy\":\"%s\",\"layers\":[",
+             ns_input_layer_get_policy() == NS_INPUT_STICKS_LATEST ? "latest" : "priority");
+    httpd_resp_send_chunk(req, line, HTTPD_RESP_USE_STRLEN);
+    for (uint8_t layer = 0; layer < NS_INPUT_LAYER_COUNT; layer++) {
+        ns_input_layer_info_t info;
+        char owner[24] = "";
+
+        ns_input_layer_get_info(layer, now, &info);
+        if (layer < NS_INPUT_LAYER_HTTP0 + NS_INPUT_HTTP_CLIENTS && info.owner != 0) {
+            if (info.owner & NS_HTTP_OWNER_SESSION) {
+                snprintf(owner, sizeof(owner), "session:%u", (unsigned)(info.owner & ~NS_HTTP_OWNER_SESSION));
+            } else {
+                snprintf(owner, sizeof(owner), "client:%08x", (unsigned)info.owner);
+            }
+        }
+        snprintf(line, sizeof(line),
+                 "%s{\"name\":\"%s\",\"active\":%s,\"priority\":%u,\"buttons\":%u,"
+                 "\"sticks\":%s,\"source\":%s,\"lease_left_ms\":%u,\"expired\":%u,"
+                 "\"owner\":\"%s\"}",
+                 layer == 0 ? "" : ",", ns_input_layer_name(layer),
+                 info.active ? "true" : "false", (unsigned)info.priority,
+                 (unsigned)info.buttons, info.has_sticks ? "true" : "false",
+                 info.has_source ? "true" : "false", (unsigned)info.lease_left_ms,
+                 (unsigned)info.expired, owner);
+        httpd_resp_send_chunk(req, line, HTTPD_RESP_USE_STRLEN);
+    }
+    httpd_resp_send_chunk(req, "]}", HTTPD_RESP_USE_STRLEN);
+    httpd_resp_send_chunk(req, NULL, 0);
+    return ESP_OK;
+}
+
+typedef struct {
+    const char *uri;
+    httpd_method_t method;
+    esp_err_t (*handler)(httpd_req_t *req);
+    bool websocket;
+} ns_http_route_t;
+
+static const ns_http_route_t s_http_routes[] = {
+    {"/", HTTP_GET, ns_root_get_handler},
+    {"/ui", HTTP_GET, ns_ui_get_handler},
+    {"/ws", HTTP_GET, ns_ws_handler, true},
+    {"/health", HTTP_GET, ns_health_get_handler},
+    {"/provision", HTTP_GET, ns_provision_get_handler},
+    {"/button", HTTP_GET, ns_button_get_handler},
+    {"/press", HTTP_GET, ns_press_get_handler},
+    {"/hold", HTTP_GET, ns_hold_get_handler},
+    {"/release", HTTP_GET, ns_release_get_handler},
+    {"/auto", HTTP_GET, ns_auto_get_handler},
+    {"/state", HTTP_POST, ns_state_post_handler},
+    {"/stream", HTTP_GET, ns_stream_get_handler},
+    {"/time", HTTP_GET, ns_time_get_handler},
+    {"/jitter", HTTP_GET, ns_jitter_get_handler},
+    {"/metrics", HTTP_GET, ns_metrics_get_handler},
+    {"/events", HTTP_GET, ns_event_stream_handler},
+    {"/macro", HTTP_POST, ns_macro_post_handler},
+    {"/macro", HTTP_GET, ns_macro_get_handler},
+    {"/macro/start", HTTP_GET, ns_macro_start_get_handler},
+    {"/macro/stop", HTTP_GET, ns_macro_stop_get_handler},
+    {"/rules", HTTP_POST, ns_rules_post_handler},
+    {"/rules", HTTP_GET, ns_rules_get_handler},
+    {"/layers", HTTP_GET, ns_layers_get_handler},
+    {"/boot", HTTP_GET, ns_boot_get_handler},
+    {"/wifi", HTTP_GET, ns_wifi_get_handler},
+    {"/latency", HTTP_GET, ns_latency_get_handler},
+    {"/probe", HTTP_GET, ns_probe_get_handler},
+    {"/uart", HTTP_GET, ns_uart_get_handler},
+};
+
+#define NS_HTTP_ROUTE_COUNT (sizeof(s_http_routes) / sizeof(s_http_routes[0]))
+
+_Static_assert(NS_HTTP_ROUTE_COUNT <= NS_METRICS_HTTP_ROUTES, "raise NS_METRICS_HTTP_ROUTES");
+
+/* Every route goes through here so handler time is accounted per endpoint. */
+static esp_err_t ns_http_route_handler(httpd_req_t *req)
+{
+    uint8_t route = (uint8_t)(uintptr_t)req->user_ctx;
+    int64_t start = esp_timer_get_time();
+    uint8_t layer = ns_http_client_layer(req, false);
+    esp_err_t err;
+
+    /* Any request from a client keeps its held input alive. */
+    if (layer != NS_INPUT_LAYER_NONE) {
+        ns_input_layer_renew(layer, ns_http_get_lease(layer));
+    }
+    err = s_http_routes[route].handler(req);
+
+    ns_metrics_http(route, (uint32_t)(esp_timer_get_time() - start));
+    return err;
+}
+
 static void ns_http_server_start(void)
 {
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     httpd_handle_t server = NULL;
 
-    httpd_uri_t root_uri = {
-        .uri = "/",
-        .method = HTTP_GET,
-        .handler = ns_root_get_handler,
-        .user_ctx = NULL,
-    };
-    httpd_uri_t health_uri = {
-        .uri = "/health",
-        .method = HTTP_GET,
-        .handler = ns_health_get_handler,
-        .user_ctx = NULL,
-    };
-    httpd_uri_t provision_uri = {
-        .uri = "/provision",
-        .method = HTTP_GET,
-        .handler = ns_provision_get_handler,
-        .user_ctx = NULL,
-    };
-    httpd_uri_t button_uri = {
-        .uri = "/button",
-        .method = HTTP_GET,
-        .handler = ns_button_get_handler,
-        .user_ctx = NULL,
-    };
-    httpd_uri_t press_uri = {
-        .uri = "/press",
-        .method = HTTP_GET,
-        .handler = ns_press_get_handler,
-        .user_ctx = NULL,
-    };
-    httpd_uri_t hold_uri = {
-        .uri = "/hold",
-        .method = HTTP_GET,
-        .handler = ns_hold_get_handler,
-        .user_ctx = NULL,
-    };
-    httpd_uri_t release_uri = {
-        .uri = "/release",
-        .method = HTTP_GET,
-        .handler = ns_release_get_handler,
-        .user_ctx = NULL,
-    };
-    httpd_uri_t auto_uri = {
-        .uri = "/auto",
-        .method = HTTP_GET,
-        .handler = ns_auto_get_handler,
-        .user_ctx = NULL,
-    };
-
     if (s_http_server_started) {
         return;
     }
 
+    config.max_uri_handlers = NS_HTTP_MAX_URI_HANDLERS;
+    ns_event_stream_start();
     ESP_ERROR_CHECK(httpd_start(&server, &config));
-    ESP_ERROR_CHECK(httpd_register_uri_handler(server, &root_uri));
-    ESP_ERROR_CHECK(httpd_register_uri_handler(server, &health_uri));
-    ESP_ERROR_CHECK(httpd_register_uri_handler(server, &provision_uri));
-    ESP_ERROR_CHECK(httpd_register_uri_handler(server, &button_uri));
-    ESP_ERROR_CHECK(httpd_register_uri_handler(server, &press_uri));
-    ESP_ERROR_CHECK(httpd_register_uri_handler(server, &hold_uri));
-    ESP_ERROR_CHECK(httpd_register_uri_handler(server, &release_uri));
-    ESP_ERROR_CHECK(httpd_register_uri_handler(server, &auto_uri));
+    for (uint8_t route = 0; route < NS_HTTP_ROUTE_COUNT; route++) {
+        httpd_uri_t uri = {
+            .uri = s_http_routes[route].uri,
+            .method = s_http_routes[route].method,
+            .handler = ns_http_route_handler,
+            .user_ctx = (void *)(uintptr_t)route,
+            .is_websocket = s_http_routes[route].websocket,
+        };
+
+        ESP_ERROR_CHECK(httpd_register_uri_handler(server, &uri));
+        ns_metrics_http_register(route, s_http_routes[route].uri);
+    }
     s_http_server_started = true;
+    ns_boot_mark(NS_BOOT_HTTP_READY);
     ESP_LOGI(TAG, "HTTP control ready on port %d", config.server_port);
 }
 
@@ -561,9 +1952,7 @@ static void ns_wifi_event_handler(void *arg, esp_event_base_t event_base, int32_
 
     if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
         ESP_LOGI(TAG, "WIFI_EVENT_STA_START");
-        if (s_wifi_creds_loaded) {
-            esp_wifi_connect();
-        }
+        ns_wifi_sta_connect();
         return;
     }
 
@@ -572,6 +1961,8 @@ static void ns_wifi_event_handler(void *arg, esp_event_base_t event_base, int32_
         ESP_LOGI(TAG, "WIFI_EVENT_STA_CONNECTED ssid=%.*s channel=%u authmode=%u",
                  event->ssid_len, (char *)event->ssid,
                  (unsigned)event->channel, (unsigned)event->authmode);
+        memcpy(s_connected_bssid, event->bssid, sizeof(s_connected_bssid));
+        s_connected_channel = event->channel;
         return;
     }
 
@@ -582,8 +1973,8 @@ static void ns_wifi_event_handler(void *arg, esp_event_base_t event_base, int32_
         ESP_LOGW(TAG, "WIFI_EVENT_STA_DISCONNECTED reason=%u ssid=%.*s",
                  (unsigned)event->reason, event->ssid_len, (char *)event->ssid);
         if (s_wifi_creds_loaded) {
-            esp_wifi_connect();
-            ESP_LOGW(TAG, "Wi-Fi disconnected, retry...");
+            ns_metrics_inc(NS_METRIC_WIFI_RECONNECT);
+            ns_wifi_schedule_reconnect();
         }
         return;
     }
@@ -593,6 +1984,8 @@ static void ns_wifi_event_handler(void *arg, esp_event_base_t event_base, int32_
         s_sta_connected = true;
         snprintf(s_sta_ip, sizeof(s_sta_ip), IPSTR, IP2STR(&event->ip_info.ip));
         ESP_LOGI(TAG, "Wi-Fi connected, IP: %s", s_sta_ip);
+        ns_boot_mark(NS_BOOT_WIFI_GOT_IP);
+        ns_wifi_link_up(event);
         return;
     }
 }
@@ -612,6 +2005,12 @@ static void ns_provision_button_init(void)
 static void ns_wifi_init(void)
 {
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    const esp_timer_create_args_t reconnect_timer_args = {
+        .callback = ns_wifi_reconnect_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "ns_wifi_retry",
+    };
     wifi_config_t ap_cfg = {
         .ap = {
             .ssid = NS_SETUP_AP_SSID,
@@ -627,7 +2026,8 @@ static void ns_wifi_init(void)
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
     esp_netif_create_default_wifi_ap();
-    esp_netif_create_default_wifi_sta();
+    s_sta_netif = esp_netif_create_default_wifi_sta();
+    ESP_ERROR_CHECK(esp_timer_create(&reconnect_timer_args, &s_reconnect_timer));
 
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
     ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID,
@@ -652,6 +2052,7 @@ static void ns_wifi_init(void)
     }
 
     ESP_ERROR_CHECK(esp_wifi_start());
+    ns_wifi_profile_apply(ns_wifi_profile_load());
     s_wifi_inited = true;
 
     if (s_provision_mode) {
@@ -660,7 +2061,7 @@ static void ns_wifi_init(void)
     }
 }
 
-void ns_wifi_control_start(void)
+static void ns_wifi_boot(void)
 {
     esp_err_t ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -669,7 +2070,40 @@ void ns_wifi_control_start(void)
     } else {
         ESP_ERROR_CHECK(ret);
     }
+    ns_boot_mark(NS_BOOT_NVS_READY);
+
+    ns_wifi_load_credentials();
+    ns_provision_button_init();
+    ns_wifi_init();
+    ns_boot_mark(NS_BOOT_WIFI_STARTED);
+    ns_http_server_start();
+    ns_udp_stream_start();
+    s_wifi_control_ready = true;
+}
+
+static void ns_wifi_boot_task(void *arg)
+{
+    uint32_t bits;
+
+    (void)arg;
+
+    ns_wifi_boot();
+    for (;;) {
+        if (xTaskNotifyWait(0, UINT32_MAX, &bits, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        if (bits & NS_WIFI_NOTIFY_RECONNECT) {
+            ns_wifi_sta_connect();
+        }
+        if (bits & NS_WIFI_NOTIFY_LINK_CACHE) {
+            ns_wifi_link_cache_flush();
+        }
+    }
+}
 
+void ns_wifi_control_start(void)
+{
+    s_wifi_control_ready = false;
     s_http_server_started = false;
     s_sta_connected = false;
     s_wifi_inited = false;
@@ -678,24 +2112,31 @@ void ns_wifi_control_start(void)
     s_provision_btn_pressed = false;
     s_provision_btn_triggered = false;
     s_provision_btn_press_start_us = 0;
-    s_button_auto_release_pending = false;
-    s_button_auto_release_deadline_us = 0;
-
-    ns_wifi_load_credentials();
-    ns_provision_button_init();
-    ns_wifi_init();
-    ns_http_server_start();
+    memset(s_button_auto_release_deadline_us, 0, sizeof(s_button_auto_release_deadline_us));
+    memset(s_client_lease_ms, 0, sizeof(s_client_lease_ms));
+
+    ns_input_sched_init();
+    ns_button_release_timers_init();
+    if (xTaskCreate(ns_wifi_boot_task, "ns_wifi_boot", NS_WIFI_BOOT_TASK_STACK, NULL,
+                    NS_WIFI_BOOT_TASK_PRIO, &s_wifi_task) != pdPASS) {
+        /* Slower first report and no link cache writes, but the device stays reachable. */
+        s_wifi_task = NULL;
+        ESP_LOGW(TAG, "create wifi boot task failed, bringing wifi up inline");
+        ns_wifi_boot();
+    }
 }
 
 void ns_wifi_control_periodic(void)
 {
-    int level = gpio_get_level(NS_PROVISION_TRIGGER_GPIO);
+    int level;
     int64_t now = esp_timer_get_time();
 
-    if (s_button_auto_release_pending && now >= s_button_auto_release_deadline_us) {
-        ns_button_release_now();
+    if (!s_wifi_control_ready) {
+        return;
     }
 
+    level = gpio_get_level(NS_PROVISION_TRIGGER_GPIO);
+
     if (level == 0) {
         if (!s_provision_btn_pressed) {
             s_provision_btn_pressed = true;
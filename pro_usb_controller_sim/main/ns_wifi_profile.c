@@ -0,0 +1,132 @@
+#include "ns_wifi_profile.h"
+
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_wifi.h"
+#include "nvs.h"
+
+static const char *TAG = "NS_WIFI_PROFILE";
+
+#define NS_WIFI_PROFILE_NAMESPACE "wifi_cfg"
+#define NS_WIFI_PROFILE_KEY "profile"
+
+typedef struct {
+    const char *name;
+    wifi_ps_type_t ps;
+    /* esp_wifi_set_max_tx_power() units: 0.25 dBm. */
+    int8_t max_tx_power;
+    uint8_t protocol;
+    wifi_bandwidth_t bandwidth;
+} ns_wifi_profile_cfg_t;
+
+static const ns_wifi_profile_cfg_t s_profiles[NS_WIFI_PROFILE_COUNT] = {
+    [NS_WIFI_PROFILE_BALANCED] = {
+        "balanced", WIFI_PS_MIN_MODEM, 80,
+        WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N, WIFI_BW_HT40,
+    },
+    /* HT20 trades peak rate for fewer retries next to busy 40 MHz neighbours. */
+    [NS_WIFI_PROFILE_LOW_LATENCY] = {
+        "low_latency", WIFI_PS_NONE, 80,
+        WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N, WIFI_BW_HT20,
+    },
+    [NS_WIFI_PROFILE_POWER_SAVE] = {
+        "power_save", WIFI_PS_MAX_MODEM, 60,
+        WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N, WIFI_BW_HT20,
+    },
+};
+
+static ns_wifi_profile_t s_profile = NS_WIFI_PROFILE_BALANCED;
+
+esp_err_t ns_wifi_profile_apply(ns_wifi_profile_t profile)
+{
+    const ns_wifi_profile_cfg_t *cfg;
+    esp_err_t err;
+
+    if (profile >= NS_WIFI_PROFILE_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    cfg = &s_profiles[profile];
+
+    err = esp_wifi_set_ps(cfg->ps);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "set_ps failed: %s", esp_err_to_name(err));
+        return err;
+    }
+    /* Protocol and bandwidth fail while STA is disabled (AP-only provisioning); not fatal. */
+    err = esp_wifi_set_protocol(WIFI_IF_STA, cfg->protocol);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "set_protocol skipped: %s", esp_err_to_name(err));
+    }
+    err = esp_wifi_set_bandwidth(WIFI_IF_STA, cfg->bandwidth);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "set_bandwidth skipped: %s", esp_err_to_name(err));
+    }
+    err = esp_wifi_set_max_tx_power(cfg->max_tx_power);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "set_max_tx_power failed: %s", esp_err_to_name(err));
+    }
+
+    s_profile = profile;
+    ESP_LOGI(TAG, "Wi-Fi profile: %s", cfg->name);
+    return ESP_OK;
+}
+
+ns_wifi_profile_t ns_wifi_profile_load(void)
+{
+    nvs_handle_t handle;
+    uint8_t value = NS_WIFI_PROFILE_BALANCED;
+
+    if (nvs_open(NS_WIFI_PROFILE_NAMESPACE, NVS_READONLY, &handle) == ESP_OK) {
+        nvs_get_u8(handle, NS_WIFI_PROFILE_KEY, &value);
+        nvs_close(handle);
+    }
+    return value < NS_WIFI_PROFILE_COUNT ? (ns_wifi_profile_t)value : NS_WIFI_PROFILE_BALANCED;
+}
+
+bool ns_wifi_profile_save(ns_wifi_profile_t profile)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(NS_WIFI_PROFILE_NAMESPACE, NVS_READWRITE, &handle);
+
+    if (err != ESP_OK) {
+        return false;
+    }
+    err = nvs_set_u8(handle, NS_WIFI_PROFILE_KEY, (uint8_t)profile);
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return err == ESP_OK;
+}
+
+void ns_wifi_profile_get_status(ns_wifi_profile_status_t *out)
+{
+    wifi_ps_type_t ps = WIFI_PS_NONE;
+    wifi_bandwidth_t bandwidth = WIFI_BW_HT20;
+
+    memset(out, 0, sizeof(*out));
+    out->profile = s_profile;
+    esp_wifi_get_ps(&ps);
+    esp_wifi_get_max_tx_power(&out->max_tx_power_qdbm);
+    esp_wifi_get_protocol(WIFI_IF_STA, &out->protocol_bitmap);
+    esp_wifi_get_bandwidth(WIFI_IF_STA, &bandwidth);
+    out->ht40 = bandwidth == WIFI_BW_HT40;
+    out->power_save = ps == WIFI_PS_NONE ? "none" : (ps == WIFI_PS_MIN_MODEM ? "min_modem" : "max_modem");
+}
+
+const char *ns_wifi_profile_name(ns_wifi_profile_t profile)
+{
+    return profile < NS_WIFI_PROFILE_COUNT ? s_profiles[profile].name : "unknown";
+}
+
+bool ns_wifi_profile_from_name(const char *name, ns_wifi_profile_t *out)
+{
+    for (int profile = 0; profile < NS_WIFI_PROFILE_COUNT; profile++) {
+        if (strcmp(name, s_profiles[profile].name) == 0) {
+            *out = (ns_wifi_profile_t)profile;
+            return true;
+        }
+    }
+    return false;
+}
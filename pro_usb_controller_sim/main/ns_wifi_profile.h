@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+typedef enum {
+    /* ESP-IDF defaults: modem sleep between DTIMs, full TX power. */
+    NS_WIFI_PROFILE_BALANCED = 0,
+    /* Radio always on, so inbound packets are not held until the next DTIM. */
+    NS_WIFI_PROFILE_LOW_LATENCY,
+    NS_WIFI_PROFILE_POWER_SAVE,
+    NS_WIFI_PROFILE_COUNT,
+} ns_wifi_profile_t;
+
+typedef struct {
+    ns_wifi_profile_t profile;
+    /* Read back from the driver, not the requested values. */
+    const char *power_save;
+    int8_t max_tx_power_qdbm;
+    uint8_t protocol_bitmap;
+    bool ht40;
+} ns_wifi_profile_status_t;
+
+/* Power save, TX power, protocol and bandwidth for the STA; call after esp_wifi_start(). */
+esp_err_t ns_wifi_profile_apply(ns_wifi_profile_t profile);
+ns_wifi_profile_t ns_wifi_profile_load(void);
+bool ns_wifi_profile_save(ns_wifi_profile_t profile);
+void ns_wifi_profile_get_status(ns_wifi_profile_status_t *out);
+const char *ns_wifi_profile_name(ns_wifi_profile_t profile);
+bool ns_wifi_profile_from_name(const char *name, ns_wifi_profile_t *out);
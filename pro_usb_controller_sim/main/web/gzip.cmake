@@ -0,0 +1,2 @@
+# cmake -DIN=<file> -DOUT=<file.gz> -P gzip.cmake
+file(ARCHIVE_CREATE OUTPUT "${OUT}" PATHS "${IN}" FORMAT raw COMPRESSION GZip COMPRESSION_LEVEL 9)
@@ -1,26 +1,47 @@
 #!/usr/bin/env python3
 import argparse
+import binascii
 import json
+import os
 import random
+import socket
+import struct
 import sys
 import time
 import urllib.error
 import urllib.parse
 import urllib.request
 
+# Each urllib call opens a new connection; the id keeps them on one input layer.
+CLIENT_ID = f"test-{os.getpid()}"
+
 
 def http_get_json(base_url: str, path: str, params: dict | None = None, timeout: float = 3.0) -> dict:
     query = ""
     if params:
         query = "?" + urllib.parse.urlencode(params)
     url = f"{base_url}{path}{query}"
-    req = urllib.request.Request(url=url, method="GET")
+    req = urllib.request.Request(url=url, method="GET", headers={"X-Client-Id": CLIENT_ID})
     opener = urllib.request.build_opener(urllib.request.ProxyHandler({}))
     with opener.open(req, timeout=timeout) as resp:
         body = resp.read().decode("utf-8", errors="replace")
     return json.loads(body)
 
 
+def http_post_json(base_url: str, path: str, body: dict, timeout: float = 3.0) -> dict:
+    data = json.dumps(body).encode("utf-8")
+    req = urllib.request.Request(
+        url=f"{base_url}{path}",
+        data=data,
+        method="POST",
+        headers={"Content-Type": "application/json", "X-Client-Id": CLIENT_ID},
+    )
+    opener = urllib.request.build_opener(urllib.request.ProxyHandler({}))
+    with opener.open(req, timeout=timeout) as resp:
+        body_text = resp.read().decode("utf-8", errors="replace")
+    return json.loads(body_text)
+
+
 def assert_ok(name: str, payload: dict) -> None:
     if not payload.get("ok"):
         raise AssertionError(f"[{name}] not ok: {payload}")
@@ -58,6 +79,31 @@ def run_tests(base_url: str, timeout: float) -> None:
         raise AssertionError(f"[/release] unexpected mode: {release}")
     print("✓ /release")
 
+    state = http_post_json(
+        base_url,
+        "/state",
+        {"buttons": ["A", "ZR"], "lx": 0, "ly": 4095, "hold_ms": 200},
+        timeout=timeout,
+    )
+    assert_ok("state", state)
+    if state.get("mode") != "state" or state.get("hold_ms") != 200:
+        raise AssertionError(f"[/state] unexpected reply: {state}")
+    print("✓ POST /state")
+
+    opener = urllib.request.build_opener(urllib.request.ProxyHandler({}))
+    with opener.open(f"{base_url}/metrics", timeout=timeout) as resp:
+        metrics = resp.read().decode("utf-8", errors="replace")
+    if "ns_http_requests_total" not in metrics:
+        raise AssertionError("[/metrics] missing ns_http_requests_total")
+    print("✓ /metrics")
+
+    layers = http_get_json(base_url, "/layers", timeout=timeout)
+    assert_ok("layers", layers)
+    if layers.get("policy") not in ("priority", "latest") or not layers.get("layers"):
+        raise AssertionError(f"[/layers] unexpected reply: {layers}")
+    print("✓ /layers")
+
+    time.sleep(0.25)
     auto = http_get_json(base_url, "/auto", timeout=timeout)
     assert_ok("auto", auto)
     if auto.get("mode") != "auto":
@@ -88,6 +134,145 @@ def run_stress(base_url: str, loops: int, interval: float, timeout: float) -> No
     print("Stress mode finished.")
 
 
+def run_clock_sync(host: str, port: int, samples: int, interval: float, timeout: float) -> None:
+    """NTP-style exchange against the UDP sync service; prints offset and drift."""
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.settimeout(timeout)
+    points = []
+
+    for req_id in range(samples):
+        t1 = time.monotonic_ns() // 1000
+        sock.sendto(struct.pack("<2sBBIQ", b"NT", 1, 0, req_id, t1), (host, port))
+        try:
+            data, _ = sock.recvfrom(64)
+        except socket.timeout:
+            continue
+        t4 = time.monotonic_ns() // 1000
+        if len(data) != 32:
+            continue
+        _, _, _, rid, rt1, t2, t3 = struct.unpack("<2sBBIQQQ", data)
+        if rid != req_id or rt1 != t1:
+            continue
+        offset = ((t2 - t1) + (t3 - t4)) / 2
+        delay = (t4 - t1) - (t3 - t2)
+        points.append((t1, offset, delay))
+        time.sleep(interval)
+
+    if len(points) < 2:
+        raise AssertionError(f"[clock-sync] only {len(points)} replies")
+
+    # Keep the lowest-delay half: queueing delay only ever inflates the estimate.
+    points.sort(key=lambda p: p[2])
+    best = sorted(points[: max(2, len(points) // 2)])
+    n = len(best)
+    mean_t = sum(p[0] for p in best) / n
+    mean_o = sum(p[1] for p in best) / n
+    var_t = sum((p[0] - mean_t) ** 2 for p in best)
+    drift = sum((p[0] - mean_t) * (p[1] - mean_o) for p in best) / var_t if var_t else 0.0
+    now = time.monotonic_ns() // 1000
+    offset_now = mean_o + drift * (now - mean_t)
+
+    print(f"samples={len(points)} used={n} min_delay_us={points[0][2]}")
+    print(f"offset_us={offset_now:.0f} drift_ppm={drift * 1e6:.2f}")
+    print(f"device_time_now_us={now + offset_now:.0f}")
+
+
+def run_probe(base_url: str, host: str, port: int, samples: int, interval: float, timeout: float) -> None:
+    """Round-trip probes; each reports the previous RTT so the device aggregates it too."""
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.settimeout(timeout)
+    http_get_json(base_url, "/probe", {"reset": 1}, timeout=timeout)
+    rtts = []
+    last_rtt = 0
+
+    for probe_id in range(samples):
+        t1 = time.monotonic_ns() // 1000
+        sock.sendto(struct.pack("<2sBBIQII", b"NP", 1, 0, probe_id, t1, last_rtt, 0), (host, port))
+        try:
+            data, _ = sock.recvfrom(64)
+        except socket.timeout:
+            last_rtt = 0
+            continue
+        t4 = time.monotonic_ns() // 1000
+        if len(data) != 40 or struct.unpack_from("<I", data, 4)[0] != probe_id:
+            last_rtt = 0
+            continue
+        last_rtt = t4 - t1
+        rtts.append(last_rtt)
+        time.sleep(interval)
+
+    if not rtts:
+        raise AssertionError("[probe] no replies")
+    rtts.sort()
+    print(f"client: samples={len(rtts)} min_us={rtts[0]} p50_us={rtts[len(rtts) // 2]} "
+          f"p95_us={rtts[min(len(rtts) - 1, len(rtts) * 95 // 100)]} max_us={rtts[-1]}")
+    print(f"device: {http_get_json(base_url, '/probe', timeout=timeout)}")
+    print(f"profile: {http_get_json(base_url, '/latency', timeout=timeout)}")
+
+
+def uart_frame(frame_type: int, seq: int, payload: bytes = b"") -> bytes:
+    """COBS-encoded, 0x00-terminated frame for the UART link (main/ns_uart_link.h)."""
+    body = bytes([frame_type, seq & 0xFF]) + payload
+    body += struct.pack("<H", binascii.crc_hqx(body, 0xFFFF))
+    out = bytearray()
+    for block in body.split(b"\x00"):
+        while len(block) >= 254:
+            out += b"\xff" + block[:254]
+            block = block[254:]
+        out += bytes([len(block) + 1]) + block
+    return bytes(out) + b"\x00"
+
+
+def percentiles(name: str, values: list) -> None:
+    values = sorted(values)
+    if not values:
+        print(f"{name}: no samples")
+        return
+    print(f"{name}: samples={len(values)} min_us={values[0]:.0f} p50_us={values[len(values) // 2]:.0f} "
+          f"p95_us={values[min(len(values) - 1, len(values) * 95 // 100)]:.0f} max_us={values[-1]:.0f}")
+
+
+def run_uart_bench(base_url: str, device: str, baud: int, loops: int, timeout: float) -> None:
+    """Round trip and state throughput over the UART link, next to the same numbers for HTTP."""
+    import serial  # pyserial, only needed for this mode
+
+    link = serial.Serial(device, baud, timeout=timeout)
+    link.reset_input_buffer()
+
+    uart_rtt = []
+    for seq in range(loops):
+        t1 = time.perf_counter_ns() // 1000
+        link.write(uart_frame(0x04, seq, struct.pack("<Q", t1)))
+        reply = link.read_until(b"\x00")
+        if reply.endswith(b"\x00"):
+            uart_rtt.append(time.perf_counter_ns() // 1000 - t1)
+    http_rtt = []
+    for _ in range(loops):
+        start = time.perf_counter_ns()
+        http_get_json(base_url, "/time", timeout=timeout)
+        http_rtt.append((time.perf_counter_ns() - start) / 1000)
+    percentiles("uart round trip", uart_rtt)
+    percentiles("http round trip", http_rtt)
+
+    before = http_get_json(base_url, "/uart", timeout=timeout)["states"]
+    state = uart_frame(0x01, 0, struct.pack("<I4HB", 0, 2048, 2048, 2048, 2048, 0))
+    start = time.perf_counter()
+    for _ in range(loops * 10):
+        link.write(state)
+    link.flush()
+    elapsed = time.perf_counter() - start
+    time.sleep(0.1)
+    applied = http_get_json(base_url, "/uart", timeout=timeout)["states"] - before
+    print(f"uart states: sent={loops * 10} applied={applied} rate={applied / elapsed:.0f}/s")
+
+    start = time.perf_counter()
+    for _ in range(loops):
+        http_post_json(base_url, "/state", {"buttons": []}, timeout=timeout)
+    print(f"http states: sent={loops} rate={loops / (time.perf_counter() - start):.0f}/s")
+    link.write(uart_frame(0x03, 0))
+    http_get_json(base_url, "/release", timeout=timeout)
+
+
 def main() -> int:
     parser = argparse.ArgumentParser(description="OpenSwitchBridge HTTP API tester")
     parser.add_argument(
@@ -118,6 +303,33 @@ def main() -> int:
         type=float,
         help="Stress request interval seconds (default: 0.2)",
     )
+    parser.add_argument(
+        "--clock-sync",
+        action="store_true",
+        help="Estimate device clock offset/drift over the UDP sync service",
+    )
+    parser.add_argument(
+        "--probe",
+        action="store_true",
+        help="Measure UDP round trips and read the device-side /probe summary",
+    )
+    parser.add_argument(
+        "--uart",
+        metavar="DEVICE",
+        help="Benchmark the UART link on DEVICE (e.g. /dev/ttyUSB0) against HTTP; needs pyserial",
+    )
+    parser.add_argument(
+        "--baud",
+        default=3000000,
+        type=int,
+        help="UART baud rate (default: 3000000)",
+    )
+    parser.add_argument(
+        "--udp-port",
+        default=5005,
+        type=int,
+        help="UDP stream/sync port (default: 5005)",
+    )
     parser.add_argument(
         "--timeout",
         default=8.0,
@@ -128,12 +340,18 @@ def main() -> int:
 
     base_url = f"http://{args.host}:{args.port}"
     try:
-        if args.stress:
+        if args.clock_sync:
+            run_clock_sync(args.host, args.udp_port, args.loops, args.interval, args.timeout)
+        elif args.uart:
+            run_uart_bench(base_url, args.uart, args.baud, args.loops, args.timeout)
+        elif args.probe:
+            run_probe(base_url, args.host, args.udp_port, args.loops, args.interval, args.timeout)
+        elif args.stress:
             run_stress(base_url, args.loops, args.interval, args.timeout)
         else:
             run_tests(base_url, args.timeout)
         return 0
-    except (urllib.error.URLError, TimeoutError) as exc:
+    except (urllib.error.URLError, TimeoutError, OSError) as exc:
         print(f"Network error: {exc}", file=sys.stderr)
         return 2
     except (AssertionError, json.JSONDecodeError) as exc:
@@ -0,0 +1,148 @@
+/*
+ * Host-side check of the I2C register map (main/ns_i2c_regs.h) from a Linux
+ * SBC wired to the bridge's I2C slave (SDA GPIO8, SCL GPIO9).
+ *
+ *   cc -O2 -I../main -o i2c_host_test i2c_host_test.c
+ *   ./i2c_host_test /dev/i2c-1 [frames]
+ *
+ * Verifies the identity registers, the shadow/commit contract (writes without
+ * a commit leave the commit counter alone) and then pushes full frames, each
+ * as a single burst ending in the commit register, reporting the frame rate.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ns_i2c_regs.h"
+
+static int s_fd;
+
+static int reg_write(const uint8_t *buf, uint16_t len)
+{
+    struct i2c_msg msg = {.addr = NS_I2C_ADDR, .flags = 0, .len = len, .buf = (uint8_t *)buf};
+    struct i2c_rdwr_ioctl_data xfer = {.msgs = &msg, .nmsgs = 1};
+
+    return ioctl(s_fd, I2C_RDWR, &xfer) < 0 ? -errno : 0;
+}
+
+/* Register pointer write + repeated-start read of len bytes. */
+static int reg_read(uint8_t reg, uint8_t *out, uint16_t len)
+{
+    struct i2c_msg msgs[2] = {
+        {.addr = NS_I2C_ADDR, .flags = 0, .len = 1, .buf = &reg},
+        {.addr = NS_I2C_ADDR, .flags = I2C_M_RD, .len = len, .buf = out},
+    };
+    struct i2c_rdwr_ioctl_data xfer = {.msgs = msgs, .nmsgs = 2};
+
+    return ioctl(s_fd, I2C_RDWR, &xfer) < 0 ? -errno : 0;
+}
+
+static int read_status(uint8_t status[NS_I2C_STATUS_BLOCK_END])
+{
+    return reg_read(NS_I2C_REG_WHO_AM_I, status, NS_I2C_STATUS_BLOCK_END);
+}
+
+static void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+/* [reg, BUTTONS .. COMMIT]: one transaction, applied atomically by the commit byte. */
+#define FRAME_LEN (1 + NS_I2C_REG_COUNT - NS_I2C_REG_BUTTONS)
+#define FRAME_REG(buf, reg) (&(buf)[1 + (reg) - NS_I2C_REG_BUTTONS])
+
+static void build_frame(uint8_t buf[FRAME_LEN], uint32_t buttons, uint16_t lx, uint16_t ly)
+{
+    memset(buf, 0, FRAME_LEN);
+    buf[0] = NS_I2C_REG_BUTTONS;
+    put_u16(FRAME_REG(buf, NS_I2C_REG_BUTTONS), (uint16_t)buttons);
+    put_u16(FRAME_REG(buf, NS_I2C_REG_BUTTONS + 2), (uint16_t)(buttons >> 16));
+    put_u16(FRAME_REG(buf, NS_I2C_REG_LX), lx);
+    put_u16(FRAME_REG(buf, NS_I2C_REG_LY), ly);
+    put_u16(FRAME_REG(buf, NS_I2C_REG_RX), 0x800);
+    put_u16(FRAME_REG(buf, NS_I2C_REG_RY), 0x800);
+    put_u16(FRAME_REG(buf, NS_I2C_REG_LEASE_MS), 500);
+    *FRAME_REG(buf, NS_I2C_REG_COMMIT) = NS_I2C_COMMIT_APPLY;
+}
+
+#define CHECK(cond, ...)                    \
+    do {                                    \
+        if (!(cond)) {                      \
+            fprintf(stderr, __VA_ARGS__);   \
+            fputc('\n', stderr);            \
+            return 1;                       \
+        }                                   \
+    } while (0)
+
+int main(int argc, char **argv)
+{
+    uint8_t status[NS_I2C_STATUS_BLOCK_END];
+    uint8_t frame[FRAME_LEN];
+    uint8_t commits;
+    int frames = argc > 2 ? atoi(argv[2]) : 1000;
+    struct timespec start, end;
+    double elapsed;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s /dev/i2c-N [frames]\n", argv[0]);
+        return 2;
+    }
+    s_fd = open(argv[1], O_RDWR);
+    CHECK(s_fd >= 0, "open %s: %s", argv[1], strerror(errno));
+
+    CHECK(read_status(status) == 0, "status read failed");
+    CHECK(status[NS_I2C_REG_WHO_AM_I] == NS_I2C_WHO_AM_I, "who_am_i 0x%02x", status[NS_I2C_REG_WHO_AM_I]);
+    CHECK(status[NS_I2C_REG_VERSION] == NS_I2C_MAP_VERSION, "map version %u", status[NS_I2C_REG_VERSION]);
+    commits = status[NS_I2C_REG_COMMITS];
+
+    /* Shadow write without commit: dirty, nothing applied. */
+    {
+        uint8_t lx[3] = {NS_I2C_REG_LX, 0x00, 0x00};
+
+        CHECK(reg_write(lx, sizeof(lx)) == 0, "shadow write failed");
+        CHECK(read_status(status) == 0, "status read failed");
+        CHECK(status[NS_I2C_REG_STATUS] & NS_I2C_STATUS_DIRTY, "shadow not marked dirty");
+        CHECK(status[NS_I2C_REG_COMMITS] == commits, "write without commit was applied");
+    }
+
+    /* Read-only registers reject writes. */
+    {
+        uint8_t ro[2] = {NS_I2C_REG_WHO_AM_I, 0x00};
+
+        CHECK(reg_write(ro, sizeof(ro)) == 0, "write failed");
+        CHECK(read_status(status) == 0, "status read failed");
+        CHECK(status[NS_I2C_REG_LAST_ERROR] == NS_I2C_ERR_READ_ONLY, "read-only write not flagged");
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < frames; i++) {
+        build_frame(frame, (i & 1) ? (1U << 4) : 0, (uint16_t)(i & 0xFFF), 0x800);
+        CHECK(reg_write(frame, FRAME_LEN) == 0, "frame %d write failed", i);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    CHECK(read_status(status) == 0, "status read failed");
+    CHECK(status[NS_I2C_REG_COMMITS] == (uint8_t)(commits + frames), "commits %u, expected %u",
+          status[NS_I2C_REG_COMMITS], (uint8_t)(commits + frames));
+    CHECK(status[NS_I2C_REG_LAST_ERROR] == NS_I2C_ERR_NONE, "last error %u", status[NS_I2C_REG_LAST_ERROR]);
+    CHECK(status[NS_I2C_REG_STATUS] & NS_I2C_STATUS_ACTIVE, "committed input not active");
+    printf("ok: %d frames in %.3f s (%.0f frames/s, %d bytes each)\n", frames, elapsed, frames / elapsed,
+           FRAME_LEN);
+
+    {
+        uint8_t release[2] = {NS_I2C_REG_COMMAND, NS_I2C_CMD_RELEASE};
+        reg_write(release, sizeof(release));
+    }
+    close(s_fd);
+    return 0;
+}
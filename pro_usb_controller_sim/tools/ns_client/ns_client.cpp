@@ -0,0 +1,1597 @@
+#include "ns_client.h"
+
+#include <arpa/inet.h>
+#include <ctype.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace ns {
+
+namespace {
+
+// Largest response header block accepted before the connection is dropped
+constexpr size_t kHeaderMax = 16384;
+// Queued WebSocket bytes beyond which state packets are dropped instead of buffered
+constexpr size_t kWsBacklogMax = 64 * 1024;
+// Samples within this much of the minimum round trip are trusted (at least kTrustMinUs)
+constexpr int64_t kTrustMinUs = 200;
+// Drift is only fitted once the trusted samples span this long
+constexpr int64_t kDriftSpanUs = 1000000;
+constexpr double kDriftMax = 1e-3;
+
+const char *const kButtonNames[] = {
+    "NONE", "Y", "X", "B", "A", "L", "R", "ZL", "ZR", "MINUS", "PLUS",
+    "L_STICK", "R_STICK", "HOME", "CAPTURE", "UP", "DOWN", "LEFT", "RIGHT",
+};
+
+void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+void put_u32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+void put_u64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+uint64_t get_u64(const uint8_t *p)
+{
+    return (uint64_t)get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+}
+
+int connect_tcp(const std::vector<uint8_t> &addr, uint16_t port)
+{
+    sockaddr_in sin;
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+
+    if (fd < 0) {
+        return -1;
+    }
+    memcpy(&sin, addr.data(), sizeof(sin));
+    sin.sin_port = htons(port);
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(fd, (sockaddr *)&sin, sizeof(sin)) != 0 && errno != EINPROGRESS) {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+    return fd;
+}
+
+std::string url_escape(const std::string &text)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    std::string out;
+
+    for (unsigned char c : text) {
+        if (isalnum(c) || c == '_' || c == '-' || c == '.' || c == '~') {
+            out += (char)c;
+        } else {
+            out += '%';
+            out += hex[c >> 4];
+            out += hex[c & 15];
+        }
+    }
+    return out;
+}
+
+// Case-insensitive header lookup in a raw header block; empty if absent
+std::string header_value(const std::string &head, const char *name)
+{
+    size_t name_len = strlen(name);
+    size_t pos = head.find("\r\n");
+
+    while (pos != std::string::npos && pos + 2 < head.size()) {
+        size_t line = pos + 2;
+        size_t end = head.find("\r\n", line);
+
+        if (end == std::string::npos) {
+            end = head.size();
+        }
+        if (end - line > name_len && head[line + name_len] == ':' &&
+            strncasecmp(head.c_str() + line, name, name_len) == 0) {
+            size_t value = line + name_len + 1;
+            while (value < end && (head[value] == ' ' || head[value] == '\t')) {
+                value++;
+            }
+            return head.substr(value, end - value);
+        }
+        pos = end;
+    }
+    return std::string();
+}
+
+// Decodes a complete chunked body starting at `pos`; false while more data is needed
+bool dechunk(const std::string &in, size_t pos, std::string *body, size_t *consumed, bool *bad)
+{
+    body->clear();
+    for (;;) {
+        size_t eol = in.find("\r\n", pos);
+        char *end = nullptr;
+        unsigned long len;
+
+        if (eol == std::string::npos) {
+            return false;
+        }
+        len = strtoul(in.c_str() + pos, &end, 16);
+        if (end == in.c_str() + pos) {
+            *bad = true;
+            return false;
+        }
+        pos = eol + 2;
+        if (len == 0) {
+            // No trailers are sent by esp_http_server: expect the final CRLF
+            if (in.size() < pos + 2) {
+                return false;
+            }
+            *consumed = pos + 2;
+            return true;
+        }
+        if (in.size() < pos + len + 2) {
+            return false;
+        }
+        body->append(in, pos, len);
+        pos += len + 2;
+    }
+}
+
+//--------------------------------------------------------------------+
+// SHA-1 and base64, only for the WebSocket handshake
+//--------------------------------------------------------------------+
+uint32_t rol(uint32_t v, int n)
+{
+    return (v << n) | (v >> (32 - n));
+}
+
+void sha1(const std::string &msg, uint8_t out[20])
+{
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::string data = msg;
+    uint64_t bits = (uint64_t)msg.size() * 8;
+
+    data += (char)0x80;
+    while (data.size() % 64 != 56) {
+        data += (char)0;
+    }
+    for (int i = 7; i >= 0; i--) {
+        data += (char)(bits >> (8 * i));
+    }
+
+    for (size_t block = 0; block < data.size(); block += 64) {
+        const uint8_t *p = (const uint8_t *)data.data() + block;
+        uint32_t w[80];
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+        for (int i = 0; i < 16; i++) {
+            w[i] = ((uint32_t)p[4 * i] << 24) | ((uint32_t)p[4 * i + 1] << 16) |
+                   ((uint32_t)p[4 * i + 2] << 8) | p[4 * i + 3];
+        }
+        for (int i = 16; i < 80; i++) {
+            w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t t = rol(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rol(b, 30);
+            b = a;
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+    for (int i = 0; i < 5; i++) {
+        put_u32(out + 4 * i, __builtin_bswap32(h[i]));
+    }
+}
+
+std::string base64(const uint8_t *data, size_t len)
+{
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)data[i] << 16;
+        if (i + 1 < len) {
+            v |= (uint32_t)data[i + 1] << 8;
+        }
+        if (i + 2 < len) {
+            v |= data[i + 2];
+        }
+        out += table[(v >> 18) & 63];
+        out += table[(v >> 12) & 63];
+        out += i + 1 < len ? table[(v >> 6) & 63] : '=';
+        out += i + 2 < len ? table[v & 63] : '=';
+    }
+    return out;
+}
+
+} // namespace
+
+int64_t now_us()
+{
+    timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//--------------------------------------------------------------------+
+// loop_t
+//--------------------------------------------------------------------+
+loop_t::loop_t() : m_epfd(epoll_create1(EPOLL_CLOEXEC))
+{
+    if (m_epfd < 0) {
+        perror("epoll_create1");
+        abort();
+    }
+}
+
+loop_t::~loop_t()
+{
+    close(m_epfd);
+}
+
+bool loop_t::add(int fd, uint32_t events, fd_handler_t handler)
+{
+    uint64_t token = m_next_token++;
+    epoll_event ev = {};
+
+    ev.events = events;
+    ev.data.u64 = token;
+    if (epoll_ctl(m_epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        return false;
+    }
+    m_fd_tokens[fd] = token;
+    m_entries[token] = entry_t{fd, std::make_shared<fd_handler_t>(std::move(handler))};
+    return true;
+}
+
+bool loop_t::modify(int fd, uint32_t events)
+{
+    auto it = m_fd_tokens.find(fd);
+    epoll_event ev = {};
+
+    if (it == m_fd_tokens.end()) {
+        return false;
+    }
+    ev.events = events;
+    ev.data.u64 = it->second;
+    return epoll_ctl(m_epfd, EPOLL_CTL_MOD, fd, &ev) == 0;
+}
+
+void loop_t::remove(int fd)
+{
+    auto it = m_fd_tokens.find(fd);
+
+    if (it == m_fd_tokens.end()) {
+        return;
+    }
+    epoll_ctl(m_epfd, EPOLL_CTL_DEL, fd, nullptr);
+    m_entries.erase(it->second);
+    m_fd_tokens.erase(it);
+}
+
+uint64_t loop_t::add_timer(int64_t at_us, timer_fn_t fn)
+{
+    uint64_t id = m_next_timer++;
+
+    m_timers.emplace(std::make_pair(at_us, id), std::move(fn));
+    m_timer_at[id] = at_us;
+    return id;
+}
+
+void loop_t::cancel_timer(uint64_t id)
+{
+    auto it = m_timer_at.find(id);
+
+    if (it == m_timer_at.end()) {
+        return;
+    }
+    m_timers.erase(std::make_pair(it->second, id));
+    m_timer_at.erase(it);
+}
+
+void loop_t::run_once(int64_t max_wait_us)
+{
+    epoll_event events[64];
+    int64_t wait_us = max_wait_us;
+    int count;
+
+    if (!m_timers.empty()) {
+        int64_t until = std::max<int64_t>(0, m_timers.begin()->first.first - now_us());
+        wait_us = wait_us < 0 ? until : std::min(wait_us, until);
+    }
+
+    if (wait_us < 0) {
+        count = epoll_wait(m_epfd, events, 64, -1);
+    } else {
+        timespec ts = {(time_t)(wait_us / 1000000), (long)(wait_us % 1000000) * 1000};
+
+        count = epoll_pwait2(m_epfd, events, 64, &ts, nullptr);
+        if (count < 0 && errno == ENOSYS) {
+            count = epoll_wait(m_epfd, events, 64, (int)((wait_us + 999) / 1000));
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        auto it = m_entries.find(events[i].data.u64);
+
+        // Removed by an earlier handler in this batch
+        if (it == m_entries.end()) {
+            continue;
+        }
+        std::shared_ptr<fd_handler_t> handler = it->second.handler;
+        (*handler)(events[i].events);
+    }
+
+    int64_t now = now_us();
+    while (!m_timers.empty() && m_timers.begin()->first.first <= now) {
+        auto it = m_timers.begin();
+        timer_fn_t fn = std::move(it->second);
+
+        m_timer_at.erase(it->first.second);
+        m_timers.erase(it);
+        fn();
+    }
+}
+
+bool loop_t::run_until(const std::function<bool()> &done, int64_t deadline_us)
+{
+    while (!done()) {
+        int64_t wait_us = -1;
+
+        if (deadline_us > 0) {
+            wait_us = deadline_us - now_us();
+            if (wait_us <= 0) {
+                return false;
+            }
+        }
+        run_once(wait_us);
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------+
+// Encoding helpers
+//--------------------------------------------------------------------+
+void encode_state(uint8_t out[kStatePacketLen], const state_t &state, uint32_t seq,
+                  uint64_t timestamp_us, uint8_t flags)
+{
+    memset(out, 0, kStatePacketLen);
+    out[0] = 'N';
+    out[1] = 'S';
+    out[2] = kStreamVersion;
+    out[3] = (uint8_t)(flags | (state.imu ? kStreamFlagImu : 0));
+    put_u32(&out[4], seq);
+    put_u64(&out[8], timestamp_us);
+    put_u32(&out[16], state.buttons);
+    put_u16(&out[20], state.lx);
+    put_u16(&out[22], state.ly);
+    put_u16(&out[24], state.rx);
+    put_u16(&out[26], state.ry);
+    for (int axis = 0; axis < 3; axis++) {
+        put_u16(&out[28 + 2 * axis], (uint16_t)state.accel[axis]);
+        put_u16(&out[34 + 2 * axis], (uint16_t)state.gyro[axis]);
+    }
+}
+
+std::string state_json(const state_t &state, uint32_t hold_ms, int64_t at_us)
+{
+    char buf[320];
+    int len = snprintf(buf, sizeof(buf), "{\"buttons\":%u,\"lx\":%u,\"ly\":%u,\"rx\":%u,\"ry\":%u",
+                       (unsigned)state.buttons, state.lx, state.ly, state.rx, state.ry);
+
+    if (state.imu) {
+        len += snprintf(buf + len, sizeof(buf) - len,
+                        ",\"imu\":{\"accel\":[%d,%d,%d],\"gyro\":[%d,%d,%d]}",
+                        state.accel[0], state.accel[1], state.accel[2],
+                        state.gyro[0], state.gyro[1], state.gyro[2]);
+    }
+    if (hold_ms > 0) {
+        len += snprintf(buf + len, sizeof(buf) - len, ",\"hold_ms\":%u", (unsigned)hold_ms);
+    }
+    if (at_us > 0) {
+        len += snprintf(buf + len, sizeof(buf) - len, ",\"at_us\":%lld", (long long)at_us);
+    }
+    snprintf(buf + len, sizeof(buf) - len, "}");
+    return buf;
+}
+
+int button_id(const std::string &name)
+{
+    for (size_t id = 0; id < sizeof(kButtonNames) / sizeof(kButtonNames[0]); id++) {
+        if (strcasecmp(name.c_str(), kButtonNames[id]) == 0) {
+            return (int)id;
+        }
+    }
+    return -1;
+}
+
+const char *button_name(int id)
+{
+    if (id < 0 || id >= (int)(sizeof(kButtonNames) / sizeof(kButtonNames[0]))) {
+        return "UNKNOWN";
+    }
+    return kButtonNames[id];
+}
+
+std::string ws_accept_key(const std::string &key)
+{
+    uint8_t digest[20];
+
+    sha1(key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11", digest);
+    return base64(digest, sizeof(digest));
+}
+
+//--------------------------------------------------------------------+
+// clock_estimator_t
+//--------------------------------------------------------------------+
+void clock_estimator_t::add(int64_t t1, int64_t t2, int64_t t3, int64_t t4)
+{
+    sample_t sample;
+
+    if (t4 < t1 || t3 < t2) {
+        return;
+    }
+    sample.t4 = t4;
+    sample.offset = ((t2 - t1) + (t3 - t4)) / 2;
+    sample.delay = (t4 - t1) - (t3 - t2);
+    m_samples.push_back(sample);
+    if (m_samples.size() > kMaxSamples) {
+        m_samples.pop_front();
+    }
+    refit();
+}
+
+void clock_estimator_t::reset()
+{
+    m_samples.clear();
+    m_ref_us = 0;
+    m_offset_us = 0;
+    m_drift = 0.0;
+    m_min_delay_us = 0;
+    m_uncertainty_us = 0;
+}
+
+int64_t clock_estimator_t::offset_us(int64_t client_us) const
+{
+    return m_offset_us + (int64_t)(m_drift * (double)(client_us - m_ref_us));
+}
+
+void clock_estimator_t::refit()
+{
+    const sample_t *best = &m_samples.front();
+    std::vector<const sample_t *> trusted;
+    int64_t limit;
+
+    for (const sample_t &sample : m_samples) {
+        if (sample.delay < best->delay) {
+            best = &sample;
+        }
+    }
+    m_min_delay_us = std::max<int64_t>(0, best->delay);
+    m_uncertainty_us = m_min_delay_us / 2;
+    limit = best->delay + std::max<int64_t>(kTrustMinUs, best->delay / 2);
+    for (const sample_t &sample : m_samples) {
+        if (sample.delay <= limit) {
+            trusted.push_back(&sample);
+        }
+    }
+
+    // Least-squares line through the trusted offsets, referenced to the newest one
+    if (trusted.size() >= 4 && trusted.back()->t4 - trusted.front()->t4 >= kDriftSpanUs) {
+        double n = (double)trusted.size();
+        double sx = 0, sy = 0, sxx = 0, sxy = 0;
+        int64_t ref = trusted.back()->t4;
+        int64_t base = trusted.front()->offset;
+
+        for (const sample_t *sample : trusted) {
+            double x = (double)(sample->t4 - ref);
+            double y = (double)(sample->offset - base);
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+        double den = n * sxx - sx * sx;
+        if (den > 0) {
+            double slope = (n * sxy - sx * sy) / den;
+            if (fabs(slope) <= kDriftMax) {
+                m_drift = slope;
+                m_ref_us = ref;
+                m_offset_us = base + (int64_t)((sy - slope * sx) / n);
+                return;
+            }
+        }
+    }
+
+    m_drift = 0.0;
+    m_ref_us = best->t4;
+    m_offset_us = best->offset;
+}
+
+//--------------------------------------------------------------------+
+// client_t
+//--------------------------------------------------------------------+
+struct client_t::pending_t {
+    std::string wire;
+    response_cb_t cb;
+    response_t resp;
+    int64_t deadline_us = 0;
+    uint64_t wire_start = 0;
+    uint64_t wire_end = 0;
+    bool retried = false;
+};
+
+struct client_t::connection_t {
+    int fd = -1;
+    bool connecting = true;
+    // Server announced Connection: close; nothing new is written
+    bool closing = false;
+    // Write failed outside an event handler; closed from a zero-delay timer
+    int dead = 0;
+    uint32_t events = 0;
+    int64_t connect_deadline_us = 0;
+    std::string out;
+    uint64_t bytes_queued = 0;
+    uint64_t bytes_written = 0;
+    std::deque<std::unique_ptr<pending_t>> inflight;
+    uint64_t completed = 0;
+    std::string in;
+    // Response being parsed: header length, 0 until the header block is complete
+    size_t head_len = 0;
+    int status = 0;
+    int64_t content_length = -1;
+    bool chunked = false;
+    bool close_after = false;
+};
+
+struct client_t::ws_t {
+    int fd = -1;
+    bool connecting = true;
+    bool open = false;
+    uint32_t events = 0;
+    std::string key;
+    std::string out;
+    std::string in;
+};
+
+client_t::client_t(loop_t &loop, const std::string &host, const client_options_t &options)
+    : m_loop(loop), m_host(host), m_options(options), m_alive(std::make_shared<bool>(true))
+{
+    addrinfo hints = {};
+    addrinfo *res = nullptr;
+    sockaddr_in sin = {};
+
+    if (m_options.max_connections == 0) {
+        m_options.max_connections = 1;
+    }
+    if (m_options.pipeline_depth == 0) {
+        m_options.pipeline_depth = 1;
+    }
+    m_pool_limit = m_options.max_connections;
+    if (m_options.client_id.empty()) {
+        static std::atomic<unsigned> s_clients{0};
+
+        m_options.client_id = "ns-" + std::to_string(getpid()) + "-" + std::to_string(s_clients++);
+    }
+
+    sin.sin_family = AF_INET;
+    hints.ai_family = AF_INET;
+    if (inet_pton(AF_INET, host.c_str(), &sin.sin_addr) != 1) {
+        if (getaddrinfo(host.c_str(), nullptr, &hints, &res) == 0 && res != nullptr) {
+            sin.sin_addr = ((sockaddr_in *)res->ai_addr)->sin_addr;
+            freeaddrinfo(res);
+        } else {
+            fprintf(stderr, "ns_client: cannot resolve %s\n", host.c_str());
+        }
+    }
+    m_addr.assign((uint8_t *)&sin, (uint8_t *)&sin + sizeof(sin));
+}
+
+client_t::~client_t()
+{
+    m_alive.reset();
+    if (m_timer != 0) {
+        m_loop.cancel_timer(m_timer);
+    }
+    if (m_sync_timer != 0) {
+        m_loop.cancel_timer(m_sync_timer);
+    }
+    for (auto &conn : m_connections) {
+        m_loop.remove(conn->fd);
+        close(conn->fd);
+    }
+    close_stream();
+    if (m_udp_fd >= 0) {
+        m_loop.remove(m_udp_fd);
+        close(m_udp_fd);
+    }
+}
+
+void client_t::request(const char *method, const std::string &path, const std::string &body,
+                       response_cb_t cb)
+{
+    auto req = std::make_unique<pending_t>();
+    bool post = strcmp(method, "POST") == 0;
+
+    req->wire.reserve(96 + path.size() + body.size());
+    req->wire += method;
+    req->wire += ' ';
+    req->wire += path;
+    req->wire += " HTTP/1.1\r\nHost: ";
+    req->wire += m_host;
+    req->wire += "\r\nX-Client-Id: ";
+    req->wire += m_options.client_id;
+    req->wire += "\r\n";
+    if (post) {
+        req->wire += "Content-Type: application/json\r\nContent-Length: ";
+        req->wire += std::to_string(body.size());
+        req->wire += "\r\n\r\n";
+        req->wire += body;
+    } else {
+        req->wire += "\r\n";
+    }
+    req->cb = std::move(cb);
+    req->resp.queued_us = now_us();
+    req->deadline_us = req->resp.queued_us + m_options.timeout_us;
+    m_stats.requests++;
+    enqueue(std::move(req));
+}
+
+void client_t::health(response_cb_t cb)
+{
+    get("/health", std::move(cb));
+}
+
+void client_t::press(const std::string &button, response_cb_t cb)
+{
+    get("/press?name=" + url_escape(button), std::move(cb));
+}
+
+void client_t::hold(const std::string &button, uint32_t ms, response_cb_t cb)
+{
+    get("/hold?name=" + url_escape(button) + "&ms=" + std::to_string(ms), std::move(cb));
+}
+
+void client_t::button(const std::string &button, uint32_t lease_ms, response_cb_t cb)
+{
+    get("/button?name=" + url_escape(button) + "&lease_ms=" + std::to_string(lease_ms), std::move(cb));
+}
+
+void client_t::release(response_cb_t cb)
+{
+    get("/release", std::move(cb));
+}
+
+void client_t::set_state(const state_t &state, uint32_t hold_ms, int64_t at_us, response_cb_t cb)
+{
+    request("POST", "/state", state_json(state, hold_ms, at_us), std::move(cb));
+}
+
+void client_t::device_time(response_cb_t cb)
+{
+    get("/time", std::move(cb));
+}
+
+void client_t::metrics(response_cb_t cb)
+{
+    get("/metrics", std::move(cb));
+}
+
+size_t client_t::pending() const
+{
+    size_t count = m_queue.size();
+
+    for (const auto &conn : m_connections) {
+        count += conn->inflight.size();
+    }
+    return count;
+}
+
+void client_t::enqueue(std::unique_ptr<pending_t> req)
+{
+    m_queue.push_back(std::move(req));
+    pump();
+}
+
+client_t::connection_t *client_t::open_connection()
+{
+    auto conn = std::make_unique<connection_t>();
+    connection_t *raw = conn.get();
+
+    conn->fd = connect_tcp(m_addr, m_options.http_port);
+    if (conn->fd < 0) {
+        return nullptr;
+    }
+    conn->connect_deadline_us = now_us() + m_options.connect_timeout_us;
+    conn->events = EPOLLIN | EPOLLOUT;
+    if (!m_loop.add(conn->fd, conn->events, [this, raw](uint32_t events) {
+            on_connection_events(raw, events);
+        })) {
+        close(conn->fd);
+        return nullptr;
+    }
+    m_stats.connects++;
+    m_connections.push_back(std::move(conn));
+    return raw;
+}
+
+// Assigns queued requests to connections: an idle one first, then a new one
+// while the pool has room, then pipelined behind the least loaded one.
+void client_t::pump()
+{
+    std::vector<std::unique_ptr<pending_t>> failed;
+    int open_error = 0;
+
+    while (!m_queue.empty()) {
+        connection_t *best = nullptr;
+
+        for (auto &conn : m_connections) {
+            if (conn->dead != 0 || conn->closing || conn->inflight.size() >= m_options.pipeline_depth) {
+                continue;
+            }
+            if (best == nullptr || conn->inflight.size() < best->inflight.size()) {
+                best = conn.get();
+            }
+        }
+        if ((best == nullptr || !best->inflight.empty()) && open_error == 0 &&
+            m_connections.size() < m_pool_limit) {
+            connection_t *conn = open_connection();
+            if (conn != nullptr) {
+                best = conn;
+            } else {
+                open_error = errno;
+            }
+        }
+        if (best == nullptr) {
+            // Nothing can ever take these when no connection exists at all
+            if (open_error != 0 && m_connections.empty()) {
+                while (!m_queue.empty()) {
+                    failed.push_back(std::move(m_queue.front()));
+                    m_queue.pop_front();
+                }
+            }
+            break;
+        }
+
+        std::unique_ptr<pending_t> req = std::move(m_queue.front());
+        m_queue.pop_front();
+        req->resp.pipelined = !best->inflight.empty();
+        req->resp.fresh_connection = best->connecting;
+        if (req->resp.pipelined) {
+            m_stats.pipelined++;
+        }
+        req->wire_start = best->bytes_queued;
+        best->out += req->wire;
+        best->bytes_queued += req->wire.size();
+        req->wire_end = best->bytes_queued;
+        best->inflight.push_back(std::move(req));
+    }
+
+    for (auto &conn : m_connections) {
+        if (conn->connecting || conn->dead != 0 || conn->out.empty()) {
+            continue;
+        }
+        if (!flush(conn.get())) {
+            // pump() may run from a response callback while that connection is being parsed
+            conn->dead = errno != 0 ? errno : EPIPE;
+            m_loop.add_timer(0, [this, alive = std::weak_ptr<bool>(m_alive)]() {
+                if (!alive.expired()) {
+                    reap();
+                }
+            });
+            continue;
+        }
+        update_interest(conn.get());
+    }
+
+    if (!failed.empty()) {
+        std::weak_ptr<bool> alive = m_alive;
+        for (auto &req : failed) {
+            finish(std::move(req), 0, open_error);
+            if (alive.expired()) {
+                return;
+            }
+        }
+    }
+    arm_timeout();
+}
+
+void client_t::reap()
+{
+    std::vector<connection_t *> dead;
+
+    for (const auto &conn : m_connections) {
+        if (conn->dead != 0) {
+            dead.push_back(conn.get());
+        }
+    }
+    for (connection_t *conn : dead) {
+        // Closing one may complete callbacks that close others
+        for (const auto &conn_left : m_connections) {
+            if (conn_left.get() == conn) {
+                close_connection(conn, conn->dead);
+                break;
+            }
+        }
+    }
+}
+
+bool client_t::flush(connection_t *conn)
+{
+    // Stamped before the write so sent_us..done_us covers the whole exchange
+    int64_t now = now_us();
+
+    while (!conn->out.empty()) {
+        ssize_t n = send(conn->fd, conn->out.data(), conn->out.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                break;
+            }
+            return false;
+        }
+        conn->out.erase(0, (size_t)n);
+        conn->bytes_written += (uint64_t)n;
+    }
+
+    for (auto &req : conn->inflight) {
+        if (req->resp.sent_us == 0 && req->wire_end <= conn->bytes_written) {
+            req->resp.sent_us = now;
+        }
+    }
+    return true;
+}
+
+void client_t::update_interest(connection_t *conn)
+{
+    uint32_t events = EPOLLIN | EPOLLRDHUP;
+
+    if (conn->connecting || !conn->out.empty()) {
+        events |= EPOLLOUT;
+    }
+    if (events != conn->events) {
+        conn->events = events;
+        m_loop.modify(conn->fd, events);
+    }
+}
+
+void client_t::on_connection_events(connection_t *conn, uint32_t events)
+{
+    bool eof = false;
+
+    if (conn->dead != 0) {
+        close_connection(conn, conn->dead);
+        return;
+    }
+
+    if (conn->connecting) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+
+        if (!(events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+            return;
+        }
+        getsockopt(conn->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        if (err != 0) {
+            close_connection(conn, err);
+            return;
+        }
+        conn->connecting = false;
+    }
+
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+        char buf[4096];
+
+        for (;;) {
+            ssize_t n = recv(conn->fd, buf, sizeof(buf), 0);
+            if (n > 0) {
+                conn->in.append(buf, (size_t)n);
+                continue;
+            }
+            if (n == 0) {
+                eof = true;
+            } else if (errno != EAGAIN && errno != EINTR) {
+                close_connection(conn, errno);
+                return;
+            }
+            break;
+        }
+
+        std::weak_ptr<bool> alive = m_alive;
+        if (!parse(conn) || alive.expired()) {
+            return;
+        }
+        if (conn->dead != 0) {
+            close_connection(conn, conn->dead);
+            return;
+        }
+        // Completed responses freed pipeline slots for queued requests
+        if (!m_queue.empty()) {
+            pump();
+        }
+        if (eof) {
+            // A response without a length ends with the connection
+            if (conn->head_len != 0 && !conn->chunked && conn->content_length < 0 && !conn->inflight.empty()) {
+                std::unique_ptr<pending_t> req = std::move(conn->inflight.front());
+                conn->inflight.pop_front();
+                req->resp.body = conn->in.substr(conn->head_len);
+                conn->in.clear();
+                conn->head_len = 0;
+                conn->completed++;
+                finish(std::move(req), conn->status, 0);
+                if (alive.expired()) {
+                    return;
+                }
+            }
+            close_connection(conn, ECONNRESET);
+            return;
+        }
+    }
+
+    if (!conn->out.empty() && !flush(conn)) {
+        close_connection(conn, errno);
+        return;
+    }
+    if (conn->closing && conn->inflight.empty()) {
+        close_connection(conn, 0);
+        return;
+    }
+    update_interest(conn);
+}
+
+// Completes every whole response in conn->in. False if the connection was closed.
+bool client_t::parse(connection_t *conn)
+{
+    std::weak_ptr<bool> alive = m_alive;
+
+    for (;;) {
+        if (conn->head_len == 0) {
+            size_t end = conn->in.find("\r\n\r\n");
+            std::string head;
+            std::string value;
+
+            if (end == std::string::npos) {
+                if (conn->in.size() > kHeaderMax) {
+                    close_connection(conn, EPROTO);
+                    return false;
+                }
+                return true;
+            }
+            if (conn->inflight.empty()) {
+                close_connection(conn, EPROTO);
+                return false;
+            }
+            head = conn->in.substr(0, end + 2);
+            if (head.compare(0, 5, "HTTP/") != 0 || head.size() < 12) {
+                close_connection(conn, EPROTO);
+                return false;
+            }
+            conn->status = atoi(head.c_str() + 9);
+            value = header_value(head, "Content-Length");
+            conn->content_length = value.empty() ? -1 : strtoll(value.c_str(), nullptr, 10);
+            value = header_value(head, "Transfer-Encoding");
+            conn->chunked = strcasestr(value.c_str(), "chunked") != nullptr;
+            value = header_value(head, "Connection");
+            conn->close_after = strcasestr(value.c_str(), "close") != nullptr;
+            conn->head_len = end + 4;
+        }
+
+        std::string body;
+        size_t consumed;
+
+        if (conn->chunked) {
+            bool bad = false;
+            if (!dechunk(conn->in, conn->head_len, &body, &consumed, &bad)) {
+                if (bad) {
+                    close_connection(conn, EPROTO);
+                    return false;
+                }
+                return true;
+            }
+        } else if (conn->content_length >= 0) {
+            consumed = conn->head_len + (size_t)conn->content_length;
+            if (conn->in.size() < consumed) {
+                return true;
+            }
+            body = conn->in.substr(conn->head_len, (size_t)conn->content_length);
+        } else {
+            // Delimited by close, completed on EOF
+            return true;
+        }
+
+        std::unique_ptr<pending_t> req = std::move(conn->inflight.front());
+        conn->inflight.pop_front();
+        conn->in.erase(0, consumed);
+        conn->head_len = 0;
+        conn->completed++;
+        if (conn->close_after) {
+            conn->closing = true;
+        }
+        req->resp.body = std::move(body);
+        finish(std::move(req), conn->status, 0);
+        if (alive.expired()) {
+            return false;
+        }
+        if (conn->closing) {
+            close_connection(conn, 0);
+            return false;
+        }
+    }
+}
+
+void client_t::finish(std::unique_ptr<pending_t> req, int status, int error)
+{
+    req->resp.status = status;
+    req->resp.error = error;
+    req->resp.done_us = now_us();
+    if (error != 0) {
+        m_stats.errors++;
+        if (error == ETIMEDOUT) {
+            m_stats.timeouts++;
+        }
+    } else {
+        m_stats.responses++;
+    }
+    if (req->cb) {
+        req->cb(req->resp);
+    }
+}
+
+// Requests not yet written go back to the queue. Written ones fail, except
+// that they are replayed once when the server closed the socket without
+// starting a reply: after announcing Connection: close, an idle keep-alive
+// connection it dropped, or a new one it had no room for (esp_http_server
+// closes sockets beyond max_open_sockets). Requests past their deadline and
+// those on a connection that never connected fail right away.
+void client_t::close_connection(connection_t *conn, int error)
+{
+    std::unique_ptr<connection_t> owned;
+    std::vector<std::pair<std::unique_ptr<pending_t>, int>> failed;
+    std::weak_ptr<bool> alive = m_alive;
+    bool peer_closed = conn->in.empty() && (error == 0 || error == ECONNRESET || error == EPIPE);
+    bool replayable = peer_closed && (error == 0 || conn->completed > 0 || m_connections.size() > 1);
+    bool connect_failed = conn->connecting && !peer_closed;
+    int64_t now = now_us();
+
+    for (size_t i = 0; i < m_connections.size(); i++) {
+        if (m_connections[i].get() == conn) {
+            owned = std::move(m_connections[i]);
+            m_connections.erase(m_connections.begin() + (long)i);
+            break;
+        }
+    }
+    if (!owned) {
+        return;
+    }
+    m_loop.remove(conn->fd);
+    close(conn->fd);
+    // Refused before its first reply while others work: the server is full, stay below it
+    if (peer_closed && conn->completed == 0 && !m_connections.empty() && m_pool_limit > m_connections.size()) {
+        m_pool_limit = (unsigned)m_connections.size();
+        fprintf(stderr, "ns_client: %s: connection refused by a full server, pool limited to %u\n",
+                m_host.c_str(), m_pool_limit);
+    }
+
+    for (auto it = conn->inflight.rbegin(); it != conn->inflight.rend(); ++it) {
+        std::unique_ptr<pending_t> &req = *it;
+
+        if (req->deadline_us <= now) {
+            failed.emplace_back(std::move(req), ETIMEDOUT);
+        } else if (connect_failed) {
+            failed.emplace_back(std::move(req), error);
+        } else if (req->wire_start >= conn->bytes_written) {
+            req->resp.sent_us = 0;
+            m_queue.push_front(std::move(req));
+        } else if (replayable && !req->retried) {
+            req->retried = true;
+            req->resp.sent_us = 0;
+            m_stats.retries++;
+            m_queue.push_front(std::move(req));
+        } else {
+            failed.emplace_back(std::move(req), error != 0 ? error : ECONNRESET);
+        }
+    }
+    conn->inflight.clear();
+
+    // failed is newest first
+    for (auto it = failed.rbegin(); it != failed.rend(); ++it) {
+        finish(std::move(it->first), 0, it->second);
+        if (alive.expired()) {
+            return;
+        }
+    }
+    pump();
+}
+
+void client_t::arm_timeout()
+{
+    int64_t deadline = 0;
+
+    auto consider = [&deadline](int64_t at) {
+        if (at > 0 && (deadline == 0 || at < deadline)) {
+            deadline = at;
+        }
+    };
+
+    if (!m_queue.empty()) {
+        consider(m_queue.front()->deadline_us);
+    }
+    for (const auto &conn : m_connections) {
+        if (conn->connecting) {
+            consider(conn->connect_deadline_us);
+        }
+        if (!conn->inflight.empty()) {
+            consider(conn->inflight.front()->deadline_us);
+        }
+    }
+    if (deadline == m_timer_at) {
+        return;
+    }
+    if (m_timer != 0) {
+        m_loop.cancel_timer(m_timer);
+        m_timer = 0;
+    }
+    m_timer_at = deadline;
+    if (deadline != 0) {
+        m_timer = m_loop.add_timer(deadline, [this]() {
+            m_timer = 0;
+            m_timer_at = 0;
+            on_timeout();
+        });
+    }
+}
+
+void client_t::on_timeout()
+{
+    std::vector<std::unique_ptr<pending_t>> expired;
+    std::vector<connection_t *> stale;
+    std::weak_ptr<bool> alive = m_alive;
+    int64_t now = now_us();
+
+    while (!m_queue.empty() && m_queue.front()->deadline_us <= now) {
+        expired.push_back(std::move(m_queue.front()));
+        m_queue.pop_front();
+    }
+    for (const auto &conn : m_connections) {
+        if ((conn->connecting && conn->connect_deadline_us <= now) ||
+            (!conn->inflight.empty() && conn->inflight.front()->deadline_us <= now)) {
+            stale.push_back(conn.get());
+        }
+    }
+
+    for (auto &req : expired) {
+        finish(std::move(req), 0, ETIMEDOUT);
+        if (alive.expired()) {
+            return;
+        }
+    }
+    for (connection_t *conn : stale) {
+        close_connection(conn, ETIMEDOUT);
+        if (alive.expired()) {
+            return;
+        }
+    }
+    arm_timeout();
+}
+
+//--------------------------------------------------------------------+
+// State stream and clock sync
+//--------------------------------------------------------------------+
+bool client_t::open_udp()
+{
+    sockaddr_in sin;
+
+    if (m_udp_fd >= 0) {
+        return true;
+    }
+    m_udp_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_udp_fd < 0) {
+        return false;
+    }
+    memcpy(&sin, m_addr.data(), sizeof(sin));
+    sin.sin_port = htons(m_options.udp_port);
+    if (connect(m_udp_fd, (sockaddr *)&sin, sizeof(sin)) != 0 ||
+        !m_loop.add(m_udp_fd, EPOLLIN, [this](uint32_t events) { on_udp_events(events); })) {
+        close(m_udp_fd);
+        m_udp_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool client_t::open_stream(stream_mode_t mode)
+{
+    close_stream();
+    m_stream_mode = mode;
+    m_stream_seq = 0;
+
+    if (mode == stream_mode_t::udp) {
+        m_stream_open = open_udp();
+        return m_stream_open;
+    }
+
+    m_ws = std::make_unique<ws_t>();
+    m_ws->fd = connect_tcp(m_addr, m_options.http_port);
+    if (m_ws->fd < 0) {
+        m_ws.reset();
+        return false;
+    }
+    uint8_t nonce[16];
+    for (uint8_t &byte : nonce) {
+        byte = (uint8_t)rand();
+    }
+    m_ws->key = base64(nonce, sizeof(nonce));
+    m_ws->out = "GET /ws HTTP/1.1\r\nHost: " + m_host +
+                "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: " + m_ws->key +
+                "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+    m_ws->events = EPOLLIN | EPOLLOUT;
+    if (!m_loop.add(m_ws->fd, m_ws->events, [this](uint32_t events) { on_ws_events(events); })) {
+        close(m_ws->fd);
+        m_ws.reset();
+        return false;
+    }
+    m_stream_open = true;
+    return true;
+}
+
+void client_t::close_stream()
+{
+    close_ws();
+    m_stream_open = false;
+}
+
+void client_t::close_ws()
+{
+    if (!m_ws) {
+        return;
+    }
+    m_loop.remove(m_ws->fd);
+    close(m_ws->fd);
+    m_ws.reset();
+}
+
+bool client_t::stream_ready() const
+{
+    if (!m_stream_open) {
+        return false;
+    }
+    return m_stream_mode == stream_mode_t::udp ? m_udp_fd >= 0 : (m_ws && m_ws->open);
+}
+
+bool client_t::send_state(const state_t &state, int64_t at_device_us, uint8_t flags)
+{
+    uint8_t pkt[kStatePacketLen];
+    uint64_t timestamp = (uint64_t)now_us();
+
+    if (!stream_ready()) {
+        m_stats.stream_dropped++;
+        return false;
+    }
+    if (at_device_us > 0) {
+        flags |= kStreamFlagAt;
+        timestamp = (uint64_t)at_device_us;
+    }
+    // The first packet of a session restarts the device's sequence tracking
+    if (m_stream_seq == 0) {
+        flags |= kStreamFlagReset;
+    }
+    encode_state(pkt, state, ++m_stream_seq, timestamp, flags);
+
+    if (m_stream_mode == stream_mode_t::udp) {
+        if (send(m_udp_fd, pkt, sizeof(pkt), 0) != (ssize_t)sizeof(pkt)) {
+            m_stats.stream_dropped++;
+            return false;
+        }
+        m_stats.stream_sent++;
+        return true;
+    }
+
+    if (m_ws->out.size() > kWsBacklogMax) {
+        m_stats.stream_dropped++;
+        return false;
+    }
+    // Client frames are masked (RFC 6455 5.3): FIN + binary, 7-bit length
+    uint8_t frame[6 + kStatePacketLen];
+    frame[0] = 0x82;
+    frame[1] = 0x80 | (uint8_t)kStatePacketLen;
+    put_u32(&frame[2], (uint32_t)rand());
+    for (size_t i = 0; i < kStatePacketLen; i++) {
+        frame[6 + i] = pkt[i] ^ frame[2 + (i & 3)];
+    }
+    m_ws->out.append((const char *)frame, sizeof(frame));
+    while (!m_ws->out.empty()) {
+        ssize_t n = send(m_ws->fd, m_ws->out.data(), m_ws->out.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                close_ws();
+                m_stats.stream_dropped++;
+                return false;
+            }
+            break;
+        }
+        m_ws->out.erase(0, (size_t)n);
+    }
+    if (!m_ws->out.empty() && !(m_ws->events & EPOLLOUT)) {
+        m_ws->events |= EPOLLOUT;
+        m_loop.modify(m_ws->fd, m_ws->events);
+    }
+    m_stats.stream_sent++;
+    return true;
+}
+
+void client_t::on_ws_events(uint32_t events)
+{
+    ws_t *ws = m_ws.get();
+    char buf[1024];
+
+    if (ws->connecting) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+
+        getsockopt(ws->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        if (err != 0) {
+            close_ws();
+            return;
+        }
+        ws->connecting = false;
+    }
+
+    if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        for (;;) {
+            ssize_t n = recv(ws->fd, buf, sizeof(buf), 0);
+            if (n > 0) {
+                ws->in.append(buf, (size_t)n);
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+                close_ws();
+                return;
+            }
+            break;
+        }
+
+        if (!ws->open) {
+            size_t end = ws->in.find("\r\n\r\n");
+            if (end == std::string::npos) {
+                if (ws->in.size() > kHeaderMax) {
+                    close_ws();
+                }
+                return;
+            }
+            std::string head = ws->in.substr(0, end + 2);
+            if (head.compare(0, 12, "HTTP/1.1 101") != 0 ||
+                header_value(head, "Sec-WebSocket-Accept") != ws_accept_key(ws->key)) {
+                fprintf(stderr, "ns_client: %s: /ws handshake rejected\n", m_host.c_str());
+                close_ws();
+                return;
+            }
+            ws->in.erase(0, end + 4);
+            ws->open = true;
+        }
+
+        // Server frames are unmasked; answer pings, stop on close, ignore the rest
+        while (ws->in.size() >= 2) {
+            uint8_t opcode = (uint8_t)ws->in[0] & 0x0F;
+            size_t len = (uint8_t)ws->in[1] & 0x7F;
+            size_t head = 2;
+
+            if (len == 126) {
+                if (ws->in.size() < 4) {
+                    break;
+                }
+                len = ((size_t)(uint8_t)ws->in[2] << 8) | (uint8_t)ws->in[3];
+                head = 4;
+            } else if (len == 127) {
+                close_ws();
+                return;
+            }
+            if (ws->in.size() < head + len) {
+                break;
+            }
+            if (opcode == 0x8) {
+                close_ws();
+                return;
+            }
+            if (opcode == 0x9 && len <= 125) {
+                ws->out += (char)0x8A;
+                ws->out += (char)(0x80 | len);
+                ws->out.append(4, '\0');
+                ws->out.append(ws->in, head, len);
+            }
+            ws->in.erase(0, head + len);
+        }
+    }
+
+    while (!ws->out.empty()) {
+        ssize_t n = send(ws->fd, ws->out.data(), ws->out.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                close_ws();
+                return;
+            }
+            break;
+        }
+        ws->out.erase(0, (size_t)n);
+    }
+    uint32_t want = ws->out.empty() ? (uint32_t)EPOLLIN : (uint32_t)(EPOLLIN | EPOLLOUT);
+    if (want != ws->events) {
+        ws->events = want;
+        m_loop.modify(ws->fd, want);
+    }
+}
+
+void client_t::on_udp_events(uint32_t events)
+{
+    uint8_t buf[64];
+
+    (void)events;
+    for (;;) {
+        ssize_t n = recv(m_udp_fd, buf, sizeof(buf), 0);
+        int64_t t4 = now_us();
+
+        if (n < 0) {
+            // ECONNREFUSED from an ICMP port unreachable is reported here too
+            break;
+        }
+        if (n != (ssize_t)kSyncReplyLen || buf[0] != 'N' || buf[1] != 'T') {
+            continue;
+        }
+        auto it = m_sync_outstanding.find(get_u32(&buf[4]));
+        if (it == m_sync_outstanding.end()) {
+            continue;
+        }
+        m_sync_outstanding.erase(it);
+        m_stats.sync_replies++;
+        m_clock.add((int64_t)get_u64(&buf[8]), (int64_t)get_u64(&buf[16]), (int64_t)get_u64(&buf[24]), t4);
+    }
+
+    if (m_sync_all_sent && m_sync_outstanding.empty()) {
+        sync_finish();
+    }
+}
+
+void client_t::sync_clock(unsigned count, int64_t interval_us, std::function<void()> done)
+{
+    if (m_sync_timer != 0) {
+        m_loop.cancel_timer(m_sync_timer);
+        m_sync_timer = 0;
+    }
+    m_sync_outstanding.clear();
+    m_sync_all_sent = false;
+    m_sync_done = std::move(done);
+    if (count == 0 || !open_udp()) {
+        sync_finish();
+        return;
+    }
+    sync_step(count, interval_us);
+}
+
+void client_t::sync_step(unsigned remaining, int64_t interval_us)
+{
+    uint8_t req[kSyncReqLen] = {'N', 'T', kStreamVersion, 0};
+    int64_t t1 = now_us();
+    uint32_t id = ++m_sync_id;
+
+    put_u32(&req[4], id);
+    put_u64(&req[8], (uint64_t)t1);
+    if (send(m_udp_fd, req, sizeof(req), 0) == (ssize_t)sizeof(req)) {
+        m_sync_outstanding[id] = t1;
+        m_stats.sync_sent++;
+    }
+
+    std::weak_ptr<bool> alive = m_alive;
+    if (remaining > 1) {
+        m_sync_timer = m_loop.add_timer(t1 + interval_us, [this, alive, remaining, interval_us]() {
+            if (alive.expired()) {
+                return;
+            }
+            m_sync_timer = 0;
+            sync_step(remaining - 1, interval_us);
+        });
+        return;
+    }
+    // Last request sent: finish on the last reply, or give up on stragglers after the timeout
+    m_sync_all_sent = true;
+    if (m_sync_outstanding.empty()) {
+        sync_finish();
+        return;
+    }
+    m_sync_timer = m_loop.add_timer(t1 + m_options.timeout_us, [this, alive]() {
+        if (alive.expired()) {
+            return;
+        }
+        m_sync_timer = 0;
+        sync_finish();
+    });
+}
+
+void client_t::sync_finish()
+{
+    std::function<void()> done = std::move(m_sync_done);
+
+    if (m_sync_timer != 0) {
+        m_loop.cancel_timer(m_sync_timer);
+        m_sync_timer = 0;
+    }
+    m_sync_done = nullptr;
+    m_sync_all_sent = false;
+    m_sync_outstanding.clear();
+    if (done) {
+        done();
+    }
+}
+
+void client_t::sync_clock_http(unsigned count, std::function<void()> done)
+{
+    if (count == 0) {
+        if (done) {
+            done();
+        }
+        return;
+    }
+    std::weak_ptr<bool> alive = m_alive;
+    device_time([this, alive, count, done](const response_t &resp) {
+        if (alive.expired()) {
+            return;
+        }
+        const char *field = resp.ok() ? strstr(resp.body.c_str(), "\"device_us\":") : nullptr;
+        if (field != nullptr && resp.sent_us != 0) {
+            int64_t device_us = strtoll(field + 12, nullptr, 10);
+            m_clock.add(resp.sent_us, device_us, device_us, resp.done_us);
+        }
+        sync_clock_http(count - 1, done);
+    });
+}
+
+} // namespace ns
@@ -0,0 +1,301 @@
+/*
+ * Asynchronous C++ client for the bridge's control API (ns_wifi_control.c).
+ *
+ * One loop_t (epoll) drives any number of client_t, one per bridge. Each
+ * client keeps a small pool of keep-alive HTTP/1.1 connections and pipelines
+ * requests on them, streams full controller state as binary packets over UDP
+ * or the /ws socket, and estimates the device clock from "NT" sync exchanges
+ * so inputs can be scheduled in device time (FLAG_AT, "at_us").
+ *
+ * Everything runs on the thread that calls loop_t::run_*(); callbacks are
+ * invoked from there and may issue new requests.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns {
+
+// Wire formats, mirrored from main/ns_udp_stream.h (which needs the TinyUSB headers)
+constexpr uint16_t kStreamPort = 5005;
+constexpr uint8_t kStreamVersion = 1;
+constexpr size_t kStatePacketLen = 40;
+constexpr uint8_t kStreamFlagImu = 0x01;
+constexpr uint8_t kStreamFlagReset = 0x02;
+constexpr uint8_t kStreamFlagAt = 0x04;
+constexpr uint8_t kStreamFlagBuffered = 0x08;
+constexpr size_t kSyncReqLen = 16;
+constexpr size_t kSyncReplyLen = 32;
+constexpr uint16_t kAxisCenter = 0x800;
+
+int64_t now_us();
+
+//--------------------------------------------------------------------+
+// Event loop
+//--------------------------------------------------------------------+
+class loop_t {
+public:
+    using fd_handler_t = std::function<void(uint32_t events)>;
+    using timer_fn_t = std::function<void()>;
+
+    loop_t();
+    ~loop_t();
+    loop_t(const loop_t &) = delete;
+    loop_t &operator=(const loop_t &) = delete;
+
+    bool add(int fd, uint32_t events, fd_handler_t handler);
+    bool modify(int fd, uint32_t events);
+    // Safe from inside a handler; pending events for the fd are dropped.
+    void remove(int fd);
+
+    uint64_t add_timer(int64_t at_us, timer_fn_t fn);
+    void cancel_timer(uint64_t id);
+
+    // Waits at most max_wait_us (-1: until the next timer or event) and dispatches.
+    void run_once(int64_t max_wait_us = -1);
+    // Runs until done() returns true or deadline_us (0: none) passes; false on timeout.
+    bool run_until(const std::function<bool()> &done, int64_t deadline_us = 0);
+
+private:
+    struct entry_t {
+        int fd;
+        // Shared so a handler that removes its own fd stays alive until it returns
+        std::shared_ptr<fd_handler_t> handler;
+    };
+
+    int m_epfd;
+    uint64_t m_next_token = 1;
+    uint64_t m_next_timer = 1;
+    std::unordered_map<int, uint64_t> m_fd_tokens;
+    std::unordered_map<uint64_t, entry_t> m_entries;
+    std::map<std::pair<int64_t, uint64_t>, timer_fn_t> m_timers;
+    std::unordered_map<uint64_t, int64_t> m_timer_at;
+};
+
+//--------------------------------------------------------------------+
+// Controller state and clock
+//--------------------------------------------------------------------+
+struct state_t {
+    uint32_t buttons = 0;       // bit n = button id n, as NS_BUTTON_MASK()
+    uint16_t lx = kAxisCenter;
+    uint16_t ly = kAxisCenter;
+    uint16_t rx = kAxisCenter;
+    uint16_t ry = kAxisCenter;
+    bool imu = false;
+    int16_t accel[3] = {0, 0, 0};
+    int16_t gyro[3] = {0, 0, 0};
+};
+
+// Encodes one NS_UDP_STREAM_PACKET_LEN datagram; kStreamFlagImu is added when state.imu is set.
+void encode_state(uint8_t out[kStatePacketLen], const state_t &state, uint32_t seq,
+                  uint64_t timestamp_us, uint8_t flags);
+// JSON body for POST /state; hold_ms and at_us are left out when 0.
+std::string state_json(const state_t &state, uint32_t hold_ms = 0, int64_t at_us = 0);
+// Button id for an API name ("A", "zr", "HOME", ...), -1 if unknown.
+int button_id(const std::string &name);
+const char *button_name(int id);
+// Sec-WebSocket-Accept for a handshake key (RFC 6455 section 4.2.2).
+std::string ws_accept_key(const std::string &key);
+
+/*
+ * NTP-style offset estimate from (t1, t2, t3, t4) exchanges. Only samples whose
+ * round trip is close to the minimum seen are trusted: Wi-Fi queuing only ever
+ * adds delay, and it is rarely symmetric. With samples spanning more than a
+ * second, drift is fitted as well so the estimate holds between syncs.
+ */
+class clock_estimator_t {
+public:
+    // Client times t1/t4 and device times t2/t3, all in microseconds.
+    void add(int64_t t1, int64_t t2, int64_t t3, int64_t t4);
+    void reset();
+
+    bool valid() const { return !m_samples.empty(); }
+    size_t samples() const { return m_samples.size(); }
+    // Device time minus client time at client time client_us.
+    int64_t offset_us(int64_t client_us) const;
+    int64_t offset_us() const { return offset_us(now_us()); }
+    int64_t to_device_us(int64_t client_us) const { return client_us + offset_us(client_us); }
+    double drift_ppm() const { return m_drift * 1e6; }
+    int64_t min_delay_us() const { return m_min_delay_us; }
+    // Half the minimum round trip: the offset error bound if the path were fully asymmetric.
+    int64_t uncertainty_us() const { return m_uncertainty_us; }
+
+    static constexpr size_t kMaxSamples = 128;
+
+private:
+    struct sample_t {
+        int64_t t4;
+        int64_t offset;
+        int64_t delay;
+    };
+
+    void refit();
+
+    std::deque<sample_t> m_samples;
+    int64_t m_ref_us = 0;
+    int64_t m_offset_us = 0;
+    double m_drift = 0.0;
+    int64_t m_min_delay_us = 0;
+    int64_t m_uncertainty_us = 0;
+};
+
+//--------------------------------------------------------------------+
+// Client
+//--------------------------------------------------------------------+
+struct response_t {
+    int status = 0;             // HTTP status, 0 when the request failed in transport
+    int error = 0;              // errno value: ETIMEDOUT, ECONNRESET, ECONNREFUSED, EPROTO, ...
+    std::string body;
+    int64_t queued_us = 0;
+    int64_t sent_us = 0;        // request fully written to the socket
+    int64_t done_us = 0;
+    bool pipelined = false;     // written while earlier requests on the connection were pending
+    bool fresh_connection = false;
+
+    bool ok() const { return error == 0 && status >= 200 && status < 300; }
+    // Time the caller waited, queuing in the pool included.
+    int64_t latency_us() const { return done_us - queued_us; }
+};
+
+using response_cb_t = std::function<void(const response_t &)>;
+
+struct client_options_t {
+    uint16_t http_port = 80;
+    uint16_t udp_port = kStreamPort;
+    // esp_http_server serves 7 sockets in total and drops connections beyond that
+    unsigned max_connections = 3;
+    // Requests in flight per connection; 1 disables pipelining
+    unsigned pipeline_depth = 8;
+    int64_t timeout_us = 2000000;
+    int64_t connect_timeout_us = 1000000;
+    // Sent as X-Client-Id so requests on every pooled connection share one input layer
+    // on the bridge; empty picks an id unique to this client_t. The WebSocket always
+    // gets its own layer.
+    std::string client_id;
+};
+
+struct client_stats_t {
+    uint64_t requests = 0;
+    uint64_t responses = 0;
+    uint64_t errors = 0;        // transport errors and timeouts
+    uint64_t timeouts = 0;
+    uint64_t retries = 0;       // replayed after the server closed an idle keep-alive connection
+    uint64_t connects = 0;
+    uint64_t pipelined = 0;
+    uint64_t stream_sent = 0;
+    uint64_t stream_dropped = 0; // socket buffer full (UDP) or WebSocket not open
+    uint64_t sync_sent = 0;
+    uint64_t sync_replies = 0;
+};
+
+enum class stream_mode_t { udp, ws };
+
+class client_t {
+public:
+    client_t(loop_t &loop, const std::string &host, const client_options_t &options = {});
+    ~client_t();
+    client_t(const client_t &) = delete;
+    client_t &operator=(const client_t &) = delete;
+
+    const std::string &host() const { return m_host; }
+
+    // Generic request; path includes the query string. Body is sent with POST only.
+    void request(const char *method, const std::string &path, const std::string &body, response_cb_t cb);
+    void get(const std::string &path, response_cb_t cb) { request("GET", path, std::string(), std::move(cb)); }
+
+    // Endpoint helpers, same parameters as the HTTP API
+    void health(response_cb_t cb);
+    void press(const std::string &button, response_cb_t cb);
+    void hold(const std::string &button, uint32_t ms, response_cb_t cb);
+    void button(const std::string &button, uint32_t lease_ms, response_cb_t cb);
+    void release(response_cb_t cb);
+    void set_state(const state_t &state, uint32_t hold_ms, int64_t at_us, response_cb_t cb);
+    void device_time(response_cb_t cb);
+    void metrics(response_cb_t cb);
+
+    // Requests queued or in flight
+    size_t pending() const;
+    const client_stats_t &stats() const { return m_stats; }
+    // max_connections, or fewer after the server refused connections beyond its socket limit
+    unsigned pool_limit() const { return m_pool_limit; }
+
+    // Binary state stream. With ws the /ws handshake runs in the background and
+    // packets sent before it completes are dropped.
+    bool open_stream(stream_mode_t mode);
+    void close_stream();
+    bool stream_ready() const;
+    // at_device_us > 0 schedules the state at that device time (kStreamFlagAt).
+    bool send_state(const state_t &state, int64_t at_device_us = 0, uint8_t flags = 0);
+
+    // Sends `count` "NT" requests `interval_us` apart over UDP and feeds the replies to clock().
+    // done runs once the last reply arrived or timed out.
+    void sync_clock(unsigned count, int64_t interval_us, std::function<void()> done = nullptr);
+    // Same over GET /time, for when UDP is filtered: t2 = t3 = device_us, so less precise.
+    void sync_clock_http(unsigned count, std::function<void()> done = nullptr);
+    clock_estimator_t &clock() { return m_clock; }
+
+private:
+    struct pending_t;
+    struct connection_t;
+    struct ws_t;
+
+    void enqueue(std::unique_ptr<pending_t> req);
+    void pump();
+    connection_t *open_connection();
+    void close_connection(connection_t *conn, int error);
+    void on_connection_events(connection_t *conn, uint32_t events);
+    bool flush(connection_t *conn);
+    bool parse(connection_t *conn);
+    void finish(std::unique_ptr<pending_t> req, int status, int error);
+    void reap();
+    void arm_timeout();
+    void on_timeout();
+    void update_interest(connection_t *conn);
+
+    bool open_udp();
+    void on_udp_events(uint32_t events);
+    void on_ws_events(uint32_t events);
+    void close_ws();
+    void sync_step(unsigned remaining, int64_t interval_us);
+    void sync_finish();
+
+    loop_t &m_loop;
+    std::string m_host;
+    client_options_t m_options;
+    client_stats_t m_stats;
+    std::vector<uint8_t> m_addr;  // sockaddr_in
+
+    std::deque<std::unique_ptr<pending_t>> m_queue;
+    std::vector<std::unique_ptr<connection_t>> m_connections;
+    unsigned m_pool_limit = 1;
+    uint64_t m_timer = 0;
+    int64_t m_timer_at = 0;
+
+    int m_udp_fd = -1;
+    stream_mode_t m_stream_mode = stream_mode_t::udp;
+    bool m_stream_open = false;
+    uint32_t m_stream_seq = 0;
+    std::unique_ptr<ws_t> m_ws;
+
+    clock_estimator_t m_clock;
+    uint32_t m_sync_id = 0;
+    std::unordered_map<uint32_t, int64_t> m_sync_outstanding;
+    std::function<void()> m_sync_done;
+    bool m_sync_all_sent = false;
+    uint64_t m_sync_timer = 0;
+    unsigned m_sync_http_remaining = 0;
+
+    // Expires with the client, so callbacks and timers can tell it was destroyed under them
+    std::shared_ptr<bool> m_alive;
+};
+
+} // namespace ns
@@ -0,0 +1,323 @@
+/*
+ * Per-call latency of the control API with the ns_client SDK, compared with
+ * what test_http_api.py does (a new connection per call):
+ *
+ *   ./_build/ns_client_bench [-H host] [-n calls] [-c conns] [-d depth] [-s service_us]
+ *
+ * Without -H a stand-in server (ns_stub_server.h) runs on a second thread on
+ * 127.0.0.1, so the SDK can be measured without hardware; -s then sets its
+ * handler time. Against the stub the clock estimate is also checked against
+ * the true offset.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ns_client.h"
+#include "ns_stub_server.h"
+
+namespace {
+
+struct run_t {
+    std::vector<int64_t> latency_us;
+    unsigned errors = 0;
+    int64_t elapsed_us = 0;
+};
+
+void print_run(const char *name, run_t &run)
+{
+    std::vector<int64_t> &v = run.latency_us;
+
+    if (v.empty()) {
+        printf("%-22s no responses, %u errors\n", name, run.errors);
+        return;
+    }
+    std::sort(v.begin(), v.end());
+    auto pct = [&v](int permille) { return (long long)v[std::min(v.size() - 1, v.size() * permille / 1000)]; };
+    printf("%-22s n=%-6zu p50 %6lld  p90 %6lld  p99 %6lld  max %6lld us  %8.0f calls/s  errors %u\n",
+           name, v.size(), pct(500), pct(900), pct(990), (long long)v.back(),
+           (double)v.size() * 1e6 / (double)std::max<int64_t>(1, run.elapsed_us), run.errors);
+}
+
+void record(run_t &run, const ns::response_t &resp)
+{
+    if (resp.ok()) {
+        run.latency_us.push_back(resp.latency_us());
+    } else {
+        run.errors++;
+    }
+}
+
+// Keeps `window` calls in flight until `calls` completed; window 1 is strictly serial.
+run_t closed_loop(ns::loop_t &loop, ns::client_t &client, unsigned calls, unsigned window)
+{
+    run_t run;
+    unsigned issued = 0;
+    unsigned done = 0;
+    int64_t start = ns::now_us();
+    std::function<void()> issue;
+
+    issue = [&]() {
+        // Alternate the input endpoints the orchestration uses most
+        static const char *const buttons[] = {"A", "B", "X", "Y"};
+        const char *button = buttons[issued % 4];
+
+        issued++;
+        auto on_done = [&](const ns::response_t &resp) {
+            record(run, resp);
+            done++;
+            if (issued < calls) {
+                issue();
+            }
+        };
+        if (issued % 2) {
+            client.press(button, on_done);
+        } else {
+            client.hold(button, 50, on_done);
+        }
+    };
+    while (issued < std::min(calls, window)) {
+        issue();
+    }
+    loop.run_until([&]() { return done >= calls; });
+    run.elapsed_us = ns::now_us() - start;
+    return run;
+}
+
+run_t connect_per_call(ns::loop_t &loop, const std::string &host, ns::client_options_t options,
+                       unsigned calls)
+{
+    run_t run;
+    int64_t start = ns::now_us();
+
+    options.max_connections = 1;
+    options.pipeline_depth = 1;
+    for (unsigned i = 0; i < calls; i++) {
+        ns::client_t client(loop, host, options);
+        bool done = false;
+
+        client.press("A", [&](const ns::response_t &resp) {
+            record(run, resp);
+            done = true;
+        });
+        loop.run_until([&]() { return done; });
+    }
+    run.elapsed_us = ns::now_us() - start;
+    return run;
+}
+
+long long json_field(const std::string &body, const char *key)
+{
+    std::string needle = std::string("\"") + key + "\":";
+    size_t pos = body.find(needle);
+
+    return pos == std::string::npos ? -1 : strtoll(body.c_str() + pos + needle.size(), nullptr, 10);
+}
+
+long long stream_received(ns::loop_t &loop, ns::client_t &client)
+{
+    long long received = -1;
+    bool done = false;
+
+    client.get("/stream", [&](const ns::response_t &resp) {
+        received = resp.ok() ? json_field(resp.body, "applied") : -1;
+        done = true;
+    });
+    loop.run_until([&]() { return done; });
+    return received;
+}
+
+void stream_run(ns::loop_t &loop, ns::client_t &client, ns::stream_mode_t mode, unsigned packets)
+{
+    const char *name = mode == ns::stream_mode_t::udp ? "state stream udp" : "state stream ws";
+    long long before = stream_received(loop, client);
+    ns::state_t state;
+    int64_t start;
+    int64_t send_us = 0;
+    uint64_t sent_before = client.stats().stream_sent;
+
+    if (!client.open_stream(mode) ||
+        !loop.run_until([&]() { return client.stream_ready(); }, ns::now_us() + 2000000)) {
+        printf("%-22s could not open\n", name);
+        return;
+    }
+    start = ns::now_us();
+    for (unsigned i = 0; i < packets; i++) {
+        int64_t t0 = ns::now_us();
+
+        state.lx = (uint16_t)(i & 0x0FFF);
+        state.buttons = (i & 16) ? (1U << 4) : 0;
+        client.send_state(state);
+        send_us += ns::now_us() - t0;
+        // Let the loop flush the WebSocket and keep the UDP receive buffer from overflowing
+        if ((i & 31) == 31) {
+            loop.run_once(100);
+        }
+    }
+    loop.run_once(1000);
+    int64_t elapsed = ns::now_us() - start;
+    // /stream counts are updated by the server after the packets arrive
+    loop.run_once(20000);
+    long long after = stream_received(loop, client);
+    client.close_stream();
+
+    printf("%-22s sent %llu in %lld us (%.2f us per packet), server applied %lld\n", name,
+           (unsigned long long)(client.stats().stream_sent - sent_before), (long long)elapsed,
+           (double)send_us / packets, before >= 0 && after >= 0 ? after - before : -1);
+}
+
+void clock_run(ns::loop_t &loop, ns::client_t &client, bool http, bool have_truth, int64_t true_offset)
+{
+    bool done = false;
+
+    client.clock().reset();
+    if (http) {
+        client.sync_clock_http(50, [&done]() { done = true; });
+    } else {
+        client.sync_clock(50, 2000, [&done]() { done = true; });
+    }
+    loop.run_until([&done]() { return done; });
+
+    ns::clock_estimator_t &clock = client.clock();
+    if (!clock.valid()) {
+        printf("%-22s no samples\n", http ? "clock sync http" : "clock sync udp");
+        return;
+    }
+    printf("%-22s %zu samples, offset %lld us, min rtt %lld us, +-%lld us",
+           http ? "clock sync http" : "clock sync udp", clock.samples(), (long long)clock.offset_us(),
+           (long long)clock.min_delay_us(), (long long)clock.uncertainty_us());
+    if (have_truth) {
+        printf(", error %lld us", (long long)(clock.offset_us() - true_offset));
+    }
+    printf("\n");
+}
+
+void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [-H host] [-p http_port] [-u udp_port] [-n calls] [-c conns] [-d depth] [-s service_us] [-m sockets]\n"
+            "  -H  bridge address (default: run the stand-in server on 127.0.0.1)\n"
+            "  -n  calls per phase (default 2000)\n"
+            "  -c  pooled connections (default 3)\n"
+            "  -d  pipeline depth per connection (default 8)\n"
+            "  -s  stand-in server handler time in us (default 0)\n"
+            "  -m  stand-in server socket limit (default 7)\n",
+            argv0);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    ns::client_options_t options;
+    ns::stub_options_t stub_options;
+    std::string host;
+    unsigned calls = 2000;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "H:p:u:n:c:d:s:m:h")) != -1) {
+        switch (opt) {
+        case 'H':
+            host = optarg;
+            break;
+        case 'p':
+            options.http_port = (uint16_t)atoi(optarg);
+            break;
+        case 'u':
+            options.udp_port = (uint16_t)atoi(optarg);
+            break;
+        case 'n':
+            calls = (unsigned)atoi(optarg);
+            break;
+        case 'c':
+            options.max_connections = (unsigned)atoi(optarg);
+            break;
+        case 'd':
+            options.pipeline_depth = (unsigned)atoi(optarg);
+            break;
+        case 's':
+            stub_options.service_us = atoll(optarg);
+            break;
+        case 'm':
+            stub_options.max_sockets = (unsigned)atoi(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (calls == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Stand-in server on its own thread and loop, so its work is not counted as client time
+    ns::loop_t stub_loop;
+    std::unique_ptr<ns::stub_server_t> stub;
+    std::atomic<bool> stub_stop(false);
+    std::thread stub_thread;
+
+    if (host.empty()) {
+        stub_options.http_port = 0;
+        stub_options.udp_port = 0;
+        stub = std::make_unique<ns::stub_server_t>(stub_loop, stub_options);
+        if (!stub->start()) {
+            return 1;
+        }
+        host = "127.0.0.1";
+        options.http_port = stub->http_port();
+        options.udp_port = stub->udp_port();
+        stub_thread = std::thread([&stub_loop, &stub_stop]() {
+            while (!stub_stop.load()) {
+                stub_loop.run_once(10000);
+            }
+        });
+        printf("stand-in server on %s:%u (udp %u), handler time %lld us\n", host.c_str(),
+               (unsigned)options.http_port, (unsigned)options.udp_port, (long long)stub_options.service_us);
+    } else {
+        printf("bridge %s:%u (udp %u)\n", host.c_str(), (unsigned)options.http_port, (unsigned)options.udp_port);
+    }
+
+    ns::loop_t loop;
+    ns::client_t client(loop, host, options);
+    char name[32];
+
+    run_t run = connect_per_call(loop, host, options, std::min(calls, 500u));
+    print_run("connect per call", run);
+
+    ns::client_options_t serial_options = options;
+    serial_options.max_connections = 1;
+    serial_options.pipeline_depth = 1;
+    ns::client_t serial(loop, host, serial_options);
+    run = closed_loop(loop, serial, calls, 1);
+    print_run("keep-alive serial", run);
+
+    unsigned window = options.max_connections * options.pipeline_depth;
+    run = closed_loop(loop, client, calls, window);
+    snprintf(name, sizeof(name), "pipelined %ux%u", options.max_connections, options.pipeline_depth);
+    print_run(name, run);
+    printf("%-22s %llu connects, %llu pipelined, %llu retries, pool limit %u\n", "",
+           (unsigned long long)client.stats().connects, (unsigned long long)client.stats().pipelined,
+           (unsigned long long)client.stats().retries, client.pool_limit());
+
+    stream_run(loop, client, ns::stream_mode_t::udp, calls);
+    stream_run(loop, client, ns::stream_mode_t::ws, calls);
+
+    clock_run(loop, client, false, stub != nullptr, stub ? -stub->boot_us() : 0);
+    clock_run(loop, client, true, stub != nullptr, stub ? -stub->boot_us() : 0);
+
+    if (stub) {
+        stub_stop = true;
+        stub_thread.join();
+    }
+    return 0;
+}
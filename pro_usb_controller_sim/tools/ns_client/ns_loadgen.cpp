@@ -0,0 +1,783 @@
+/*
+ * Open-loop load generator for the control API. Requests to /press, /hold,
+ * /button and /health are issued on a fixed schedule (or Poisson arrivals)
+ * whether or not earlier ones were answered, so a device at capacity shows up
+ * as growing latency and errors instead of a slower request rate:
+ *
+ *   ./_build/ns_loadgen [-H host] [-r 100,200,400] [-t seconds] [-c conns] [-e press=4,hold=3,...]
+ *
+ * Latency is taken from the scheduled send time, not from when the request got
+ * a connection, so queuing in the pool is counted (no coordinated omission).
+ * Each rate step reports per-endpoint histograms, error and timeout rates, and
+ * the device's /metrics counters before and after. Without -H a stand-in
+ * server (ns_stub_server.h) runs on a second thread, to check the tool itself.
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ns_client.h"
+#include "ns_stub_server.h"
+
+namespace {
+
+enum endpoint_t { kPress, kHold, kButton, kHealth, kEndpointCount };
+
+const char *const kEndpointNames[kEndpointCount] = {"press", "hold", "button", "health"};
+const char *const kEndpointPaths[kEndpointCount] = {"/press", "/hold", "/button", "/health"};
+
+// Same choices as the --stress loop of test_http_api.py
+const char *const kButtons[] = {
+    "Y", "X", "B", "A", "L", "R", "ZL", "ZR", "MINUS", "PLUS",
+    "L_STICK", "R_STICK", "HOME", "CAPTURE", "UP", "DOWN", "LEFT", "RIGHT",
+};
+const uint32_t kHoldMs[] = {50, 80, 100, 150, 200, 300};
+constexpr uint32_t kLeaseMs = 200;
+
+//--------------------------------------------------------------------+
+// Latency histogram
+//--------------------------------------------------------------------+
+/*
+ * Log-linear buckets as in HdrHistogram: values below 2^kSubBits are exact,
+ * above that each power of two is split into 2^(kSubBits-1) buckets, so any
+ * value is kept to within 1/64 (1.6 %). Covers 1 us to about 18 minutes.
+ */
+class histogram_t {
+public:
+    static constexpr int kSubBits = 7;
+    static constexpr int kMaxBits = 40;
+
+    histogram_t() : m_counts(index_of((1LL << kMaxBits) - 1) + 1, 0) {}
+
+    void record(int64_t value)
+    {
+        value = std::max<int64_t>(0, std::min<int64_t>(value, (1LL << kMaxBits) - 1));
+        m_counts[index_of(value)]++;
+        m_total++;
+        m_sum += (double)value;
+        m_sum_sq += (double)value * (double)value;
+        m_min = m_total == 1 ? value : std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    void add(const histogram_t &other)
+    {
+        for (size_t i = 0; i < m_counts.size(); i++) {
+            m_counts[i] += other.m_counts[i];
+        }
+        if (other.m_total != 0) {
+            m_min = m_total == 0 ? other.m_min : std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+        }
+        m_total += other.m_total;
+        m_sum += other.m_sum;
+        m_sum_sq += other.m_sum_sq;
+    }
+
+    void reset() { *this = histogram_t(); }
+
+    uint64_t count() const { return m_total; }
+    int64_t min() const { return m_min; }
+    int64_t max() const { return m_max; }
+    double mean() const { return m_total ? m_sum / (double)m_total : 0.0; }
+    double stddev() const
+    {
+        double mean_v = mean();
+        return m_total ? std::sqrt(std::max(0.0, m_sum_sq / (double)m_total - mean_v * mean_v)) : 0.0;
+    }
+
+    // Highest value equivalent to the one at `percentile` (0..100), capped at the recorded max.
+    int64_t percentile(double percentile) const
+    {
+        uint64_t target;
+        uint64_t seen = 0;
+
+        if (m_total == 0) {
+            return 0;
+        }
+        target = std::max<uint64_t>(1, (uint64_t)std::ceil(percentile / 100.0 * (double)m_total));
+        for (size_t i = 0; i < m_counts.size(); i++) {
+            seen += m_counts[i];
+            if (seen >= target) {
+                return std::min(highest_of(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+    // HdrHistogram percentile distribution (.hgrm), values in milliseconds, 5 ticks per half distance.
+    void write_hgrm(FILE *out) const
+    {
+        double step = 100.0 / 2.0 / 5.0;
+        double level = 0.0;
+        double half = 50.0;
+
+        fprintf(out, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+        while (m_total != 0) {
+            int64_t value = percentile(level);
+            uint64_t below = count_at_or_below(value);
+
+            if (below >= m_total) {
+                fprintf(out, "%12.3f %14.12f %10llu\n", (double)value / 1000.0, 1.0, (unsigned long long)below);
+                break;
+            }
+            fprintf(out, "%12.3f %14.12f %10llu %14.2f\n", (double)value / 1000.0, level / 100.0,
+                    (unsigned long long)below, 1.0 / (1.0 - level / 100.0));
+            level += step;
+            if (level >= 100.0 - half + 1e-9) {
+                half /= 2.0;
+                step = half / 5.0;
+            }
+        }
+        fprintf(out, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean() / 1000.0, stddev() / 1000.0);
+        fprintf(out, "#[Max     = %12.3f, Total count    = %12llu]\n", (double)m_max / 1000.0,
+                (unsigned long long)m_total);
+        fprintf(out, "#[Buckets = %12zu, SubBuckets     = %12d]\n", m_counts.size(), 1 << kSubBits);
+    }
+
+private:
+    static size_t index_of(int64_t value)
+    {
+        int msb;
+        int shift;
+
+        if (value < (1LL << kSubBits)) {
+            return (size_t)value;
+        }
+        msb = 63 - __builtin_clzll((unsigned long long)value);
+        shift = msb - (kSubBits - 1);
+        return ((size_t)shift << (kSubBits - 1)) + (size_t)(value >> shift);
+    }
+
+    static int64_t highest_of(size_t index)
+    {
+        size_t half = (size_t)1 << (kSubBits - 1);
+        int shift;
+        int64_t sub;
+
+        if (index < ((size_t)1 << kSubBits)) {
+            return (int64_t)index;
+        }
+        shift = (int)(index / half) - 1;
+        sub = (int64_t)(index - (size_t)shift * half);
+        return ((sub + 1) << shift) - 1;
+    }
+
+    uint64_t count_at_or_below(int64_t value) const
+    {
+        uint64_t seen = 0;
+
+        for (size_t i = 0; i <= index_of(value); i++) {
+            seen += m_counts[i];
+        }
+        return seen;
+    }
+
+    std::vector<uint64_t> m_counts;
+    uint64_t m_total = 0;
+    double m_sum = 0.0;
+    double m_sum_sq = 0.0;
+    int64_t m_min = 0;
+    int64_t m_max = 0;
+};
+
+//--------------------------------------------------------------------+
+// Load steps
+//--------------------------------------------------------------------+
+struct endpoint_stats_t {
+    uint64_t sent = 0;
+    uint64_t ok = 0;
+    uint64_t http_errors = 0;   // answered with a non-2xx status
+    uint64_t errors = 0;        // transport errors other than timeouts
+    uint64_t timeouts = 0;
+    histogram_t latency;        // successful calls, from scheduled send time
+
+    uint64_t failed() const { return http_errors + errors + timeouts; }
+};
+
+struct step_t {
+    double rate = 0.0;
+    endpoint_stats_t endpoints[kEndpointCount];
+    uint64_t shed = 0;          // not sent: too many requests outstanding
+    int64_t lag_max_us = 0;     // how late the generator itself issued a request
+    double lag_sum_us = 0.0;
+    std::map<int, uint64_t> errnos;     // transport failures by errno, timeouts included
+};
+
+struct config_t {
+    std::vector<double> rates = {100.0};
+    int64_t duration_us = 10000000;
+    unsigned weights[kEndpointCount] = {4, 3, 1, 2};
+    bool poisson = false;
+    size_t max_outstanding = 4096;
+    int64_t report_us = 1000000;
+    std::string hgrm_prefix;
+    unsigned seed = 1;
+};
+
+class generator_t {
+public:
+    generator_t(ns::loop_t &loop, ns::client_t &client, const config_t &config)
+        : m_loop(loop), m_client(client), m_config(config), m_rng(config.seed)
+    {
+        for (unsigned weight : config.weights) {
+            m_weight_total += weight;
+        }
+    }
+
+    void run(step_t &step)
+    {
+        int64_t start = ns::now_us();
+        int64_t end = start + m_config.duration_us;
+        uint64_t timer;
+        uint64_t report_timer = 0;
+
+        m_step = &step;
+        m_next_at = start;
+        m_interval.reset();
+        m_interval_failed = 0;
+        m_interval_sent = 0;
+        m_run_start = start;
+        timer = m_loop.add_timer(m_next_at, [this, end, &timer]() { tick(end, timer); });
+        if (m_config.report_us > 0) {
+            report_timer = m_loop.add_timer(start + m_config.report_us, [this, &report_timer]() {
+                report(report_timer);
+            });
+        }
+        m_loop.run_until([this, end]() { return m_next_at >= end; });
+        m_loop.cancel_timer(timer);
+        // Every request ends by its timeout at the latest
+        m_loop.run_until([this]() { return m_client.pending() == 0; });
+        if (report_timer != 0) {
+            m_loop.cancel_timer(report_timer);
+        }
+        m_step = nullptr;
+    }
+
+private:
+    // Issues every request whose scheduled time has come, then sleeps until the next one.
+    void tick(int64_t end, uint64_t &timer)
+    {
+        int64_t now = ns::now_us();
+
+        while (m_next_at <= now && m_next_at < end) {
+            int64_t lag = now - m_next_at;
+
+            m_step->lag_max_us = std::max(m_step->lag_max_us, lag);
+            m_step->lag_sum_us += (double)lag;
+            issue(m_next_at);
+            m_next_at += next_gap();
+        }
+        if (m_next_at < end) {
+            timer = m_loop.add_timer(m_next_at, [this, end, &timer]() { tick(end, timer); });
+        } else {
+            m_next_at = end;
+            timer = 0;
+        }
+    }
+
+    int64_t next_gap()
+    {
+        double mean_us = 1e6 / m_step->rate;
+
+        if (m_config.poisson) {
+            std::exponential_distribution<double> gap(1.0 / mean_us);
+            m_carry_us += gap(m_rng);
+        } else {
+            m_carry_us += mean_us;
+        }
+        // Carry the fraction so rates that do not divide 1 s are still met on average
+        int64_t whole = (int64_t)m_carry_us;
+        m_carry_us -= (double)whole;
+        return std::max<int64_t>(whole, 0);
+    }
+
+    void issue(int64_t scheduled_us)
+    {
+        unsigned pick = std::uniform_int_distribution<unsigned>(0, m_weight_total - 1)(m_rng);
+        const char *button = kButtons[m_rng() % (sizeof(kButtons) / sizeof(kButtons[0]))];
+        int endpoint = 0;
+
+        while (pick >= m_config.weights[endpoint]) {
+            pick -= m_config.weights[endpoint];
+            endpoint++;
+        }
+        if (m_client.pending() >= m_config.max_outstanding) {
+            m_step->shed++;
+            return;
+        }
+        m_step->endpoints[endpoint].sent++;
+        m_interval_sent++;
+
+        step_t *step = m_step;
+        auto on_done = [this, step, endpoint, scheduled_us](const ns::response_t &resp) {
+            complete(*step, endpoint, scheduled_us, resp);
+        };
+        switch (endpoint) {
+        case kPress:
+            m_client.press(button, on_done);
+            break;
+        case kHold:
+            m_client.hold(button, kHoldMs[m_rng() % (sizeof(kHoldMs) / sizeof(kHoldMs[0]))], on_done);
+            break;
+        case kButton:
+            m_client.button(button, kLeaseMs, on_done);
+            break;
+        default:
+            m_client.health(on_done);
+            break;
+        }
+    }
+
+    void complete(step_t &step, int endpoint, int64_t scheduled_us, const ns::response_t &resp)
+    {
+        endpoint_stats_t &stats = step.endpoints[endpoint];
+
+        if (resp.error != 0) {
+            step.errnos[resp.error]++;
+        }
+        if (resp.error == ETIMEDOUT) {
+            stats.timeouts++;
+        } else if (resp.error != 0) {
+            stats.errors++;
+        } else if (!resp.ok()) {
+            stats.http_errors++;
+        } else {
+            stats.ok++;
+            stats.latency.record(resp.done_us - scheduled_us);
+            m_interval.record(resp.done_us - scheduled_us);
+            return;
+        }
+        m_interval_failed++;
+    }
+
+    void report(uint64_t &timer)
+    {
+        int64_t now = ns::now_us();
+        printf("  %6.1fs  sent %6llu  ok %6llu  failed %4llu  pending %5zu  p50 %7lld  p99 %7lld  max %7lld us\n",
+               (double)(now - m_run_start) / 1e6,
+               (unsigned long long)m_interval_sent, (unsigned long long)m_interval.count(),
+               (unsigned long long)m_interval_failed, m_client.pending(),
+               (long long)m_interval.percentile(50.0), (long long)m_interval.percentile(99.0),
+               (long long)m_interval.max());
+        fflush(stdout);
+        m_interval.reset();
+        m_interval_failed = 0;
+        m_interval_sent = 0;
+        timer = m_loop.add_timer(now + m_config.report_us, [this, &timer]() { report(timer); });
+    }
+
+    ns::loop_t &m_loop;
+    ns::client_t &m_client;
+    const config_t &m_config;
+    std::mt19937 m_rng;
+    unsigned m_weight_total = 0;
+    step_t *m_step = nullptr;
+    int64_t m_next_at = 0;
+    double m_carry_us = 0.0;
+
+    histogram_t m_interval;
+    uint64_t m_interval_sent = 0;
+    uint64_t m_interval_failed = 0;
+    int64_t m_run_start = 0;
+};
+
+//--------------------------------------------------------------------+
+// Device metrics
+//--------------------------------------------------------------------+
+using metrics_t = std::map<std::string, double>;
+
+// Prometheus text format: "name{labels} value" per line, comments skipped.
+bool fetch_metrics(ns::loop_t &loop, ns::client_t &client, metrics_t &out)
+{
+    bool done = false;
+    bool ok = false;
+
+    out.clear();
+    client.metrics([&](const ns::response_t &resp) {
+        size_t pos = 0;
+
+        ok = resp.ok();
+        while (ok && pos < resp.body.size()) {
+            size_t eol = resp.body.find('\n', pos);
+            std::string line = resp.body.substr(pos, eol == std::string::npos ? std::string::npos : eol - pos);
+            size_t space = line.rfind(' ');
+
+            pos = eol == std::string::npos ? resp.body.size() : eol + 1;
+            if (line.empty() || line[0] == '#' || space == std::string::npos) {
+                continue;
+            }
+            out[line.substr(0, space)] = strtod(line.c_str() + space + 1, nullptr);
+        }
+        done = true;
+    });
+    loop.run_until([&done]() { return done; });
+    return ok;
+}
+
+void print_metrics_diff(const metrics_t &before, const metrics_t &after)
+{
+    static const char kRequests[] = "ns_http_requests_total{";
+    static const char kHandlerUs[] = "ns_http_handler_us_sum{";
+    bool any = false;
+
+    for (const auto &entry : after) {
+        auto prev = before.find(entry.first);
+        double was = prev == before.end() ? 0.0 : prev->second;
+
+        if (entry.second == was) {
+            continue;
+        }
+        if (!any) {
+            printf("  device /metrics:\n");
+            any = true;
+        }
+        printf("    %-48s %14.0f -> %14.0f  (%+.0f)\n", entry.first.c_str(), was, entry.second,
+               entry.second - was);
+    }
+    // Handler time per call as the device measured it, to set against the latency seen here
+    for (const auto &entry : after) {
+        if (entry.first.compare(0, sizeof(kRequests) - 1, kRequests) != 0) {
+            continue;
+        }
+        std::string labels = entry.first.substr(sizeof(kRequests) - 1);
+        auto req_before = before.find(entry.first);
+        auto us_after = after.find(kHandlerUs + labels);
+        auto us_before = before.find(kHandlerUs + labels);
+        double calls = entry.second - (req_before == before.end() ? 0.0 : req_before->second);
+
+        if (calls <= 0.0 || us_after == after.end()) {
+            continue;
+        }
+        double busy = us_after->second - (us_before == before.end() ? 0.0 : us_before->second);
+        printf("    device handler %-24s %8.0f calls, mean %8.1f us\n", ("{" + labels).c_str(), calls,
+               busy / calls);
+    }
+    if (!any) {
+        printf("  device /metrics: no change\n");
+    }
+}
+
+//--------------------------------------------------------------------+
+// Report
+//--------------------------------------------------------------------+
+void print_row(const char *name, const endpoint_stats_t &stats)
+{
+    const histogram_t &h = stats.latency;
+
+    printf("  %-8s %8llu %8llu %7llu %7llu %8llu %6.2f%%  %7lld %7lld %7lld %7lld %8lld\n", name,
+           (unsigned long long)stats.sent, (unsigned long long)stats.ok,
+           (unsigned long long)stats.http_errors, (unsigned long long)stats.errors,
+           (unsigned long long)stats.timeouts,
+           stats.sent ? 100.0 * (double)stats.failed() / (double)stats.sent : 0.0,
+           (long long)h.percentile(50.0), (long long)h.percentile(90.0), (long long)h.percentile(99.0),
+           (long long)h.percentile(99.9), (long long)h.max());
+}
+
+void print_step(const step_t &step, const ns::client_t &client, const config_t &config)
+{
+    endpoint_stats_t all;
+    uint64_t issued;
+
+    for (const endpoint_stats_t &stats : step.endpoints) {
+        all.sent += stats.sent;
+        all.ok += stats.ok;
+        all.http_errors += stats.http_errors;
+        all.errors += stats.errors;
+        all.timeouts += stats.timeouts;
+        all.latency.add(stats.latency);
+    }
+    issued = all.sent + step.shed;
+    printf("  offered %.0f/s for %.1f s: sent %llu, shed %llu, ok %.1f/s, generator lag mean %.0f max %lld us\n",
+           step.rate, (double)config.duration_us / 1e6, (unsigned long long)all.sent,
+           (unsigned long long)step.shed, (double)all.ok * 1e6 / (double)config.duration_us,
+           issued ? step.lag_sum_us / (double)issued : 0.0, (long long)step.lag_max_us);
+    printf("  %-8s %8s %8s %7s %7s %8s %7s  %7s %7s %7s %7s %8s\n", "endpoint", "sent", "ok", "non-2xx",
+           "errors", "timeouts", "failed", "p50", "p90", "p99", "p99.9", "max us");
+    for (int i = 0; i < kEndpointCount; i++) {
+        if (step.endpoints[i].sent != 0) {
+            print_row(kEndpointNames[i], step.endpoints[i]);
+        }
+    }
+    print_row("all", all);
+    if (!step.errnos.empty()) {
+        printf("  transport failures:");
+        for (const auto &entry : step.errnos) {
+            printf(" %s %llu", strerror(entry.first), (unsigned long long)entry.second);
+        }
+        printf("\n");
+    }
+    printf("  client: %llu connects, %llu pipelined, %llu retries, pool limit %u\n",
+           (unsigned long long)client.stats().connects, (unsigned long long)client.stats().pipelined,
+           (unsigned long long)client.stats().retries, client.pool_limit());
+
+    if (!config.hgrm_prefix.empty()) {
+        std::string path = config.hgrm_prefix + "_" + std::to_string((long long)step.rate) + ".hgrm";
+        FILE *out = fopen(path.c_str(), "w");
+
+        if (out == nullptr) {
+            fprintf(stderr, "%s: %s\n", path.c_str(), strerror(errno));
+            return;
+        }
+        all.latency.write_hgrm(out);
+        fclose(out);
+        printf("  histogram written to %s\n", path.c_str());
+    }
+}
+
+bool parse_rates(const char *arg, std::vector<double> &rates)
+{
+    char *end;
+
+    rates.clear();
+    while (*arg != '\0') {
+        double rate = strtod(arg, &end);
+
+        if (end == arg || rate <= 0.0) {
+            return false;
+        }
+        rates.push_back(rate);
+        arg = *end == ',' ? end + 1 : end;
+        if (*end != ',' && *end != '\0') {
+            return false;
+        }
+    }
+    return !rates.empty();
+}
+
+// "press=4,hold=3,button=1,health=2"; endpoints left out get weight 0.
+bool parse_mix(const char *arg, unsigned weights[kEndpointCount])
+{
+    std::string mix(arg);
+    size_t pos = 0;
+    unsigned total = 0;
+
+    std::fill(weights, weights + kEndpointCount, 0U);
+    while (pos < mix.size()) {
+        size_t comma = mix.find(',', pos);
+        std::string item = mix.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        size_t eq = item.find('=');
+        int endpoint = -1;
+
+        pos = comma == std::string::npos ? mix.size() : comma + 1;
+        for (int i = 0; i < kEndpointCount; i++) {
+            if (item.compare(0, eq, kEndpointNames[i]) == 0) {
+                endpoint = i;
+            }
+        }
+        if (endpoint < 0) {
+            return false;
+        }
+        if (eq == std::string::npos) {
+            weights[endpoint] = 1U;
+        } else {
+            const char *value = item.c_str() + eq + 1;
+            char *end = nullptr;
+            long weight = strtol(value, &end, 10);
+
+            if (end == value || *end != '\0' || weight <= 0 || weight > 1000000) {
+                return false;
+            }
+            weights[endpoint] = (unsigned)weight;
+        }
+        total += weights[endpoint];
+    }
+    return total != 0;
+}
+
+void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [-H host] [-p http_port] [-r rates] [-t seconds] [-c conns] [-d depth] [-e mix]\n"
+            "          [-T timeout_ms] [-P] [-q max_outstanding] [-i report_ms] [-o hgrm_prefix] [-S seed]\n"
+            "          [-s service_us] [-m sockets]\n"
+            "  -H  bridge address (default: run the stand-in server on 127.0.0.1)\n"
+            "  -r  offered requests/s, comma separated for a step per rate (default 100)\n"
+            "  -t  seconds per rate step (default 10)\n"
+            "  -c  connections (default 3)\n"
+            "  -d  requests in flight per connection (default 1)\n"
+            "  -e  endpoint weights (default press=4,hold=3,button=1,health=2)\n"
+            "  -T  per-request timeout in ms (default 2000)\n"
+            "  -P  Poisson arrivals instead of a fixed interval\n"
+            "  -q  outstanding requests beyond which new ones are shed (default 4096)\n"
+            "  -i  progress line interval in ms, 0 for none (default 1000)\n"
+            "  -o  write <prefix>_<rate>.hgrm percentile files (HdrHistogram format, ms)\n"
+            "  -S  random seed for endpoints, buttons and arrivals (default 1)\n"
+            "  -s  stand-in server handler time in us (default 0)\n"
+            "  -m  stand-in server socket limit (default 7)\n",
+            argv0);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    ns::client_options_t options;
+    ns::stub_options_t stub_options;
+    config_t config;
+    std::string host;
+    int opt;
+
+    options.pipeline_depth = 1;
+    while ((opt = getopt(argc, argv, "H:p:r:t:c:d:e:T:Pq:i:o:S:s:m:h")) != -1) {
+        switch (opt) {
+        case 'H':
+            host = optarg;
+            break;
+        case 'p':
+            options.http_port = (uint16_t)atoi(optarg);
+            break;
+        case 'r':
+            if (!parse_rates(optarg, config.rates)) {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 't':
+            config.duration_us = (int64_t)(atof(optarg) * 1e6);
+            break;
+        case 'c':
+            options.max_connections = (unsigned)atoi(optarg);
+            break;
+        case 'd':
+            options.pipeline_depth = (unsigned)atoi(optarg);
+            break;
+        case 'e':
+            if (!parse_mix(optarg, config.weights)) {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 'T':
+            options.timeout_us = atoll(optarg) * 1000;
+            break;
+        case 'P':
+            config.poisson = true;
+            break;
+        case 'q':
+            config.max_outstanding = (size_t)atoll(optarg);
+            break;
+        case 'i':
+            config.report_us = atoll(optarg) * 1000;
+            break;
+        case 'o':
+            config.hgrm_prefix = optarg;
+            break;
+        case 'S':
+            config.seed = (unsigned)atoi(optarg);
+            break;
+        case 's':
+            stub_options.service_us = atoll(optarg);
+            break;
+        case 'm':
+            stub_options.max_sockets = (unsigned)atoi(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (config.duration_us <= 0 || options.max_connections == 0 || options.pipeline_depth == 0 ||
+        options.timeout_us <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Stand-in server on its own thread and loop, so its work is not counted as client time
+    ns::loop_t stub_loop;
+    std::unique_ptr<ns::stub_server_t> stub;
+    std::atomic<bool> stub_stop(false);
+    std::thread stub_thread;
+
+    if (host.empty()) {
+        stub_options.http_port = 0;
+        stub_options.udp_port = 0;
+        stub = std::make_unique<ns::stub_server_t>(stub_loop, stub_options);
+        if (!stub->start()) {
+            return 1;
+        }
+        host = "127.0.0.1";
+        options.http_port = stub->http_port();
+        stub_thread = std::thread([&stub_loop, &stub_stop]() {
+            while (!stub_stop.load()) {
+                stub_loop.run_once(10000);
+            }
+        });
+        printf("stand-in server on %s:%u, handler time %lld us, %u sockets\n", host.c_str(),
+               (unsigned)options.http_port, (long long)stub_options.service_us, stub_options.max_sockets);
+    } else {
+        printf("bridge %s:%u\n", host.c_str(), (unsigned)options.http_port);
+    }
+    printf("%u connections x %u in flight, %s arrivals, timeout %lld ms\n", options.max_connections,
+           options.pipeline_depth, config.poisson ? "Poisson" : "fixed-interval",
+           (long long)(options.timeout_us / 1000));
+
+    ns::loop_t loop;
+    ns::client_t client(loop, host, options);
+    generator_t generator(loop, client, config);
+    std::vector<step_t> steps(config.rates.size());
+    uint64_t sent[kEndpointCount] = {};
+
+    for (size_t i = 0; i < config.rates.size(); i++) {
+        metrics_t before;
+        metrics_t after;
+        bool have_before = fetch_metrics(loop, client, before);
+
+        steps[i].rate = config.rates[i];
+        printf("\nstep %zu: %.0f requests/s\n", i + 1, steps[i].rate);
+        generator.run(steps[i]);
+        print_step(steps[i], client, config);
+        if (have_before && fetch_metrics(loop, client, after)) {
+            print_metrics_diff(before, after);
+        } else {
+            printf("  device /metrics: not available\n");
+        }
+        for (int e = 0; e < kEndpointCount; e++) {
+            sent[e] += steps[i].endpoints[e].sent;
+        }
+    }
+
+    // Leave the bridge as test_http_api.py --stress does
+    bool released = false;
+    client.release([&](const ns::response_t &) {
+        client.get("/auto", [&released](const ns::response_t &) { released = true; });
+    });
+    loop.run_until([&released]() { return released; });
+
+    int status = 0;
+    if (stub) {
+        stub_stop = true;
+        stub_thread.join();
+
+        // Every request sent must have reached the server once, retries aside
+        const ns::stub_stats_t &st = stub->stats();
+        printf("\nstand-in server:");
+        for (int e = 0; e < kEndpointCount; e++) {
+            auto served = st.requests.find(kEndpointPaths[e]);
+            uint64_t count = served == st.requests.end() ? 0 : served->second;
+
+            printf(" %s %llu/%llu", kEndpointPaths[e], (unsigned long long)count,
+                   (unsigned long long)sent[e]);
+            if (count != sent[e]) {
+                status = 1;
+            }
+        }
+        printf(" served/sent, %llu sockets rejected\n", (unsigned long long)st.sockets_rejected);
+        if (status != 0) {
+            fprintf(stderr, "stand-in server count does not match the requests sent\n");
+        }
+    }
+    return status;
+}
@@ -0,0 +1,680 @@
+#include "ns_stub_server.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ns {
+
+namespace {
+
+// Limits and defaults of ns_wifi_control.c
+constexpr size_t kStateBodyMax = 512;
+constexpr long kPressDefaultMs = 100;
+constexpr long kHoldMinMs = 20;
+constexpr long kHoldMaxMs = 60000;
+constexpr long kLeaseDefaultMs = 30000;
+constexpr long kLeaseMaxMs = 3600000;
+constexpr long kAxisMax = 0x0FFF;
+constexpr int kButtonMax = 18;
+constexpr uint32_t kButtonMaskAll = ((1U << (kButtonMax + 1)) - 2U);
+constexpr size_t kProbeReqLen = 24;
+constexpr size_t kProbeReplyLen = 40;
+constexpr size_t kRequestMax = 16384;
+
+// Registration order of s_http_routes, as listed by /metrics
+const char *const kRoutes[] = {
+    "/", "/ui", "/ws", "/health", "/provision", "/button", "/press", "/hold", "/release", "/auto",
+    "/state", "/stream", "/time", "/jitter", "/metrics", "/events", "/macro", "/macro/start",
+    "/macro/stop", "/rules", "/layers", "/boot", "/wifi", "/latency", "/probe", "/uart",
+};
+
+const char kButtonError[] = "{\"ok\":false,\"error\":\"use name=<A|B|X|Y...> or id=<0..18>\"}";
+
+void put_u64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+// httpd_query_key_value() equivalent; no percent-decoding, like the firmware
+bool query_value(const std::string &query, const char *key, std::string *out)
+{
+    size_t key_len = strlen(key);
+    size_t pos = 0;
+
+    while (pos <= query.size()) {
+        size_t end = query.find('&', pos);
+        if (end == std::string::npos) {
+            end = query.size();
+        }
+        if (end - pos > key_len && query[pos + key_len] == '=' && query.compare(pos, key_len, key) == 0) {
+            *out = query.substr(pos + key_len + 1, end - pos - key_len - 1);
+            return true;
+        }
+        pos = end + 1;
+    }
+    return false;
+}
+
+bool parse_long(const std::string &text, long *out)
+{
+    char *end = nullptr;
+
+    if (text.empty()) {
+        return false;
+    }
+    *out = strtol(text.c_str(), &end, 10);
+    return *end == '\0';
+}
+
+bool parse_button(const std::string &query, int *button)
+{
+    std::string value;
+    long id;
+
+    if (query.empty() || query.size() >= 128) {
+        return false;
+    }
+    if (query_value(query, "name", &value)) {
+        *button = button_id(value);
+        return *button >= 0;
+    }
+    if (query_value(query, "id", &value) && parse_long(value, &id) && id >= 0 && id <= kButtonMax) {
+        *button = (int)id;
+        return true;
+    }
+    return false;
+}
+
+long parse_lease_ms(const std::string &query)
+{
+    std::string value;
+    long lease;
+
+    if (query_value(query, "lease_ms", &value) && parse_long(value, &lease) && lease >= 0) {
+        return lease > kLeaseMaxMs ? kLeaseMaxMs : lease;
+    }
+    return kLeaseDefaultMs;
+}
+
+long clamp_hold_ms(long ms)
+{
+    return ms < kHoldMinMs ? kHoldMinMs : (ms > kHoldMaxMs ? kHoldMaxMs : ms);
+}
+
+// Number after "key": in a flat JSON object; false if the key is absent
+bool json_number(const std::string &body, const char *key, long long *out, bool *bad)
+{
+    std::string needle = std::string("\"") + key + "\":";
+    size_t pos = body.find(needle);
+    char *end = nullptr;
+
+    if (pos == std::string::npos) {
+        return false;
+    }
+    const char *start = body.c_str() + pos + needle.size();
+    *out = strtoll(start, &end, 10);
+    if (end == start) {
+        *bad = true;
+    }
+    return true;
+}
+
+// Field checks of ns_state_parse() for the keys the stub reads; NULL when valid
+const char *parse_state(const std::string &body, state_t *state, long *hold_ms, long long *at_us)
+{
+    static const char *const axes[] = {"lx", "ly", "rx", "ry"};
+    uint16_t *const fields[] = {&state->lx, &state->ly, &state->rx, &state->ry};
+    static const char *const axis_errors[] = {
+        "lx must be 0..4095", "ly must be 0..4095", "rx must be 0..4095", "ry must be 0..4095",
+    };
+    long long value;
+    bool bad = false;
+    size_t pos;
+
+    if (body.empty() || body[0] != '{') {
+        return "body must be a JSON object";
+    }
+
+    pos = body.find("\"buttons\":");
+    if (pos != std::string::npos) {
+        pos = body.find_first_not_of(" \t\r\n", pos + 10);
+        if (pos != std::string::npos && body[pos] == '[') {
+            size_t end = body.find(']', pos);
+            if (end == std::string::npos) {
+                return "invalid buttons";
+            }
+            state->buttons = 0;
+            for (size_t q = body.find('"', pos); q < end; q = body.find('"', q + 1)) {
+                size_t close = body.find('"', q + 1);
+                int id = close < end ? button_id(body.substr(q + 1, close - q - 1)) : -1;
+                if (id < 0) {
+                    return "invalid buttons";
+                }
+                if (id > 0) {
+                    state->buttons |= 1U << id;
+                }
+                q = close;
+            }
+        } else if (!json_number(body, "buttons", &value, &bad) || bad || value < 0 ||
+                   ((uint32_t)value & ~kButtonMaskAll) != 0) {
+            return "invalid buttons";
+        } else {
+            state->buttons = (uint32_t)value;
+        }
+    }
+    for (int axis = 0; axis < 4; axis++) {
+        if (json_number(body, axes[axis], &value, &bad)) {
+            if (bad || value < 0 || value > kAxisMax) {
+                return axis_errors[axis];
+            }
+            *fields[axis] = (uint16_t)value;
+        }
+    }
+    state->imu = body.find("\"imu\":") != std::string::npos;
+    if (json_number(body, "hold_ms", &value, &bad)) {
+        if (bad || value < 0) {
+            return "invalid hold_ms";
+        }
+        *hold_ms = (long)value;
+    }
+    if (json_number(body, "at_us", &value, &bad)) {
+        if (bad || value <= 0) {
+            return "invalid at_us";
+        }
+        *at_us = value;
+    }
+    return nullptr;
+}
+
+const char *status_text(int status)
+{
+    switch (status) {
+    case 200:
+        return "OK";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 405:
+        return "Method Not Allowed";
+    case 503:
+        return "Service Unavailable";
+    default:
+        return "Error";
+    }
+}
+
+} // namespace
+
+struct stub_server_t::conn_t {
+    int fd = -1;
+    uint32_t events = 0;
+    bool ws = false;
+    bool closing = false;
+    std::string in;
+    std::string out;
+};
+
+stub_server_t::stub_server_t(loop_t &loop, const stub_options_t &options)
+    : m_loop(loop), m_options(options)
+{
+}
+
+stub_server_t::~stub_server_t()
+{
+    for (auto &conn : m_conns) {
+        m_loop.remove(conn->fd);
+        close(conn->fd);
+    }
+    if (m_listen_fd >= 0) {
+        m_loop.remove(m_listen_fd);
+        close(m_listen_fd);
+    }
+    if (m_udp_fd >= 0) {
+        m_loop.remove(m_udp_fd);
+        close(m_udp_fd);
+    }
+}
+
+bool stub_server_t::start()
+{
+    sockaddr_in addr = {};
+    socklen_t len = sizeof(addr);
+    int one = 1;
+
+    addr.sin_family = AF_INET;
+    if (inet_pton(AF_INET, m_options.bind.c_str(), &addr.sin_addr) != 1) {
+        fprintf(stderr, "ns_stub: bad bind address %s\n", m_options.bind.c_str());
+        return false;
+    }
+
+    m_listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    setsockopt(m_listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    addr.sin_port = htons(m_options.http_port);
+    if (m_listen_fd < 0 || bind(m_listen_fd, (sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(m_listen_fd, 64) != 0) {
+        fprintf(stderr, "ns_stub: http port %u: %s\n", (unsigned)m_options.http_port, strerror(errno));
+        return false;
+    }
+    getsockname(m_listen_fd, (sockaddr *)&addr, &len);
+    m_http_port = ntohs(addr.sin_port);
+
+    m_udp_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    addr.sin_port = htons(m_options.udp_port);
+    if (m_udp_fd < 0 || bind(m_udp_fd, (sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "ns_stub: udp port %u: %s\n", (unsigned)m_options.udp_port, strerror(errno));
+        return false;
+    }
+    len = sizeof(addr);
+    getsockname(m_udp_fd, (sockaddr *)&addr, &len);
+    m_udp_port = ntohs(addr.sin_port);
+
+    if (!m_loop.add(m_listen_fd, EPOLLIN, [this](uint32_t) { on_accept(); }) ||
+        !m_loop.add(m_udp_fd, EPOLLIN, [this](uint32_t) { on_udp(); })) {
+        return false;
+    }
+    m_boot_us = now_us();
+    return true;
+}
+
+void stub_server_t::on_accept()
+{
+    for (;;) {
+        int fd = accept4(m_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        int one = 1;
+
+        if (fd < 0) {
+            return;
+        }
+        // esp_http_server without lru_purge_enable: accept, then close what does not fit
+        if (m_conns.size() >= m_options.max_sockets) {
+            m_stats.sockets_rejected++;
+            close(fd);
+            continue;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        auto conn = std::make_unique<conn_t>();
+        conn_t *raw = conn.get();
+        conn->fd = fd;
+        conn->events = EPOLLIN;
+        if (!m_loop.add(fd, EPOLLIN, [this, raw](uint32_t events) { on_conn_events(raw, events); })) {
+            close(fd);
+            continue;
+        }
+        m_stats.sockets_accepted++;
+        m_conns.push_back(std::move(conn));
+    }
+}
+
+void stub_server_t::close_conn(conn_t *conn)
+{
+    m_loop.remove(conn->fd);
+    close(conn->fd);
+    for (size_t i = 0; i < m_conns.size(); i++) {
+        if (m_conns[i].get() == conn) {
+            m_conns.erase(m_conns.begin() + (long)i);
+            return;
+        }
+    }
+}
+
+void stub_server_t::on_conn_events(conn_t *conn, uint32_t events)
+{
+    char buf[4096];
+    bool eof = false;
+
+    if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        for (;;) {
+            ssize_t n = recv(conn->fd, buf, sizeof(buf), 0);
+            if (n > 0) {
+                conn->in.append(buf, (size_t)n);
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+                eof = true;
+            }
+            break;
+        }
+        if (!(conn->ws ? ws_frames(conn) : serve(conn))) {
+            close_conn(conn);
+            return;
+        }
+    }
+
+    while (!conn->out.empty()) {
+        ssize_t n = send(conn->fd, conn->out.data(), conn->out.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                break;
+            }
+            close_conn(conn);
+            return;
+        }
+        conn->out.erase(0, (size_t)n);
+    }
+    if (eof || (conn->closing && conn->out.empty())) {
+        close_conn(conn);
+        return;
+    }
+
+    uint32_t want = conn->out.empty() ? (uint32_t)EPOLLIN : (uint32_t)(EPOLLIN | EPOLLOUT);
+    if (want != conn->events) {
+        conn->events = want;
+        m_loop.modify(conn->fd, want);
+    }
+}
+
+// Serves every complete request in conn->in, in order. False drops the connection.
+bool stub_server_t::serve(conn_t *conn)
+{
+    while (!conn->closing && !conn->ws) {
+        size_t end = conn->in.find("\r\n\r\n");
+        if (end == std::string::npos) {
+            return conn->in.size() <= kRequestMax;
+        }
+
+        std::string head = conn->in.substr(0, end + 2);
+        size_t sp1 = head.find(' ');
+        size_t sp2 = sp1 == std::string::npos ? std::string::npos : head.find(' ', sp1 + 1);
+        if (sp2 == std::string::npos) {
+            return false;
+        }
+        std::string method = head.substr(0, sp1);
+        std::string target = head.substr(sp1 + 1, sp2 - sp1 - 1);
+        std::string path = target.substr(0, target.find('?'));
+        std::string query = path.size() < target.size() ? target.substr(path.size() + 1) : std::string();
+
+        size_t body_len = 0;
+        const char *cl = strcasestr(head.c_str(), "\r\nContent-Length:");
+        if (cl != nullptr) {
+            body_len = strtoul(cl + 17, nullptr, 10);
+        }
+        if (body_len > kRequestMax) {
+            return false;
+        }
+        if (conn->in.size() < end + 4 + body_len) {
+            return true;
+        }
+        std::string body = conn->in.substr(end + 4, body_len);
+        conn->in.erase(0, end + 4 + body_len);
+
+        int64_t start = now_us();
+        if (m_options.service_us > 0) {
+            while (now_us() - start < m_options.service_us) {
+            }
+        }
+        route(conn, method, path, query, head, body);
+        m_handler_us[path] += (uint64_t)(now_us() - start);
+    }
+    return conn->ws ? ws_frames(conn) : true;
+}
+
+void stub_server_t::reply(conn_t *conn, int status, const std::string &body, bool close_after)
+{
+    char head[160];
+
+    snprintf(head, sizeof(head), "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\n%s\r\n",
+             status, status_text(status), status == 404 ? "text/html" : "application/json",
+             body.size(), close_after ? "Connection: close\r\n" : "");
+    conn->out += head;
+    conn->out += body;
+    if (status == 400) {
+        m_stats.bad_requests++;
+    }
+    if (close_after) {
+        conn->closing = true;
+    }
+}
+
+void stub_server_t::reply_metrics(conn_t *conn)
+{
+    std::string text;
+    char line[160];
+
+    // Chunked, as httpd_resp_send_chunk() sends it on the device
+    text += "# TYPE ns_http_requests_total counter\n";
+    for (const char *route : kRoutes) {
+        snprintf(line, sizeof(line), "ns_http_requests_total{path=\"%s\"} %llu\n", route,
+                 (unsigned long long)m_stats.requests[route]);
+        text += line;
+    }
+    text += "# TYPE ns_http_handler_us_sum counter\n";
+    for (const char *route : kRoutes) {
+        snprintf(line, sizeof(line), "ns_http_handler_us_sum{path=\"%s\"} %llu\n", route,
+                 (unsigned long long)m_handler_us[route]);
+        text += line;
+    }
+    text += "# TYPE ns_wifi_connected gauge\nns_wifi_connected 1\n"
+            "# TYPE ns_wifi_rssi_dbm gauge\nns_wifi_rssi_dbm 0\n";
+
+    snprintf(line, sizeof(line), "%zx\r\n", text.size());
+    conn->out += "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                 "Transfer-Encoding: chunked\r\n\r\n";
+    conn->out += line;
+    conn->out += text;
+    conn->out += "\r\n0\r\n\r\n";
+}
+
+void stub_server_t::route(conn_t *conn, const std::string &method, const std::string &path,
+                          const std::string &query, const std::string &head, const std::string &body)
+{
+    char response[320];
+    int button = 0;
+    bool known = false;
+    bool get_ok = path != "/state";
+    bool post_ok = path == "/state" || path == "/macro" || path == "/rules";
+
+    for (const char *route : kRoutes) {
+        known = known || path == route;
+    }
+    // httpd_req_handle_err(): unregistered URI or method, then the socket is closed
+    if (!known) {
+        m_stats.requests["404"]++;
+        reply(conn, 404, "This URI does not exist", true);
+        return;
+    }
+    if (!(method == "GET" && get_ok) && !(method == "POST" && post_ok)) {
+        m_stats.requests["405"]++;
+        reply(conn, 405, "Request method for this URI is not handled by server", true);
+        return;
+    }
+    m_stats.requests[path]++;
+
+    if (path == "/state") {
+        state_t state;
+        long hold_ms = 0;
+        long long at_us = 0;
+        long lease_ms = parse_lease_ms(query);
+        const char *error;
+
+        if (body.empty() || body.size() >= kStateBodyMax) {
+            reply(conn, 400, "{\"ok\":false,\"error\":\"body required (max 511 bytes)\"}");
+            return;
+        }
+        error = parse_state(body, &state, &hold_ms, &at_us);
+        if (error != nullptr) {
+            snprintf(response, sizeof(response), "{\"ok\":false,\"error\":\"%s\"}", error);
+            reply(conn, 400, response);
+            return;
+        }
+        if (hold_ms > 0) {
+            hold_ms = clamp_hold_ms(hold_ms);
+            lease_ms = 0;
+        }
+        snprintf(response, sizeof(response),
+                 "{\"ok\":true,\"mode\":\"state\",\"buttons\":%u,\"lx\":%u,\"ly\":%u,"
+                 "\"rx\":%u,\"ry\":%u,\"imu\":%s,\"hold_ms\":%ld,\"at_us\":%lld,"
+                 "\"layer\":\"http0\",\"lease_ms\":%ld}",
+                 (unsigned)state.buttons, state.lx, state.ly, state.rx, state.ry,
+                 state.imu ? "true" : "false", hold_ms, at_us, lease_ms);
+        reply(conn, 200, response);
+        return;
+    }
+
+    if (path == "/health") {
+        snprintf(response, sizeof(response),
+                 "{\"ok\":true,\"service\":\"wifi-control\",\"provision_mode\":false,"
+                 "\"setup_ap\":\"OpenSwitchBridge-Setup\",\"sta_connected\":true,\"ip\":\"%s\","
+                 "\"ssid\":\"ns-stub\"}",
+                 m_options.bind.c_str());
+        reply(conn, 200, response);
+    } else if (path == "/button" || path == "/press" || path == "/hold") {
+        std::string value;
+        long ms = kPressDefaultMs;
+
+        if (!parse_button(query, &button)) {
+            reply(conn, 400, kButtonError);
+            return;
+        }
+        if (path == "/button") {
+            snprintf(response, sizeof(response),
+                     "{\"ok\":true,\"mode\":\"manual\",\"button\":\"%s\",\"id\":%d,"
+                     "\"layer\":\"http0\",\"lease_ms\":%ld}",
+                     button_name(button), button, parse_lease_ms(query));
+        } else {
+            if (path == "/hold" && query_value(query, "ms", &value) && parse_long(value, &ms)) {
+                ms = clamp_hold_ms(ms);
+            }
+            snprintf(response, sizeof(response),
+                     "{\"ok\":true,\"mode\":\"%s\",\"button\":\"%s\",\"id\":%d,\"ms\":%ld}",
+                     path.c_str() + 1, button_name(button), button, ms);
+        }
+        reply(conn, 200, response);
+    } else if (path == "/release" || path == "/auto") {
+        snprintf(response, sizeof(response), "{\"ok\":true,\"mode\":\"%s\"}", path.c_str() + 1);
+        reply(conn, 200, response);
+    } else if (path == "/time") {
+        snprintf(response, sizeof(response),
+                 "{\"ok\":true,\"device_us\":%lld,\"sync_port\":%u,\"sched\":{\"depth\":0,"
+                 "\"queued\":0,\"applied\":0,\"late\":0,\"dropped_full\":0,"
+                 "\"max_late_us\":0,\"max_fire_error_us\":0}}",
+                 (long long)device_us(), (unsigned)m_udp_port);
+        reply(conn, 200, response);
+    } else if (path == "/stream") {
+        snprintf(response, sizeof(response),
+                 "{\"ok\":true,\"port\":%u,\"active\":%s,\"received\":%llu,\"applied\":%llu,"
+                 "\"lost\":0,\"reordered\":0,\"duplicate\":0,\"malformed\":%llu,"
+                 "\"timeouts\":0,\"last_seq\":0,\"jitter_us\":0,\"sync_requests\":%llu}",
+                 (unsigned)m_udp_port, m_stats.state_packets > 0 ? "true" : "false",
+                 (unsigned long long)(m_stats.state_packets + m_stats.state_malformed),
+                 (unsigned long long)m_stats.state_packets,
+                 (unsigned long long)m_stats.state_malformed,
+                 (unsigned long long)m_stats.sync_requests);
+        reply(conn, 200, response);
+    } else if (path == "/metrics") {
+        reply_metrics(conn);
+    } else if (path == "/ws") {
+        std::string key;
+        const char *field = strcasestr(head.c_str(), "\r\nSec-WebSocket-Key:");
+
+        if (field == nullptr) {
+            reply(conn, 400, "{\"ok\":false,\"error\":\"websocket upgrade required\"}", true);
+            return;
+        }
+        field += 20;
+        while (*field == ' ') {
+            field++;
+        }
+        key.assign(field, strcspn(field, "\r"));
+        conn->out += "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                     "Sec-WebSocket-Accept: " + ws_accept_key(key) + "\r\n\r\n";
+        conn->ws = true;
+    } else if (path == "/layers") {
+        reply(conn, 200, "{\"ok\":true,\"policy\":\"priority\",\"layers\":[{\"name\":\"http0\","
+                         "\"active\":false,\"priority\":0,\"buttons\":0,\"sticks\":false,"
+                         "\"source\":false,\"lease_left_ms\":0,\"expired\":0,\"owner\":\"\"}]}");
+    } else {
+        // Routes the stub does not model answer like an idle device
+        reply(conn, 200, "{\"ok\":true}");
+    }
+}
+
+// Masked client frames; binary ones carry one state packet each, close ends the session
+bool stub_server_t::ws_frames(conn_t *conn)
+{
+    while (conn->in.size() >= 2) {
+        const uint8_t *p = (const uint8_t *)conn->in.data();
+        uint8_t opcode = p[0] & 0x0F;
+        size_t len = p[1] & 0x7F;
+        size_t head = 2;
+        uint8_t payload[125];
+
+        if (!(p[1] & 0x80) || len > 125) {
+            return false;
+        }
+        head += 4;
+        if (conn->in.size() < head + len) {
+            break;
+        }
+        for (size_t i = 0; i < len; i++) {
+            payload[i] = p[head + i] ^ p[2 + (i & 3)];
+        }
+        conn->in.erase(0, head + len);
+
+        if (opcode == 0x8) {
+            conn->out += std::string("\x88\x00", 2);
+            conn->closing = true;
+            return true;
+        }
+        if (opcode == 0x2) {
+            state_packet(payload, len);
+        }
+    }
+    return true;
+}
+
+void stub_server_t::state_packet(const uint8_t *pkt, size_t len)
+{
+    if (len != kStatePacketLen || pkt[0] != 'N' || pkt[1] != 'S' || pkt[2] != kStreamVersion) {
+        m_stats.state_malformed++;
+        return;
+    }
+    m_stats.state_packets++;
+}
+
+void stub_server_t::on_udp()
+{
+    uint8_t pkt[64];
+    uint8_t reply[kProbeReplyLen];
+    sockaddr_in src;
+
+    for (;;) {
+        socklen_t src_len = sizeof(src);
+        ssize_t len = recvfrom(m_udp_fd, pkt, sizeof(pkt), 0, (sockaddr *)&src, &src_len);
+        int64_t now = device_us();
+
+        if (len < 0) {
+            return;
+        }
+        if (len == (ssize_t)kSyncReqLen && pkt[0] == 'N' && pkt[1] == 'T' && pkt[2] == kStreamVersion) {
+            memcpy(reply, pkt, kSyncReqLen);
+            put_u64(&reply[16], (uint64_t)now);
+            put_u64(&reply[24], (uint64_t)device_us());
+            sendto(m_udp_fd, reply, kSyncReplyLen, 0, (sockaddr *)&src, src_len);
+            m_stats.sync_requests++;
+        } else if (len == (ssize_t)kProbeReqLen && pkt[0] == 'N' && pkt[1] == 'P' &&
+                   pkt[2] == kStreamVersion) {
+            memcpy(reply, pkt, kProbeReqLen);
+            put_u64(&reply[24], (uint64_t)now);
+            put_u64(&reply[32], (uint64_t)device_us());
+            sendto(m_udp_fd, reply, kProbeReplyLen, 0, (sockaddr *)&src, src_len);
+            m_stats.probe_requests++;
+        } else if (len > 0) {
+            state_packet(pkt, (size_t)len);
+        }
+    }
+}
+
+} // namespace ns
@@ -0,0 +1,88 @@
+/*
+ * Stand-in for the bridge's control plane, so clients can be exercised
+ * without hardware: the HTTP routes of ns_wifi_control.c with the same JSON
+ * replies, the /ws binary state socket, and the UDP port with "NS" state
+ * packets, "NT" clock sync and "NP" probes (ns_udp_stream.c).
+ *
+ * Inputs are validated and counted but not applied. Like esp_http_server the
+ * stub serves requests one at a time and closes sockets beyond max_sockets;
+ * service_us adds a fixed handler time per request.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ns_client.h"
+
+namespace ns {
+
+struct stub_options_t {
+    std::string bind = "127.0.0.1";
+    uint16_t http_port = 8080;      // 0 picks a free port, see stub_server_t::http_port()
+    uint16_t udp_port = kStreamPort;
+    // HTTPD_DEFAULT_CONFIG().max_open_sockets
+    unsigned max_sockets = 7;
+    // Busy time per HTTP request, spent on the serving thread like the httpd task
+    int64_t service_us = 0;
+};
+
+struct stub_stats_t {
+    std::map<std::string, uint64_t> requests;   // per route, "404" for the rest
+    uint64_t bad_requests = 0;                  // 400 replies
+    uint64_t sockets_accepted = 0;
+    uint64_t sockets_rejected = 0;              // over max_sockets
+    uint64_t state_packets = 0;                 // valid "NS" packets, UDP and /ws
+    uint64_t state_malformed = 0;
+    uint64_t sync_requests = 0;
+    uint64_t probe_requests = 0;
+};
+
+class stub_server_t {
+public:
+    stub_server_t(loop_t &loop, const stub_options_t &options);
+    ~stub_server_t();
+    stub_server_t(const stub_server_t &) = delete;
+    stub_server_t &operator=(const stub_server_t &) = delete;
+
+    bool start();
+    uint16_t http_port() const { return m_http_port; }
+    uint16_t udp_port() const { return m_udp_port; }
+    // The stub's esp_timer_get_time(): microseconds since start(), so device = client + offset
+    // with offset = -boot_us() for clients on this host.
+    int64_t device_us() const { return now_us() - m_boot_us; }
+    int64_t boot_us() const { return m_boot_us; }
+    const stub_stats_t &stats() const { return m_stats; }
+
+private:
+    struct conn_t;
+
+    void on_accept();
+    void on_conn_events(conn_t *conn, uint32_t events);
+    void close_conn(conn_t *conn);
+    bool serve(conn_t *conn);
+    bool ws_frames(conn_t *conn);
+    void on_udp();
+    void route(conn_t *conn, const std::string &method, const std::string &path,
+               const std::string &query, const std::string &head, const std::string &body);
+    void reply(conn_t *conn, int status, const std::string &body, bool close_after = false);
+    void reply_metrics(conn_t *conn);
+    void state_packet(const uint8_t *pkt, size_t len);
+
+    loop_t &m_loop;
+    stub_options_t m_options;
+    stub_stats_t m_stats;
+    std::map<std::string, uint64_t> m_handler_us;
+    int m_listen_fd = -1;
+    int m_udp_fd = -1;
+    uint16_t m_http_port = 0;
+    uint16_t m_udp_port = 0;
+    int64_t m_boot_us = 0;
+    std::vector<std::unique_ptr<conn_t>> m_conns;
+};
+
+} // namespace ns
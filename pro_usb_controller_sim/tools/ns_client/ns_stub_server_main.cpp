@@ -0,0 +1,96 @@
+/*
+ * Stand-alone stand-in for the bridge's HTTP control API and UDP port, see
+ * ns_stub_server.h. Point test_http_api.py or any client at it:
+ *
+ *   ./_build/ns_stub_server [-b 127.0.0.1] [-p 8080] [-u 5005] [-m 7] [-s service_us]
+ *   python3 ../../test_http_api.py --host 127.0.0.1 --port 8080
+ *
+ * SIGINT/SIGTERM print the request counts and exit.
+ */
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+#include "ns_stub_server.h"
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [-b addr] [-p http_port] [-u udp_port] [-m max_sockets] [-s service_us]\n"
+            "  -b  bind address (default 127.0.0.1)\n"
+            "  -p  HTTP port (default 8080, 0 = any)\n"
+            "  -u  UDP stream/sync port (default 5005, 0 = any)\n"
+            "  -m  open sockets before new ones are closed (default 7, as esp_http_server)\n"
+            "  -s  busy time per HTTP request in us (default 0)\n",
+            argv0);
+}
+
+int main(int argc, char **argv)
+{
+    ns::stub_options_t options;
+    ns::loop_t loop;
+    sigset_t mask;
+    bool stop = false;
+    int signal_fd;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:p:u:m:s:h")) != -1) {
+        switch (opt) {
+        case 'b':
+            options.bind = optarg;
+            break;
+        case 'p':
+            options.http_port = (uint16_t)atoi(optarg);
+            break;
+        case 'u':
+            options.udp_port = (uint16_t)atoi(optarg);
+            break;
+        case 'm':
+            options.max_sockets = (unsigned)atoi(optarg);
+            break;
+        case 's':
+            options.service_us = atoll(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    sigprocmask(SIG_BLOCK, &mask, nullptr);
+    signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    ns::stub_server_t server(loop, options);
+    if (signal_fd < 0 || !server.start() ||
+        !loop.add(signal_fd, EPOLLIN, [&stop](uint32_t) { stop = true; })) {
+        return 1;
+    }
+    printf("ns_stub: http %s:%u udp %u, max %u sockets, service %lld us\n", options.bind.c_str(),
+           (unsigned)server.http_port(), (unsigned)server.udp_port(), options.max_sockets,
+           (long long)options.service_us);
+    fflush(stdout);
+
+    loop.run_until([&stop]() { return stop; });
+
+    const ns::stub_stats_t &st = server.stats();
+    for (const auto &route : st.requests) {
+        if (route.second == 0) {
+            continue;
+        }
+        printf("  %-14s %llu\n", route.first.c_str(), (unsigned long long)route.second);
+    }
+    printf("sockets %llu accepted %llu rejected, %llu bad requests\n",
+           (unsigned long long)st.sockets_accepted, (unsigned long long)st.sockets_rejected,
+           (unsigned long long)st.bad_requests);
+    printf("state packets %llu (+%llu malformed), sync %llu, probe %llu\n",
+           (unsigned long long)st.state_packets, (unsigned long long)st.state_malformed,
+           (unsigned long long)st.sync_requests, (unsigned long long)st.probe_requests);
+    close(signal_fd);
+    return 0;
+}
@@ -0,0 +1,673 @@
+/*
+ * Host-side Switch emulator for the bridge's USB side: replays the console's
+ * handshake over hidraw, cycles report modes and analyses what comes back.
+ *
+ *   c++ -O2 -std=c++17 -I../main -o ns_hidraw_probe ns_hidraw_probe.cpp
+ *   sudo ./ns_hidraw_probe [-d /dev/hidrawN] [-k] [-t secs] [-M 30,3f,30] [-o trace.csv]
+ *
+ * Works with the ESP32-S3 bridge or the Linux gadget build on dummy_hcd. With
+ * -k, reports and output transfers are timestamped by the kernel via usbmon
+ * (modprobe usbmon) instead of at read()/write() time.
+ *
+ * Reported: handshake and subcommand reply latency per ID, dropped replies,
+ * inter-report interval distribution per report mode and 0x30/0x21 timer
+ * byte continuity. Exits non-zero if any reply was dropped.
+ */
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ns_proto.h"
+
+//--------------------------------------------------------------------+
+// usbmon binary interface (Documentation/usb/usbmon.rst, no uapi header)
+//--------------------------------------------------------------------+
+struct usbmon_packet {
+    uint64_t id;
+    unsigned char type;         // 'S'ubmit, 'C'omplete, 'E'rror
+    unsigned char xfer_type;    // 0 iso, 1 interrupt, 2 control, 3 bulk
+    unsigned char epnum;        // with the direction bit
+    unsigned char devnum;
+    uint16_t busnum;
+    char flag_setup;
+    char flag_data;             // 0 when data follows
+    int64_t ts_sec;
+    int32_t ts_usec;
+    int32_t status;
+    uint32_t length;
+    uint32_t len_cap;
+    unsigned char setup[8];
+    int32_t interval;
+    int32_t start_frame;
+    uint32_t xfer_flags;
+    uint32_t ndesc;
+};
+
+struct mon_bin_get {
+    usbmon_packet *hdr;
+    void *data;
+    size_t alloc;
+};
+
+#define MON_IOC_MAGIC 0x92
+#define MON_IOCX_GETX _IOW(MON_IOC_MAGIC, 10, struct mon_bin_get)
+
+#define USBMON_XFER_INTERRUPT 1
+
+//--------------------------------------------------------------------+
+// Capture
+//--------------------------------------------------------------------+
+namespace {
+
+constexpr size_t kReportMax = 64;
+
+struct record_t {
+    int64_t ts_ns;
+    bool in;
+    uint8_t len;
+    uint8_t data[kReportMax];
+};
+
+// Key of an outstanding request: reply report ID (0x81 or 0x21) << 8 | command or subcommand ID
+using reply_key_t = uint16_t;
+
+struct latency_t {
+    std::vector<int64_t> samples_ns;
+    uint32_t dropped = 0;
+};
+
+struct probe_t {
+    int hid_fd = -1;
+    int mon_fd = -1;
+    int busnum = -1;
+    int devnum = -1;
+    int64_t reply_timeout_ns = 500LL * 1000 * 1000;
+    uint8_t packet_counter = 0;
+
+    std::vector<record_t> trace;
+    std::map<reply_key_t, int64_t> pending;
+    std::map<reply_key_t, latency_t> latency;
+    uint32_t unsolicited = 0;
+};
+
+probe_t g;
+
+int64_t now_ns()
+{
+    timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+reply_key_t make_key(uint8_t reply_id, uint8_t cmd)
+{
+    return (reply_key_t)((reply_id << 8) | cmd);
+}
+
+const char *key_kind(reply_key_t key)
+{
+    return (key >> 8) == NS_REPORT_ID_USB_REPLY ? "usb cmd" : "subcmd";
+}
+
+// Host -> device. With usbmon these come from the 'S' events, otherwise from write().
+void on_out(int64_t ts_ns, const uint8_t *data, size_t len)
+{
+    record_t rec = {ts_ns, false, (uint8_t)std::min(len, kReportMax), {0}};
+
+    memcpy(rec.data, data, rec.len);
+    g.trace.push_back(rec);
+
+    if (len >= 2 && data[0] == NS_REPORT_ID_OUTPUT_USB_CMD && data[1] != NS_USB_CMD_NO_TIMEOUT &&
+        data[1] != NS_USB_CMD_ENABLE_TIMEOUT) {
+        g.pending.emplace(make_key(NS_REPORT_ID_USB_REPLY, data[1]), ts_ns);
+    } else if (len >= 11 && data[0] == NS_REPORT_ID_OUTPUT_SUBCMD) {
+        g.pending.emplace(make_key(NS_REPORT_ID_SUBCMD_REPLY, data[10]), ts_ns);
+    }
+}
+
+// Device -> host, report ID first as hidraw returns it.
+void on_in(int64_t ts_ns, const uint8_t *data, size_t len)
+{
+    record_t rec = {ts_ns, true, (uint8_t)std::min(len, kReportMax), {0}};
+    reply_key_t key;
+
+    if (len == 0) {
+        return;
+    }
+    memcpy(rec.data, data, rec.len);
+    g.trace.push_back(rec);
+
+    if (data[0] == NS_REPORT_ID_USB_REPLY && len >= 2) {
+        key = make_key(NS_REPORT_ID_USB_REPLY, data[1]);
+    } else if (data[0] == NS_REPORT_ID_SUBCMD_REPLY && len >= 15) {
+        key = make_key(NS_REPORT_ID_SUBCMD_REPLY, data[14]);
+    } else {
+        return;
+    }
+    auto it = g.pending.find(key);
+    if (it == g.pending.end()) {
+        g.unsolicited++;
+        return;
+    }
+    g.latency[key].samples_ns.push_back(ts_ns - it->second);
+    g.pending.erase(it);
+}
+
+void drain_hidraw()
+{
+    uint8_t buf[kReportMax];
+    ssize_t n;
+
+    while ((n = read(g.hid_fd, buf, sizeof(buf))) > 0) {
+        if (g.mon_fd < 0) {
+            on_in(now_ns(), buf, (size_t)n);
+        }
+    }
+}
+
+void drain_usbmon()
+{
+    usbmon_packet hdr;
+    uint8_t data[kReportMax];
+    mon_bin_get get = {&hdr, data, sizeof(data)};
+
+    while (ioctl(g.mon_fd, MON_IOCX_GETX, &get) == 0) {
+        int64_t ts_ns = hdr.ts_sec * 1000000000LL + (int64_t)hdr.ts_usec * 1000;
+        size_t len = std::min<size_t>(hdr.len_cap, sizeof(data));
+
+        if (hdr.busnum != g.busnum || hdr.devnum != g.devnum || hdr.xfer_type != USBMON_XFER_INTERRUPT ||
+            hdr.flag_data != 0) {
+            continue;
+        }
+        if ((hdr.epnum & 0x80) && hdr.type == 'C' && hdr.status == 0) {
+            on_in(ts_ns, data, len);
+        } else if (!(hdr.epnum & 0x80) && hdr.type == 'S') {
+            on_out(ts_ns, data, len);
+        }
+    }
+}
+
+// Runs the capture until pred() holds or the deadline passes; returns pred().
+bool pump_until(int64_t deadline_ns, const std::function<bool()> &pred)
+{
+    while (!pred()) {
+        int64_t left_ms = (deadline_ns - now_ns()) / 1000000;
+        pollfd fds[2] = {{g.hid_fd, POLLIN, 0}, {g.mon_fd, POLLIN, 0}};
+
+        if (left_ms < 0) {
+            return pred();
+        }
+        if (poll(fds, g.mon_fd >= 0 ? 2 : 1, (int)std::min<int64_t>(left_ms + 1, INT_MAX)) < 0 && errno != EINTR) {
+            perror("poll");
+            exit(1);
+        }
+        drain_hidraw();
+        if (g.mon_fd >= 0) {
+            drain_usbmon();
+        }
+    }
+    return true;
+}
+
+void send_report(const uint8_t *data, size_t len)
+{
+    int64_t ts = now_ns();
+
+    if (write(g.hid_fd, data, len) != (ssize_t)len) {
+        fprintf(stderr, "hidraw write 0x%02x: %s\n", data[0], strerror(errno));
+        return;
+    }
+    if (g.mon_fd < 0) {
+        on_out(ts, data, len);
+    }
+}
+
+// Sends a request and waits for its reply; a reply that does not arrive in time counts as dropped.
+bool request(const uint8_t *report, size_t len, reply_key_t key)
+{
+    size_t before = g.latency[key].samples_ns.size();
+
+    send_report(report, len);
+    if (pump_until(now_ns() + g.reply_timeout_ns, [key, before] { return g.latency[key].samples_ns.size() > before; })) {
+        return true;
+    }
+    g.pending.erase(key);
+    g.latency[key].dropped++;
+    fprintf(stderr, "no reply to %s 0x%02x\n", key_kind(key), key & 0xFF);
+    return false;
+}
+
+bool usb_cmd(uint8_t cmd, bool expect_reply)
+{
+    uint8_t report[2] = {NS_REPORT_ID_OUTPUT_USB_CMD, cmd};
+
+    if (!expect_reply) {
+        send_report(report, sizeof(report));
+        return true;
+    }
+    return request(report, sizeof(report), make_key(NS_REPORT_ID_USB_REPLY, cmd));
+}
+
+bool subcmd(uint8_t id, std::initializer_list<uint8_t> args)
+{
+    // Output report 0x01: packet counter, neutral rumble for both sides, subcommand, arguments.
+    uint8_t report[49] = {NS_REPORT_ID_OUTPUT_SUBCMD, 0, 0x00, 0x01, 0x40, 0x40, 0x00, 0x01, 0x40, 0x40, id};
+    size_t pos = 11;
+
+    report[1] = g.packet_counter++ & 0x0F;
+    for (uint8_t a : args) {
+        report[pos++] = a;
+    }
+    return request(report, sizeof(report), make_key(NS_REPORT_ID_SUBCMD_REPLY, id));
+}
+
+bool spi_read(uint16_t addr, uint8_t len)
+{
+    return subcmd(NS_SUBCMD_SPI_FLASH_READ, {(uint8_t)addr, (uint8_t)(addr >> 8), 0, 0, len});
+}
+
+// Order and arguments as the console sends them to a wired Pro Controller.
+void handshake()
+{
+    usb_cmd(NS_USB_CMD_CONN_STATUS, true);
+    usb_cmd(NS_USB_CMD_HANDSHAKE, true);
+    usb_cmd(NS_USB_CMD_BAUDRATE_3M, true);
+    usb_cmd(NS_USB_CMD_HANDSHAKE, true);
+    usb_cmd(NS_USB_CMD_NO_TIMEOUT, false);
+
+    subcmd(NS_SUBCMD_REQ_DEV_INFO, {});
+    subcmd(0x08, {0x00});                       // shipment low power state off
+    spi_read(0x6000, 0x10);                     // serial number
+    spi_read(0x6050, 0x0D);                     // body and button colors
+    subcmd(NS_SUBCMD_SET_REPORT_MODE, {NS_REPORT_ID_STD});
+    subcmd(0x04, {});                           // trigger buttons elapsed time
+    spi_read(0x6080, 0x18);                     // factory sensor and stick parameters
+    spi_read(0x6098, 0x12);
+    spi_read(0x8010, 0x18);                     // user stick calibration
+    spi_read(NS_CAL_ADDR_START, 0x19);          // factory stick calibration
+    spi_read(0x6020, 0x18);                     // factory IMU calibration
+    subcmd(NS_SUBCMD_ENABLE_IMU, {0x01});
+    subcmd(NS_SUBCMD_ENABLE_VIBRATION, {0x01});
+    subcmd(NS_SUBCMD_SET_PLAYER_LIGHTS, {0x01});
+    subcmd(0x38, {0x01, 0x00, 0x00, 0x11, 0x11}); // home light
+}
+
+//--------------------------------------------------------------------+
+// Analysis
+//--------------------------------------------------------------------+
+struct phase_t {
+    uint8_t mode;
+    size_t first;   // trace index range captured while this mode was active
+    size_t last;
+};
+
+int64_t percentile(std::vector<int64_t> sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t idx = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+    return sorted[std::min(sorted.size() - 1, idx > 0 ? idx - 1 : 0)];
+}
+
+void print_latency()
+{
+    printf("\nreply latency (us)        n     p50     p99     max  dropped\n");
+    for (auto &entry : g.latency) {
+        std::vector<int64_t> s = entry.second.samples_ns;
+
+        std::sort(s.begin(), s.end());
+        printf("  %-7s 0x%02x   %6zu  %6lld  %6lld  %6lld  %7u\n", key_kind(entry.first), entry.first & 0xFF, s.size(),
+               (long long)percentile(s, 50) / 1000, (long long)percentile(s, 99) / 1000,
+               (long long)(s.empty() ? 0 : s.back()) / 1000, entry.second.dropped);
+    }
+    if (g.unsolicited) {
+        printf("  unsolicited replies: %u\n", g.unsolicited);
+    }
+}
+
+void print_phase(const phase_t &ph)
+{
+    uint8_t stream_id = ph.mode == 0x3F ? 0x3F : NS_REPORT_ID_STD;
+    std::vector<int64_t> intervals;
+    int64_t prev_ts = -1;
+    int prev_timer = -1;
+    uint32_t timer_reports = 0, gaps = 0, missing = 0, repeats = 0;
+
+    for (size_t i = ph.first; i < ph.last; i++) {
+        const record_t &r = g.trace[i];
+
+        if (!r.in) {
+            continue;
+        }
+        if (r.data[0] == stream_id) {
+            if (prev_ts >= 0) {
+                intervals.push_back(r.ts_ns - prev_ts);
+            }
+            prev_ts = r.ts_ns;
+        }
+        // 0x30 and 0x21 share the device's report timer, which advances by one per report built.
+        if ((r.data[0] == NS_REPORT_ID_STD || r.data[0] == NS_REPORT_ID_SUBCMD_REPLY) && r.len >= 2) {
+            if (prev_timer >= 0) {
+                uint8_t delta = (uint8_t)(r.data[1] - prev_timer);
+
+                if (delta == 0) {
+                    repeats++;
+                } else if (delta > 1) {
+                    gaps++;
+                    missing += delta - 1U;
+                }
+            }
+            prev_timer = r.data[1];
+            timer_reports++;
+        }
+    }
+
+    printf("\nmode 0x%02x: %zu x 0x%02x reports\n", ph.mode, intervals.size() + (prev_ts >= 0), stream_id);
+    if (!intervals.empty()) {
+        std::vector<int64_t> s = intervals;
+        double sum = 0, sq = 0;
+
+        std::sort(s.begin(), s.end());
+        for (int64_t v : s) {
+            sum += (double)v;
+        }
+        double mean = sum / (double)s.size();
+        for (int64_t v : s) {
+            sq += ((double)v - mean) * ((double)v - mean);
+        }
+        printf("  interval us: mean %.0f sd %.0f min %lld p50 %lld p90 %lld p99 %lld p99.9 %lld max %lld (%.1f Hz)\n",
+               mean / 1e3, std::sqrt(sq / (double)s.size()) / 1e3, (long long)s.front() / 1000,
+               (long long)percentile(s, 50) / 1000, (long long)percentile(s, 90) / 1000,
+               (long long)percentile(s, 99) / 1000, (long long)percentile(s, 99.9) / 1000,
+               (long long)s.back() / 1000, 1e9 / mean);
+
+        // 1 ms bins, the last one open-ended.
+        std::map<int64_t, uint32_t> bins;
+        uint32_t peak = 0;
+        for (int64_t v : s) {
+            peak = std::max(peak, ++bins[std::min<int64_t>(v / 1000000, 40)]);
+        }
+        for (auto &bin : bins) {
+            int bar = (int)(50.0 * bin.second / peak + 0.5);
+            char label[8];
+
+            snprintf(label, sizeof(label), bin.first == 40 ? "%lld+" : "%lld", (long long)bin.first);
+            printf("  %4s ms |%-50.*s %u\n", label, bar, "##################################################",
+                   bin.second);
+        }
+    }
+    if (timer_reports) {
+        printf("  timer byte: %u reports, %u gaps (%u values skipped), %u repeats\n", timer_reports, gaps, missing,
+               repeats);
+    }
+}
+
+void write_csv(const char *path)
+{
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL) {
+        perror(path);
+        return;
+    }
+    fprintf(f, "ts_ns,dir,report_id,timer,len\n");
+    for (const record_t &r : g.trace) {
+        bool timed = r.in && r.len >= 2 && (r.data[0] == NS_REPORT_ID_STD || r.data[0] == NS_REPORT_ID_SUBCMD_REPLY);
+
+        fprintf(f, "%lld,%s,0x%02x,%d,%u\n", (long long)r.ts_ns, r.in ? "in" : "out", r.data[0],
+                timed ? r.data[1] : -1, r.len);
+    }
+    fclose(f);
+}
+
+//--------------------------------------------------------------------+
+// Device lookup
+//--------------------------------------------------------------------+
+std::string read_line(const std::string &path)
+{
+    char buf[256] = {0};
+    FILE *f = fopen(path.c_str(), "r");
+
+    if (f == NULL) {
+        return "";
+    }
+    if (fgets(buf, sizeof(buf), f) == NULL) {
+        buf[0] = '\0';
+    }
+    fclose(f);
+    buf[strcspn(buf, "\n")] = '\0';
+    return buf;
+}
+
+std::string find_hidraw()
+{
+    char want[64];
+    DIR *dir = opendir("/sys/class/hidraw");
+    std::string found;
+
+    snprintf(want, sizeof(want), "HID_ID=0003:%08X:%08X", NS_VENDOR_ID, NS_PRODUCT_ID);
+    if (dir == NULL) {
+        return found;
+    }
+    while (dirent *e = readdir(dir)) {
+        std::string uevent = std::string("/sys/class/hidraw/") + e->d_name + "/device/uevent";
+        FILE *f = fopen(uevent.c_str(), "r");
+        char line[256];
+
+        if (e->d_name[0] == '.' || f == NULL) {
+            if (f) {
+                fclose(f);
+            }
+            continue;
+        }
+        while (fgets(line, sizeof(line), f)) {
+            if (strncasecmp(line, want, strlen(want)) == 0) {
+                found = std::string("/dev/") + e->d_name;
+            }
+        }
+        fclose(f);
+        if (!found.empty()) {
+            break;
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+// hidrawN -> HID device -> USB interface -> USB device, which has busnum/devnum.
+bool usb_address(const std::string &hidraw, int *busnum, int *devnum)
+{
+    std::string node = hidraw.substr(hidraw.rfind('/') + 1);
+    char real[PATH_MAX];
+    std::string sys = "/sys/class/hidraw/" + node + "/device";
+
+    if (realpath(sys.c_str(), real) == NULL) {
+        return false;
+    }
+    std::string usb = real;
+    for (int up = 0; up < 2; up++) {
+        usb = usb.substr(0, usb.rfind('/'));
+    }
+    std::string bus = read_line(usb + "/busnum");
+    std::string dev = read_line(usb + "/devnum");
+    if (bus.empty() || dev.empty()) {
+        return false;
+    }
+    *busnum = atoi(bus.c_str());
+    *devnum = atoi(dev.c_str());
+    return true;
+}
+
+void warn_kernel_driver(const std::string &hidraw)
+{
+    std::string node = hidraw.substr(hidraw.rfind('/') + 1);
+    char link[PATH_MAX];
+    std::string drv = "/sys/class/hidraw/" + node + "/device/driver";
+    ssize_t n = readlink(drv.c_str(), link, sizeof(link) - 1);
+
+    if (n > 0) {
+        link[n] = '\0';
+        if (strstr(link, "nintendo") != NULL) {
+            fprintf(stderr, "warning: hid-nintendo is bound and talks to the controller too; "
+                            "unbind it (or rmmod hid_nintendo) for clean figures\n");
+        }
+    }
+}
+
+void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s [-d /dev/hidrawN] [-k] [-t secs] [-M modes] [-i ms] [-w ms] [-o trace.csv]\n"
+            "  -d  hidraw node (default: first %04x:%04x)\n"
+            "  -k  kernel timestamps from /dev/usbmon<bus>\n"
+            "  -t  capture seconds per report mode (default 5)\n"
+            "  -M  report modes to cycle through, hex (default 30,3f,30)\n"
+            "  -i  subcommand interval during capture in ms, 0 = none (default 100)\n"
+            "  -w  reply timeout in ms (default 500)\n"
+            "  -o  write every report to a CSV file\n",
+            argv0, NS_VENDOR_ID, NS_PRODUCT_ID);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string dev;
+    std::vector<uint8_t> modes = {NS_REPORT_ID_STD, 0x3F, NS_REPORT_ID_STD};
+    const char *csv = NULL;
+    bool kernel_ts = false;
+    int capture_s = 5;
+    int interval_ms = 100;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:kt:M:i:w:o:h")) != -1) {
+        switch (opt) {
+        case 'd':
+            dev = optarg;
+            break;
+        case 'k':
+            kernel_ts = true;
+            break;
+        case 't':
+            capture_s = atoi(optarg);
+            break;
+        case 'M': {
+            modes.clear();
+            for (char *tok = strtok(optarg, ","); tok; tok = strtok(NULL, ",")) {
+                modes.push_back((uint8_t)strtoul(tok, NULL, 16));
+            }
+            break;
+        }
+        case 'i':
+            interval_ms = atoi(optarg);
+            break;
+        case 'w':
+            g.reply_timeout_ns = atoll(optarg) * 1000000LL;
+            break;
+        case 'o':
+            csv = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (dev.empty()) {
+        dev = find_hidraw();
+    }
+    if (dev.empty()) {
+        fprintf(stderr, "no %04x:%04x hidraw device\n", NS_VENDOR_ID, NS_PRODUCT_ID);
+        return 1;
+    }
+    warn_kernel_driver(dev);
+    g.hid_fd = open(dev.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (g.hid_fd < 0) {
+        fprintf(stderr, "open %s: %s\n", dev.c_str(), strerror(errno));
+        return 1;
+    }
+    if (kernel_ts) {
+        char mon[64];
+
+        if (!usb_address(dev, &g.busnum, &g.devnum)) {
+            fprintf(stderr, "cannot resolve the USB address of %s\n", dev.c_str());
+            return 1;
+        }
+        snprintf(mon, sizeof(mon), "/dev/usbmon%d", g.busnum);
+        g.mon_fd = open(mon, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (g.mon_fd < 0) {
+            fprintf(stderr, "open %s: %s (modprobe usbmon)\n", mon, strerror(errno));
+            return 1;
+        }
+    }
+    printf("%s, timestamps: %s\n", dev.c_str(), kernel_ts ? "kernel (usbmon)" : "user space");
+
+    // Whatever the device queued before we started is not ours.
+    pump_until(now_ns() + 50 * 1000000LL, [] { return false; });
+    g.trace.clear();
+    g.pending.clear();
+
+    int64_t t0 = now_ns();
+    handshake();
+    printf("handshake: %.1f ms\n", (double)(now_ns() - t0) / 1e6);
+
+    // Subcommands sent while reports stream, as the console does when it changes lights or rumble.
+    static const uint8_t kStreamingSubcmds[] = {NS_SUBCMD_SET_PLAYER_LIGHTS, NS_SUBCMD_ENABLE_VIBRATION,
+                                                NS_SUBCMD_REQ_DEV_INFO, NS_SUBCMD_ENABLE_IMU};
+    std::vector<phase_t> phases;
+    size_t next_subcmd = 0;
+
+    for (uint8_t mode : modes) {
+        subcmd(NS_SUBCMD_SET_REPORT_MODE, {mode});
+        phase_t ph = {mode, g.trace.size(), 0};
+        int64_t end = now_ns() + (int64_t)capture_s * 1000000000LL;
+
+        while (now_ns() < end) {
+            int64_t slice = interval_ms > 0 ? std::min<int64_t>(end, now_ns() + interval_ms * 1000000LL) : end;
+
+            pump_until(slice, [] { return false; });
+            if (interval_ms > 0 && now_ns() < end) {
+                uint8_t id = kStreamingSubcmds[next_subcmd++ % sizeof(kStreamingSubcmds)];
+                subcmd(id, {id == NS_SUBCMD_SET_PLAYER_LIGHTS ? (uint8_t)(1 << (next_subcmd % 4)) : (uint8_t)1});
+            }
+        }
+        ph.last = g.trace.size();
+        phases.push_back(ph);
+    }
+
+    print_latency();
+    for (const phase_t &ph : phases) {
+        print_phase(ph);
+    }
+    if (csv) {
+        write_csv(csv);
+    }
+
+    uint32_t dropped = 0;
+    for (auto &entry : g.latency) {
+        dropped += entry.second.dropped;
+    }
+    close(g.hid_fd);
+    if (g.mon_fd >= 0) {
+        close(g.mon_fd);
+    }
+    return dropped ? 1 : 0;
+}